@@ -0,0 +1,79 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <cstdlib>
+#include <string>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace common
+{
+
+static const char* const cHelperSocketPath = "/tmp/openauto_helper.sock";
+static const int cHelperFailedStatus = -1;
+
+class HelperProtocol
+{
+public:
+    static std::string encode(uint32_t id, std::string payload)
+    {
+        for(auto& character : payload)
+        {
+            if(character == '\n')
+            {
+                character = ' ';
+            }
+        }
+
+        return std::to_string(id) + "\t" + payload + "\n";
+    }
+
+    static bool decode(const std::string& line, uint32_t& id, std::string& payload)
+    {
+        const auto separator = line.find('\t');
+        if(separator == std::string::npos || separator == 0)
+        {
+            return false;
+        }
+
+        char* end = nullptr;
+        const auto value = std::strtoul(line.c_str(), &end, 10);
+        if(end != line.c_str() + separator)
+        {
+            return false;
+        }
+
+        id = static_cast<uint32_t>(value);
+        payload = line.substr(separator + 1);
+        if(!payload.empty() && payload.back() == '\n')
+        {
+            payload.pop_back();
+        }
+
+        return true;
+    }
+};
+
+}
+}
+}
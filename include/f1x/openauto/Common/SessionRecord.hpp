@@ -0,0 +1,160 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace common
+{
+
+enum class SessionRecordDirection
+{
+    FROM_PHONE,
+    TO_PHONE
+};
+
+static const char cSessionRecordMagic[8] = {'O', 'A', 'R', 'E', 'C', '0', '0', '1'};
+
+struct SessionRecordEntry
+{
+    uint64_t timestamp;
+    SessionRecordDirection direction;
+    uint8_t channelId;
+    bool encrypted;
+    bool control;
+    std::vector<uint8_t> payload;
+};
+
+class SessionRecordWriter
+{
+public:
+    SessionRecordWriter(std::ostream& stream)
+        : stream_(stream)
+        , lastTimestamp_(0)
+    {
+        stream_.write(cSessionRecordMagic, sizeof(cSessionRecordMagic));
+    }
+
+    void write(const SessionRecordEntry& entry)
+    {
+        this->writeVarint(entry.timestamp - lastTimestamp_);
+        lastTimestamp_ = entry.timestamp;
+
+        const uint8_t flags = (entry.direction == SessionRecordDirection::TO_PHONE ? 1 : 0) | (entry.encrypted ? 2 : 0) | (entry.control ? 4 : 0);
+        stream_.put(static_cast<char>(entry.channelId));
+        stream_.put(static_cast<char>(flags));
+
+        this->writeVarint(entry.payload.size());
+        stream_.write(reinterpret_cast<const char*>(entry.payload.data()), entry.payload.size());
+    }
+
+private:
+    void writeVarint(uint64_t value)
+    {
+        do
+        {
+            uint8_t byte = value & 0x7F;
+            value >>= 7;
+            stream_.put(static_cast<char>(value != 0 ? byte | 0x80 : byte));
+        }
+        while(value != 0);
+    }
+
+    std::ostream& stream_;
+    uint64_t lastTimestamp_;
+};
+
+class SessionRecordReader
+{
+public:
+    SessionRecordReader(std::istream& stream)
+        : stream_(stream)
+        , lastTimestamp_(0)
+    {
+        char magic[sizeof(cSessionRecordMagic)];
+        valid_ = stream_.read(magic, sizeof(magic)) && std::memcmp(magic, cSessionRecordMagic, sizeof(magic)) == 0;
+    }
+
+    bool isValid() const
+    {
+        return valid_;
+    }
+
+    bool read(SessionRecordEntry& entry)
+    {
+        uint64_t delta = 0;
+        uint64_t size = 0;
+        char channelId = 0;
+        char flags = 0;
+
+        if(!valid_ || !this->readVarint(delta) || !stream_.get(channelId) || !stream_.get(flags) || !this->readVarint(size))
+        {
+            return false;
+        }
+
+        lastTimestamp_ += delta;
+        entry.timestamp = lastTimestamp_;
+        entry.channelId = static_cast<uint8_t>(channelId);
+        entry.direction = (flags & 1) != 0 ? SessionRecordDirection::TO_PHONE : SessionRecordDirection::FROM_PHONE;
+        entry.encrypted = (flags & 2) != 0;
+        entry.control = (flags & 4) != 0;
+        entry.payload.resize(size);
+
+        return static_cast<bool>(stream_.read(reinterpret_cast<char*>(entry.payload.data()), size));
+    }
+
+private:
+    bool readVarint(uint64_t& value)
+    {
+        value = 0;
+
+        for(uint32_t shift = 0; shift < 64; shift += 7)
+        {
+            char byte = 0;
+            if(!stream_.get(byte))
+            {
+                return false;
+            }
+
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if((byte & 0x80) == 0)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    std::istream& stream_;
+    uint64_t lastTimestamp_;
+    bool valid_;
+};
+
+}
+}
+}
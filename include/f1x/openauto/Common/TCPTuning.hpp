@@ -0,0 +1,124 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace common
+{
+
+struct TCPTuning
+{
+    bool noDelay;
+    int32_t receiveBufferSize;
+    int32_t sendBufferSize;
+    bool keepAlive;
+    int32_t keepAliveIdle;
+    int32_t keepAliveInterval;
+    int32_t keepAliveCount;
+    uint32_t userTimeout;
+    int32_t busyPoll;
+};
+
+class TCPTuner
+{
+public:
+    // The window scale is negotiated in the SYN, so buffers go on the listening socket or before connect().
+    static std::vector<std::string> applyBuffers(int fd, const TCPTuning& tuning)
+    {
+        std::vector<std::string> failures;
+
+        if(tuning.receiveBufferSize > 0)
+        {
+            setOption(fd, SOL_SOCKET, SO_RCVBUF, tuning.receiveBufferSize, "SO_RCVBUF", failures);
+        }
+
+        if(tuning.sendBufferSize > 0)
+        {
+            setOption(fd, SOL_SOCKET, SO_SNDBUF, tuning.sendBufferSize, "SO_SNDBUF", failures);
+        }
+
+        return failures;
+    }
+
+    static std::vector<std::string> apply(int fd, const TCPTuning& tuning)
+    {
+        std::vector<std::string> failures;
+
+        setOption(fd, IPPROTO_TCP, TCP_NODELAY, tuning.noDelay ? 1 : 0, "TCP_NODELAY", failures);
+        setOption(fd, SOL_SOCKET, SO_KEEPALIVE, tuning.keepAlive ? 1 : 0, "SO_KEEPALIVE", failures);
+
+        if(tuning.keepAlive)
+        {
+#ifdef TCP_KEEPIDLE
+            setOption(fd, IPPROTO_TCP, TCP_KEEPIDLE, tuning.keepAliveIdle, "TCP_KEEPIDLE", failures);
+            setOption(fd, IPPROTO_TCP, TCP_KEEPINTVL, tuning.keepAliveInterval, "TCP_KEEPINTVL", failures);
+            setOption(fd, IPPROTO_TCP, TCP_KEEPCNT, tuning.keepAliveCount, "TCP_KEEPCNT", failures);
+#endif
+        }
+
+#ifdef TCP_USER_TIMEOUT
+        if(tuning.userTimeout > 0)
+        {
+            setOption(fd, IPPROTO_TCP, TCP_USER_TIMEOUT, static_cast<int>(tuning.userTimeout), "TCP_USER_TIMEOUT", failures);
+        }
+#endif
+
+#ifdef SO_BUSY_POLL
+        if(tuning.busyPoll > 0)
+        {
+            setOption(fd, SOL_SOCKET, SO_BUSY_POLL, tuning.busyPoll, "SO_BUSY_POLL", failures);
+        }
+#endif
+
+        return failures;
+    }
+
+    static std::string describe(const TCPTuning& tuning)
+    {
+        return "nodelay: " + std::to_string(tuning.noDelay)
+                + ", rcvbuf: " + std::to_string(tuning.receiveBufferSize)
+                + ", sndbuf: " + std::to_string(tuning.sendBufferSize)
+                + ", keepalive: " + (tuning.keepAlive ? std::to_string(tuning.keepAliveIdle) + "/" + std::to_string(tuning.keepAliveInterval) + "/" + std::to_string(tuning.keepAliveCount) : std::string("off"))
+                + ", user timeout: " + std::to_string(tuning.userTimeout)
+                + ", busy poll: " + std::to_string(tuning.busyPoll);
+    }
+
+private:
+    static void setOption(int fd, int level, int name, int value, const char* optionName, std::vector<std::string>& failures)
+    {
+        if(setsockopt(fd, level, name, &value, sizeof(value)) != 0)
+        {
+            failures.push_back(optionName);
+        }
+    }
+};
+
+}
+}
+}
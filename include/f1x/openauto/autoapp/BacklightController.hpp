@@ -0,0 +1,80 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <QObject>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+class BacklightController: public QObject
+{
+    Q_OBJECT
+
+public:
+    BacklightController(QObject* parent = nullptr);
+    ~BacklightController() override;
+
+    bool start(const std::string& path);
+    void stop();
+    bool isAvailable() const;
+    int getBrightness() const;
+    void setBrightness(int value);
+    void rampTo(int value, std::chrono::milliseconds duration);
+    void refresh();
+
+signals:
+    void brightnessChanged(int value);
+
+private:
+    void run();
+    bool readBrightness(int& value) const;
+    bool writeBrightness(int value);
+
+    std::string path_;
+    int fd_;
+    bool regularFile_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    int target_;
+    int rampFrom_;
+    std::chrono::steady_clock::time_point rampStart_;
+    std::chrono::milliseconds rampDuration_;
+    bool refreshRequested_;
+    bool stopping_;
+    size_t coalescedWrites_;
+    std::atomic<int> brightness_;
+    std::thread thread_;
+
+    static const std::chrono::milliseconds cFrameInterval;
+};
+
+}
+}
+}
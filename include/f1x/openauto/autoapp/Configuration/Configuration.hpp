@@ -20,10 +20,13 @@
 
 #include <boost/property_tree/ini_parser.hpp>
 #include <f1x/openauto/autoapp/Configuration/IConfiguration.hpp>
+#include <f1x/openauto/autoapp/Configuration/ConfigurationStore.hpp>
+#include <f1x/openauto/autoapp/Configuration/ConfigurationWriter.hpp>
 #include <iostream>
 #include <string>
 #include <fstream>
 #include <stdio.h>
+#include <map>
 
 namespace f1x
 {
@@ -42,6 +45,7 @@ public:
     void load() override;
     void reset() override;
     void save() override;
+    void flush() override;
 
     bool hasTouchScreen() const override;
 
@@ -87,6 +91,7 @@ public:
     QString getCSValue(QString searchString) const override;
     QString readFileContent(QString fileName) const override;
     QString getParamFromFile(QString fileName, QString searchString) const override;
+    void subscribeCSValues(std::function<void(const QStringList& keys)> handler) override;
 
     aasdk::proto::enums::VideoFPS::Enum getVideoFPS() const override;
     void setVideoFPS(aasdk::proto::enums::VideoFPS::Enum value) override;
@@ -118,11 +123,39 @@ public:
     AudioOutputBackendType getAudioOutputBackendType() const override;
     void setAudioOutputBackendType(AudioOutputBackendType value) override;
 
+    std::string getCANInterface() const override;
+    void setCANInterface(const std::string& value) override;
+    std::string getCANDecodingTable() const override;
+    void setCANDecodingTable(const std::string& value) override;
+    size_t getCANPublishInterval() const override;
+    void setCANPublishInterval(size_t value) override;
+    size_t getSensorBatchWindow() const override;
+    void setSensorBatchWindow(size_t value) override;
+    std::string getSessionRecordingPath() const override;
+    void setSessionRecordingPath(const std::string& value) override;
+    size_t getSessionHistorySize() const override;
+    void setSessionHistorySize(size_t value) override;
+    ExecutorConfig getExecutorConfig(ExecutorType type) const override;
+    void setExecutorConfig(ExecutorType type, const ExecutorConfig& value) override;
+    size_t getShutdownTimeout() const override;
+    void setShutdownTimeout(size_t value) override;
+    common::TCPTuning getTCPTuning() const override;
+    void setTCPTuning(const common::TCPTuning& value) override;
+    size_t getSaveDelay() const override;
+    void setSaveDelay(size_t value) override;
+
 private:
     void readButtonCodes(boost::property_tree::ptree& iniConfig);
     void insertButtonCode(boost::property_tree::ptree& iniConfig, const std::string& buttonCodeKey, aasdk::proto::enums::ButtonCode::Enum buttonCode);
     void writeButtonCodes(boost::property_tree::ptree& iniConfig);
+    void readExecutorConfig(boost::property_tree::ptree& iniConfig, ExecutorType type, const ExecutorConfig& defaultConfig);
+    void writeExecutorConfig(boost::property_tree::ptree& iniConfig, ExecutorType type);
+    static std::string getExecutorKey(ExecutorType type);
+    void readTCPTuning(boost::property_tree::ptree& iniConfig);
+    void writeTCPTuning(boost::property_tree::ptree& iniConfig);
 
+    std::shared_ptr<ConfigurationStore> store_;
+    std::unique_ptr<ConfigurationWriter> writer_;
     HandednessOfTrafficType handednessOfTrafficType_;
     bool showClock_;
 
@@ -156,8 +189,20 @@ private:
     bool musicAudioChannelEnabled_;
     bool speechAudiochannelEnabled_;
     AudioOutputBackendType audioOutputBackendType_;
+    std::string canInterface_;
+    std::string canDecodingTable_;
+    size_t canPublishInterval_;
+    size_t sensorBatchWindow_;
+    std::string sessionRecordingPath_;
+    size_t sessionHistorySize_;
+    std::map<ExecutorType, ExecutorConfig> executorConfigs_;
+    size_t shutdownTimeout_;
+    common::TCPTuning tcpTuning_;
+    size_t saveDelay_;
 
     static const std::string cConfigFileName;
+    static const std::string cCSEnvFileName;
+    static const std::string cCSDefaultEnvFileName;
 
     static const std::string cGeneralShowClockKey;
 
@@ -180,6 +225,7 @@ private:
     static const std::string cGeneralMp3AutoPlayKey;
     static const std::string cGeneralShowAutoPlayKey;
     static const std::string cGeneralInstantPlayKey;
+    static const std::string cGeneralSaveDelayKey;
 
     static const std::string cVideoFPSKey;
     static const std::string cVideoResolutionKey;
@@ -192,6 +238,27 @@ private:
     static const std::string cAudioSpeechAudioChannelEnabled;
     static const std::string cAudioOutputBackendType;
 
+    static const std::string cSensorCANInterfaceKey;
+    static const std::string cSensorCANDecodingTableKey;
+    static const std::string cSensorCANPublishIntervalKey;
+    static const std::string cSensorBatchWindowKey;
+
+    static const std::string cDiagnosticsSessionRecordingPathKey;
+    static const std::string cDiagnosticsSessionHistorySizeKey;
+
+    static const std::string cExecutorsMediaKey;
+    static const std::string cExecutorsControlKey;
+    static const std::string cExecutorsTransportKey;
+    static const std::string cExecutorsHousekeepingKey;
+    static const std::string cExecutorsShutdownTimeoutKey;
+    static const ExecutorConfig cMediaExecutorDefaults;
+    static const ExecutorConfig cControlExecutorDefaults;
+    static const ExecutorConfig cTransportExecutorDefaults;
+    static const ExecutorConfig cHousekeepingExecutorDefaults;
+
+    static const std::string cTCPKey;
+    static const common::TCPTuning cTCPTuningDefaults;
+
     static const std::string cBluetoothAdapterTypeKey;
     static const std::string cBluetoothRemoteAdapterAddressKey;
 
@@ -0,0 +1,87 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <QObject>
+#include <QSocketNotifier>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace configuration
+{
+
+class ConfigurationStore: public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef std::function<void(const std::string& fileName, const std::vector<std::string>& keys)> Handler;
+
+    ConfigurationStore(QObject* parent = nullptr);
+    ~ConfigurationStore() override;
+
+    bool getValue(const std::string& fileName, const std::string& key, std::string& value);
+    bool findLine(const std::string& fileName, const std::string& pattern, std::string& value);
+    bool getContent(const std::string& fileName, std::string& content);
+    void subscribe(const std::string& fileName, Handler handler);
+
+private slots:
+    void onInotifyEvent();
+
+private:
+    struct File
+    {
+        bool stale;
+        bool exists;
+        bool watched;
+        std::vector<std::string> lines;
+        std::string content;
+        std::unordered_map<std::string, std::string> values;
+    };
+
+    File& getFile(const std::string& fileName);
+    bool watch(const std::string& fileName);
+    std::vector<std::string> reload(const std::string& fileName, File& file);
+    static void parse(const std::string& fileName, File& file);
+    static std::string unquote(const std::string& value);
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, File> files_;
+    std::unordered_map<int, std::string> watchedDirectories_;
+    std::unordered_map<std::string, int> directoryWatches_;
+    std::multimap<std::string, Handler> handlers_;
+    int inotifyFd_;
+    std::unique_ptr<QSocketNotifier> notifier_;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,65 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <boost/property_tree/ptree.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace configuration
+{
+
+class ConfigurationWriter
+{
+public:
+    ConfigurationWriter(std::string fileName);
+    ~ConfigurationWriter();
+
+    void write(boost::property_tree::ptree iniConfig, std::chrono::milliseconds delay);
+    void flush();
+
+private:
+    void run();
+    bool writeFile(const boost::property_tree::ptree& iniConfig);
+
+    std::string fileName_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::unique_ptr<boost::property_tree::ptree> pending_;
+    std::chrono::steady_clock::time_point deadline_;
+    size_t coalescedWrites_;
+    bool writing_;
+    bool stopping_;
+    std::thread thread_;
+};
+
+}
+}
+}
+}
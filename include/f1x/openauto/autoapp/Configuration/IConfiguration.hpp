@@ -18,14 +18,18 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 #include <QRect>
+#include <QStringList>
 #include <aasdk_proto/VideoFPSEnum.pb.h>
 #include <aasdk_proto/VideoResolutionEnum.pb.h>
 #include <aasdk_proto/ButtonCodeEnum.pb.h>
 #include <f1x/openauto/autoapp/Configuration/BluetootAdapterType.hpp>
 #include <f1x/openauto/autoapp/Configuration/HandednessOfTrafficType.hpp>
 #include <f1x/openauto/autoapp/Configuration/AudioOutputBackendType.hpp>
+#include <f1x/openauto/autoapp/Configuration/ExecutorConfig.hpp>
+#include <f1x/openauto/Common/TCPTuning.hpp>
 
 namespace f1x
 {
@@ -47,6 +51,7 @@ public:
     virtual void load() = 0;
     virtual void reset() = 0;
     virtual void save() = 0;
+    virtual void flush() = 0;
 
     virtual bool hasTouchScreen() const = 0;
 
@@ -91,6 +96,7 @@ public:
     virtual QString getCSValue(QString searchString) const = 0;
     virtual QString readFileContent(QString fileName) const = 0;
     virtual QString getParamFromFile(QString fileName, QString searchString) const = 0;
+    virtual void subscribeCSValues(std::function<void(const QStringList& keys)> handler) = 0;
 
     virtual aasdk::proto::enums::VideoFPS::Enum getVideoFPS() const = 0;
     virtual void setVideoFPS(aasdk::proto::enums::VideoFPS::Enum value) = 0;
@@ -121,6 +127,27 @@ public:
     virtual void setSpeechAudioChannelEnabled(bool value) = 0;
     virtual AudioOutputBackendType getAudioOutputBackendType() const = 0;
     virtual void setAudioOutputBackendType(AudioOutputBackendType value) = 0;
+
+    virtual std::string getCANInterface() const = 0;
+    virtual void setCANInterface(const std::string& value) = 0;
+    virtual std::string getCANDecodingTable() const = 0;
+    virtual void setCANDecodingTable(const std::string& value) = 0;
+    virtual size_t getCANPublishInterval() const = 0;
+    virtual void setCANPublishInterval(size_t value) = 0;
+    virtual size_t getSensorBatchWindow() const = 0;
+    virtual void setSensorBatchWindow(size_t value) = 0;
+    virtual std::string getSessionRecordingPath() const = 0;
+    virtual void setSessionRecordingPath(const std::string& value) = 0;
+    virtual size_t getSessionHistorySize() const = 0;
+    virtual void setSessionHistorySize(size_t value) = 0;
+    virtual ExecutorConfig getExecutorConfig(ExecutorType type) const = 0;
+    virtual void setExecutorConfig(ExecutorType type, const ExecutorConfig& value) = 0;
+    virtual size_t getShutdownTimeout() const = 0;
+    virtual void setShutdownTimeout(size_t value) = 0;
+    virtual common::TCPTuning getTCPTuning() const = 0;
+    virtual void setTCPTuning(const common::TCPTuning& value) = 0;
+    virtual size_t getSaveDelay() const = 0;
+    virtual void setSaveDelay(size_t value) = 0;
 };
 
 }
@@ -0,0 +1,65 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/asio.hpp>
+#include <f1x/openauto/autoapp/Configuration/ExecutorConfig.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+class Executor
+{
+public:
+    Executor(std::string name, configuration::ExecutorConfig config);
+
+    boost::asio::io_service& getIoService();
+    void start();
+    void stop();
+    bool join(std::chrono::steady_clock::time_point deadline);
+    bool isFinished() const;
+    std::string describe() const;
+
+private:
+    void run(size_t index, std::promise<void> finished);
+    void applyThreadSettings(size_t index);
+
+    std::string name_;
+    configuration::ExecutorConfig config_;
+    boost::asio::io_service ioService_;
+    std::unique_ptr<boost::asio::io_service::work> work_;
+    std::vector<std::thread> threads_;
+    std::vector<std::future<void>> finished_;
+
+    static const std::chrono::milliseconds cForcedStopGrace;
+};
+
+}
+}
+}
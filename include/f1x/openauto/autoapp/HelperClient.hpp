@@ -0,0 +1,91 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include <boost/asio.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+class HelperClient
+{
+public:
+    typedef std::function<void(int status)> Handler;
+
+    HelperClient(boost::asio::io_service& ioService, std::string socketPath, std::string helperPath);
+
+    void execute(std::string command, Handler handler = nullptr);
+    void coalesce(std::string key, std::string command, Handler handler = nullptr);
+    void stop();
+
+private:
+    struct Command
+    {
+        uint32_t id;
+        std::string key;
+        std::string command;
+        std::vector<Handler> handlers;
+        std::chrono::steady_clock::time_point timestamp;
+    };
+
+    void enqueue(std::string key, std::string command, Handler handler);
+    void flush();
+    void connect();
+    void onConnect(const boost::system::error_code& ec);
+    void read();
+    void write();
+    void fail();
+    void spawnHelper();
+    static void complete(Command& command, int status);
+
+    boost::asio::io_service::strand strand_;
+    boost::asio::local::stream_protocol::socket socket_;
+    boost::asio::deadline_timer retryTimer_;
+    boost::asio::streambuf buffer_;
+    std::string socketPath_;
+    std::string helperPath_;
+    std::deque<Command> queue_;
+    std::map<uint32_t, Command> inFlight_;
+    std::set<std::string> busyKeys_;
+    std::deque<std::string> writeQueue_;
+    uint32_t nextId_;
+    bool connected_;
+    bool connecting_;
+    bool stopped_;
+    pid_t helperPid_;
+    size_t coalescedCommands_;
+
+    static const size_t cRetryInterval;
+};
+
+}
+}
+}
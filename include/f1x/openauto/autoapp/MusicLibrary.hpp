@@ -0,0 +1,105 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+struct MusicTrack
+{
+    QString fileName;
+    QString artist;
+    QString title;
+    unsigned int track;
+    bool hasTags;
+    QString streamUrl;
+
+    bool operator==(const MusicTrack& other) const;
+    bool operator!=(const MusicTrack& other) const;
+};
+
+class MusicLibrary: public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef std::vector<MusicTrack> Tracks;
+
+    MusicLibrary(QObject* parent = nullptr);
+    ~MusicLibrary() override;
+
+    bool load(const QString& rootPath);
+    void scan(const QString& rootPath);
+    QStringList getAlbums() const;
+    Tracks getTracks(const QString& album) const;
+
+signals:
+    void albumsChanged(const QStringList& albums);
+    void albumChanged(const QString& album);
+    void scanFinished();
+
+private:
+    struct CacheEntry
+    {
+        qint64 size;
+        qint64 modified;
+        MusicTrack track;
+    };
+
+    typedef QHash<QString, CacheEntry> Cache;
+
+    void cancel();
+    void run(QString rootPath);
+    Tracks scanAlbum(const QString& rootPath, const QString& album, const Cache& cache, Cache& scanned, size_t& tagsRead);
+    static MusicTrack readTrack(const QString& path, const QString& fileName);
+    bool loadCache(const QString& rootPath, QStringList& albums, std::map<QString, Tracks>& tracks, Cache& cache) const;
+    void saveCache(const QString& rootPath) const;
+
+    mutable std::mutex mutex_;
+    QString rootPath_;
+    QStringList albums_;
+    std::map<QString, Tracks> tracks_;
+    Cache cache_;
+    std::atomic<bool> cancelled_;
+    std::thread thread_;
+
+    static const QString cCacheFileName;
+    static const quint32 cCacheMagic;
+    static const quint32 cCacheVersion;
+    static const QStringList cFileFilters;
+    static const unsigned int cMaxWorkers;
+};
+
+}
+}
+}
@@ -0,0 +1,145 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <linux/rtnetlink.h>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <QMap>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+struct NetworkInterfaceState
+{
+    bool up = false;
+    QString address;
+    QString netmask;
+    QString gateway;
+
+    bool operator==(const NetworkInterfaceState& other) const
+    {
+        return up == other.up && address == other.address && netmask == other.netmask && gateway == other.gateway;
+    }
+};
+
+struct NetworkSnapshot
+{
+    QMap<QString, NetworkInterfaceState> interfaces;
+    bool hotspotActive = false;
+    QString ssid;
+    QStringList hotspotClients;
+
+    bool operator==(const NetworkSnapshot& other) const
+    {
+        return interfaces == other.interfaces && hotspotActive == other.hotspotActive && ssid == other.ssid && hotspotClients == other.hotspotClients;
+    }
+};
+
+class NetworkMonitor: public QObject
+{
+    Q_OBJECT
+
+public:
+    NetworkMonitor(QObject* parent = nullptr);
+    ~NetworkMonitor() override;
+
+    bool start();
+    void stop();
+    void refresh();
+    NetworkSnapshot getSnapshot() const;
+
+    static const char* const cWirelessInterface;
+
+signals:
+    void snapshotChanged(const f1x::openauto::autoapp::NetworkSnapshot& snapshot);
+    void hotspotClientAppeared(const QString& address);
+
+private:
+    struct Link
+    {
+        std::string name;
+        bool up;
+    };
+
+    struct Address
+    {
+        std::string address;
+        int prefixLength;
+    };
+
+    void run();
+    void wake();
+    bool synchronise();
+    bool dump(int type);
+    bool process(const char* buffer, size_t size, uint32_t sequence);
+    void handleLink(const nlmsghdr* header);
+    void handleAddress(const nlmsghdr* header);
+    void handleRoute(const nlmsghdr* header);
+    void handleNeighbour(const nlmsghdr* header);
+    void readWirelessState();
+    void publish();
+    static void parseAttributes(const nlmsghdr* header, size_t headerSize, const rtattr* attributes[], int maxType);
+    static std::string readFile(const char* path);
+    static std::string toString(int family, const void* address);
+    static QString toNetmask(int prefixLength);
+
+    int socket_;
+    int eventFd_;
+    uint32_t sequence_;
+    bool synchronising_;
+    std::atomic<bool> refreshRequested_;
+    std::atomic<bool> stopping_;
+    std::vector<char> buffer_;
+    std::map<int, Link> links_;
+    std::map<int, std::vector<Address>> addresses_;
+    std::map<int, std::string> gateways_;
+    std::map<int, std::set<std::string>> neighbours_;
+    bool hotspotActive_;
+    std::string ssid_;
+    std::string wirelessGateway_;
+    QStringList appearedClients_;
+    mutable std::mutex mutex_;
+    NetworkSnapshot snapshot_;
+    std::thread thread_;
+
+    static const char* const cHotspotStatePath;
+    static const char* const cWifiSsidPath;
+    static const char* const cWirelessGatewayPath;
+    static const char* const cHostapdConfigPath;
+    static const size_t cBufferSize;
+};
+
+}
+}
+}
+
+Q_DECLARE_METATYPE(f1x::openauto::autoapp::NetworkSnapshot)
@@ -0,0 +1,83 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <boost/asio.hpp>
+#include <f1x/aasdk/TCP/ITCPEndpoint.hpp>
+#include <f1x/aasdk/TCP/ITCPWrapper.hpp>
+#include <f1x/openauto/Common/TCPTuning.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+class ParallelConnector: public std::enable_shared_from_this<ParallelConnector>
+{
+public:
+    typedef std::shared_ptr<ParallelConnector> Pointer;
+    typedef std::function<void(const boost::system::error_code&, const std::string&, aasdk::tcp::ITCPEndpoint::SocketPointer)> Handler;
+
+    ParallelConnector(boost::asio::io_service& ioService, aasdk::tcp::ITCPWrapper& tcpWrapper, common::TCPTuning tcpTuning, uint16_t port, size_t staggerDelay, size_t attemptTimeout);
+
+    void connect(std::vector<std::string> addresses, Handler handler);
+    void cancel();
+
+private:
+    using std::enable_shared_from_this<ParallelConnector>::shared_from_this;
+
+    struct Attempt
+    {
+        std::string address;
+        aasdk::tcp::ITCPEndpoint::SocketPointer socket;
+        std::shared_ptr<boost::asio::deadline_timer> timer;
+        bool finished;
+    };
+
+    void startAttempt(size_t index);
+    void openSocket(Attempt& attempt);
+    void onConnect(const boost::system::error_code& error, size_t index);
+    void onTimeout(const boost::system::error_code& error, size_t index);
+    void finishAttempt(size_t index, const boost::system::error_code& error);
+    void closeAll();
+
+    boost::asio::io_service& ioService_;
+    boost::asio::io_service::strand strand_;
+    aasdk::tcp::ITCPWrapper& tcpWrapper_;
+    common::TCPTuning tcpTuning_;
+    uint16_t port_;
+    size_t staggerDelay_;
+    size_t attemptTimeout_;
+    std::vector<Attempt> attempts_;
+    Handler handler_;
+    size_t pendingAttempts_;
+    boost::system::error_code lastError_;
+    std::chrono::steady_clock::time_point startTimestamp_;
+};
+
+}
+}
+}
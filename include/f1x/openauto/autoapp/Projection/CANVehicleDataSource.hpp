@@ -0,0 +1,106 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <linux/can.h>
+#include <boost/property_tree/ptree.hpp>
+#include <f1x/openauto/autoapp/Projection/IVehicleDataSource.hpp>
+#include <f1x/openauto/autoapp/Projection/VehicleData.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+
+class CANVehicleDataSource: public IVehicleDataSource
+{
+public:
+    CANVehicleDataSource(std::string interfaceName, std::string decodingTable, std::chrono::milliseconds publishInterval);
+    ~CANVehicleDataSource() override;
+
+    void start(IVehicleDataSourceEventHandler& eventHandler) override;
+    void stop() override;
+    SensorTypes getSupportedSensors() const override;
+
+private:
+    enum class SignalType
+    {
+        SPEED,
+        GEAR,
+        PARKING_BRAKE,
+        HEADLIGHTS
+    };
+
+    struct Signal
+    {
+        SignalType type;
+        canid_t frameId;
+        uint32_t startBit;
+        uint32_t length;
+        bool bigEndian;
+        bool isSigned;
+        double scale;
+        double offset;
+        std::map<int64_t, aasdk::proto::enums::Gear::Enum> gearValues;
+    };
+
+    typedef std::vector<Signal> Signals;
+
+    void loadDecodingTable();
+    void readSignal(const boost::property_tree::ptree& iniConfig, const std::string& section, SignalType type);
+    bool open();
+    void close();
+    void run();
+    void readFrames();
+    void decode(const struct can_frame& frame);
+    void publish();
+    static int64_t extract(const struct can_frame& frame, const Signal& signal);
+
+    std::string interfaceName_;
+    std::string decodingTable_;
+    Signals signals_;
+    int socket_;
+    int wakeupFd_;
+    std::thread thread_;
+    IVehicleDataSourceEventHandler* eventHandler_;
+    VehicleData pending_;
+    VehicleData published_;
+    std::chrono::steady_clock::time_point lastPublish_;
+    std::chrono::milliseconds publishInterval_;
+    size_t framesCount_;
+    size_t publishCount_;
+
+    static const std::string cSpeedSection;
+    static const std::string cGearSection;
+    static const std::string cParkingBrakeSection;
+    static const std::string cHeadlightsSection;
+};
+
+}
+}
+}
+}
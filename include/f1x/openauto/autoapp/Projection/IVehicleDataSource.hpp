@@ -0,0 +1,51 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <aasdk_proto/SensorTypeEnum.pb.h>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+
+class IVehicleDataSourceEventHandler;
+
+class IVehicleDataSource
+{
+public:
+    typedef std::shared_ptr<IVehicleDataSource> Pointer;
+    typedef std::vector<aasdk::proto::enums::SensorType::Enum> SensorTypes;
+
+    virtual ~IVehicleDataSource() = default;
+    virtual void start(IVehicleDataSourceEventHandler& eventHandler) = 0;
+    virtual void stop() = 0;
+    virtual SensorTypes getSupportedSensors() const = 0;
+};
+
+}
+}
+}
+}
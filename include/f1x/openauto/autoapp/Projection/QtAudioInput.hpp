@@ -49,7 +49,6 @@ public:
 
 signals:
     void startRecording(StartPromise::Pointer promise);
-    void stopRecording();
 
 private slots:
     void createAudioInput();
@@ -27,6 +27,7 @@
 #include <f1x/openauto/autoapp/Service/IAndroidAutoEntity.hpp>
 #include <f1x/openauto/autoapp/Service/IService.hpp>
 #include <f1x/openauto/autoapp/Service/IPinger.hpp>
+#include <f1x/openauto/autoapp/Service/SessionTimeline.hpp>
 
 namespace f1x
 {
@@ -46,7 +47,8 @@ public:
                       aasdk::messenger::IMessenger::Pointer messenger,
                       configuration::IConfiguration::Pointer configuration,
                       ServiceList serviceList,
-                      IPinger::Pointer pinger);
+                      IPinger::Pointer pinger,
+                      SessionTimeline::Pointer sessionTimeline);
     ~AndroidAutoEntity() override;
 
     void start(IAndroidAutoEntityEventHandler& eventHandler) override;
@@ -78,6 +80,8 @@ private:
     ServiceList serviceList_;
     IPinger::Pointer pinger_;
     IAndroidAutoEntityEventHandler* eventHandler_;
+    SessionTimeline::Pointer sessionTimeline_;
+    size_t handshakeRound_;
 };
 
 }
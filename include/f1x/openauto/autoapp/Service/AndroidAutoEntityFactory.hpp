@@ -20,6 +20,7 @@
 
 #include <boost/asio.hpp>
 #include <f1x/aasdk/Transport/ITransport.hpp>
+#include <f1x/aasdk/Transport/ISSLWrapper.hpp>
 #include <f1x/openauto/autoapp/Configuration/IConfiguration.hpp>
 #include <f1x/openauto/autoapp/Service/IAndroidAutoEntityFactory.hpp>
 #include <f1x/openauto/autoapp/Service/IServiceFactory.hpp>
@@ -37,18 +38,22 @@ class AndroidAutoEntityFactory: public IAndroidAutoEntityFactory
 {
 public:
     AndroidAutoEntityFactory(boost::asio::io_service& ioService,
+                             boost::asio::io_service& transportIoService,
                              configuration::IConfiguration::Pointer configuration,
                              IServiceFactory& serviceFactory);
 
-    IAndroidAutoEntity::Pointer create(aasdk::usb::IAOAPDevice::Pointer aoapDevice) override;
-    IAndroidAutoEntity::Pointer create(aasdk::tcp::ITCPEndpoint::Pointer tcpEndpoint) override;
+    IAndroidAutoEntity::Pointer create(aasdk::usb::IAOAPDevice::Pointer aoapDevice, SessionTimeline::Pointer sessionTimeline) override;
+    IAndroidAutoEntity::Pointer create(aasdk::tcp::ITCPEndpoint::Pointer tcpEndpoint, SessionTimeline::Pointer sessionTimeline) override;
 
 private:
-    IAndroidAutoEntity::Pointer create(aasdk::transport::ITransport::Pointer transport);
+    IAndroidAutoEntity::Pointer create(aasdk::transport::ITransport::Pointer transport, SessionTimeline::Pointer sessionTimeline);
+    std::string getRecordingFileName() const;
 
     boost::asio::io_service& ioService_;
+    boost::asio::io_service& transportIoService_;
     configuration::IConfiguration::Pointer configuration_;
     IServiceFactory& serviceFactory_;
+    aasdk::transport::ISSLWrapper::Pointer sslWrapper_;
 };
 
 }
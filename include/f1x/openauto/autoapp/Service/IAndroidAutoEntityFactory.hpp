@@ -21,6 +21,7 @@
 #include <f1x/aasdk/TCP/ITCPEndpoint.hpp>
 #include <f1x/aasdk/USB/IAOAPDevice.hpp>
 #include <f1x/openauto/autoapp/Service/IAndroidAutoEntity.hpp>
+#include <f1x/openauto/autoapp/Service/SessionTimeline.hpp>
 
 namespace f1x
 {
@@ -36,8 +37,8 @@ class IAndroidAutoEntityFactory
 public:
     virtual ~IAndroidAutoEntityFactory() = default;
 
-    virtual IAndroidAutoEntity::Pointer create(aasdk::usb::IAOAPDevice::Pointer aoapDevice) = 0;
-    virtual IAndroidAutoEntity::Pointer create(aasdk::tcp::ITCPEndpoint::Pointer tcpEndpoint) = 0;
+    virtual IAndroidAutoEntity::Pointer create(aasdk::usb::IAOAPDevice::Pointer aoapDevice, SessionTimeline::Pointer sessionTimeline) = 0;
+    virtual IAndroidAutoEntity::Pointer create(aasdk::tcp::ITCPEndpoint::Pointer tcpEndpoint, SessionTimeline::Pointer sessionTimeline) = 0;
 };
 
 }
@@ -37,7 +37,7 @@ public:
 
     virtual ~IPinger() = default;
     virtual void ping(Promise::Pointer promise) = 0;
-    virtual void pong() = 0;
+    virtual void pong(int64_t timestamp) = 0;
     virtual void cancel() = 0;
 };
 
@@ -18,6 +18,9 @@
 
 #pragma once
 
+#include <chrono>
+#include <deque>
+#include <boost/circular_buffer.hpp>
 #include <f1x/openauto/autoapp/Service/IPinger.hpp>
 
 namespace f1x
@@ -35,13 +38,15 @@ public:
     Pinger(boost::asio::io_service& ioService, time_t duration);
 
     void ping(Promise::Pointer promise) override;
-    void pong() override;
+    void pong(int64_t timestamp) override;
     void cancel() override;
 
 private:
     using std::enable_shared_from_this<Pinger>::shared_from_this;
 
     void onTimerExceeded(const boost::system::error_code& error);
+    void updateTimeout(int64_t rtt);
+    void publishStatistics();
 
     boost::asio::io_service::strand strand_;
     boost::asio::deadline_timer timer_;
@@ -50,6 +55,18 @@ private:
     Promise::Pointer promise_;
     int64_t pingsCount_;
     int64_t pongsCount_;
+    std::deque<std::chrono::steady_clock::time_point> pendingPings_;
+    boost::circular_buffer<int64_t> rttSamples_;
+    int64_t smoothedRtt_;
+    int64_t rttVariation_;
+    int64_t timeout_;
+
+    static constexpr size_t cRttSamplesCount = 64;
+    static constexpr size_t cStatisticsInterval = 10;
+    static constexpr int64_t cInitialTimeout = 5000000;
+    static constexpr int64_t cMinTimeout = 1500000;
+    static constexpr int64_t cMaxTimeout = 10000000;
+    static const std::string cStatisticsFilePath;
 };
 
 }
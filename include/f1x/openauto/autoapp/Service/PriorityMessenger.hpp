@@ -0,0 +1,90 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <boost/asio.hpp>
+#include <f1x/aasdk/Messenger/IMessenger.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace service
+{
+
+class PriorityMessenger: public aasdk::messenger::IMessenger, public std::enable_shared_from_this<PriorityMessenger>
+{
+public:
+    PriorityMessenger(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger);
+
+    void enqueueReceive(aasdk::messenger::ChannelId channelId, aasdk::messenger::ReceivePromise::Pointer promise) override;
+    void enqueueSend(aasdk::messenger::Message::Pointer message, aasdk::messenger::SendPromise::Pointer promise) override;
+    void stop() override;
+
+private:
+    using std::enable_shared_from_this<PriorityMessenger>::shared_from_this;
+
+    enum class SendClass
+    {
+        CONTROL,
+        SENSOR,
+        MEDIA
+    };
+
+    struct PendingSend
+    {
+        aasdk::messenger::Message::Pointer message;
+        aasdk::messenger::SendPromise::Pointer promise;
+        std::chrono::steady_clock::time_point timestamp;
+    };
+
+    struct SendStatistics
+    {
+        size_t count;
+        int64_t totalDelay;
+        int64_t maxDelay;
+    };
+
+    static SendClass classify(const aasdk::messenger::Message& message);
+    static const char* sendClassToString(size_t sendClass);
+    void sendNext();
+    size_t selectQueue();
+    void logStatistics();
+
+    boost::asio::io_service::strand strand_;
+    aasdk::messenger::IMessenger::Pointer messenger_;
+    std::array<std::deque<PendingSend>, 3> queues_;
+    std::array<SendStatistics, 3> statistics_;
+    size_t consecutiveHighPriority_;
+    bool sendInProgress_;
+    bool stopped_;
+
+    static constexpr size_t cStarvationLimit = 8;
+    static constexpr size_t cStatisticsInterval = 2000;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,65 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <mutex>
+#include <chrono>
+#include <fstream>
+#include <boost/asio.hpp>
+#include <f1x/aasdk/Messenger/IMessenger.hpp>
+#include <f1x/openauto/Common/SessionRecord.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace service
+{
+
+class RecordingMessenger: public aasdk::messenger::IMessenger, public std::enable_shared_from_this<RecordingMessenger>
+{
+public:
+    RecordingMessenger(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger, const std::string& fileName);
+
+    void enqueueReceive(aasdk::messenger::ChannelId channelId, aasdk::messenger::ReceivePromise::Pointer promise) override;
+    void enqueueSend(aasdk::messenger::Message::Pointer message, aasdk::messenger::SendPromise::Pointer promise) override;
+    void stop() override;
+
+private:
+    using std::enable_shared_from_this<RecordingMessenger>::shared_from_this;
+
+    void record(common::SessionRecordDirection direction, const aasdk::messenger::Message& message);
+
+    boost::asio::io_service& ioService_;
+    aasdk::messenger::IMessenger::Pointer messenger_;
+    std::mutex mutex_;
+    std::ofstream file_;
+    common::SessionRecordWriter writer_;
+    std::chrono::steady_clock::time_point startTimestamp_;
+    size_t messagesCount_;
+    size_t bytesCount_;
+    bool recording_;
+};
+
+}
+}
+}
+}
@@ -18,8 +18,12 @@
 
 #pragma once
 
+#include <aasdk_proto/DrivingStatusEnum.pb.h>
 #include <f1x/aasdk/Channel/Sensor/SensorServiceChannel.hpp>
 #include <f1x/openauto/autoapp/Service/IService.hpp>
+#include <f1x/openauto/autoapp/Configuration/IConfiguration.hpp>
+#include <f1x/openauto/autoapp/Projection/IVehicleDataSource.hpp>
+#include <f1x/openauto/autoapp/Projection/IVehicleDataSourceEventHandler.hpp>
 
 namespace f1x
 {
@@ -30,10 +34,10 @@ namespace autoapp
 namespace service
 {
 
-class SensorService: public aasdk::channel::sensor::ISensorServiceChannelEventHandler, public IService, public std::enable_shared_from_this<SensorService>
+class SensorService: public aasdk::channel::sensor::ISensorServiceChannelEventHandler, public IService, public projection::IVehicleDataSourceEventHandler, public std::enable_shared_from_this<SensorService>
 {
 public:
-    SensorService(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger);
+    SensorService(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger, configuration::IConfiguration::Pointer configuration, projection::IVehicleDataSource::Pointer vehicleDataSource);
     bool isNight = false;
     bool previous = false;
     bool stopPolling = false;
@@ -46,18 +50,37 @@ public:
     void onChannelOpenRequest(const aasdk::proto::messages::ChannelOpenRequest& request) override;
     void onSensorStartRequest(const aasdk::proto::messages::SensorStartRequestMessage& request) override;
     void onChannelError(const aasdk::error::Error& e) override;
+    void onVehicleDataUpdate(const projection::VehicleData& data) override;
 
 private:
     using std::enable_shared_from_this<SensorService>::shared_from_this;
-    void sendDrivingStatusUnrestricted();
+    void sendDrivingStatus();
     void sendNightData();
+    void sendVehicleData();
+    void fillVehicleData(aasdk::proto::messages::SensorEventIndication& indication, const projection::VehicleData& data);
+    aasdk::proto::enums::DrivingStatus::Enum deriveDrivingStatus() const;
+    void queueSensorEvent(const aasdk::proto::messages::SensorEventIndication& indication, bool urgent);
+    void onBatchTimeout(const boost::system::error_code& error, size_t generation);
+    void flushSensorEvents();
     bool is_file_exist(const char *filename);
     void nightSensorPolling();
     bool firstRun = true;
 
     boost::asio::deadline_timer timer_;
+    boost::asio::deadline_timer batchTimer_;
     boost::asio::io_service::strand strand_;
     aasdk::channel::sensor::SensorServiceChannel::Pointer channel_;
+    projection::IVehicleDataSource::Pointer vehicleDataSource_;
+    projection::VehicleData vehicleData_;
+    aasdk::proto::enums::DrivingStatus::Enum drivingStatus_;
+    boost::posix_time::milliseconds batchWindow_;
+    bool batchPending_;
+    size_t batchGeneration_;
+    aasdk::proto::messages::SensorEventIndication batchIndication_;
+    size_t updatesCount_;
+    size_t messagesCount_;
+
+    static const int32_t cDrivingSpeedThreshold;
 };
 
 }
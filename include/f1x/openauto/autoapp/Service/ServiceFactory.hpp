@@ -18,8 +18,12 @@
 
 #pragma once
 
+#include <mutex>
 #include <f1x/openauto/autoapp/Service/IServiceFactory.hpp>
 #include <f1x/openauto/autoapp/Configuration/IConfiguration.hpp>
+#include <f1x/openauto/autoapp/Projection/IAudioInput.hpp>
+#include <f1x/openauto/autoapp/Projection/IAudioOutput.hpp>
+#include <f1x/openauto/autoapp/Projection/IVideoOutput.hpp>
 
 namespace f1x
 {
@@ -33,17 +37,43 @@ namespace service
 class ServiceFactory: public IServiceFactory
 {
 public:
-    ServiceFactory(boost::asio::io_service& ioService, configuration::IConfiguration::Pointer configuration);
-    ServiceList create(aasdk::messenger::IMessenger::Pointer messenger) override;
+    ServiceFactory(boost::asio::io_service& ioService,
+                   boost::asio::io_service& mediaIoService,
+                   boost::asio::io_service& housekeepingIoService,
+                   configuration::IConfiguration::Pointer configuration);
+    ~ServiceFactory() override;
+    ServiceList create(aasdk::messenger::IMessenger::Pointer messenger, SessionTimeline::Pointer sessionTimeline) override;
 
 private:
-    IService::Pointer createVideoService(aasdk::messenger::IMessenger::Pointer messenger);
+    void prewarm();
+    projection::IAudioInput::Pointer getAudioInput();
+    projection::IVideoOutput::Pointer getVideoOutput();
+    projection::IAudioOutput::Pointer getAudioOutput(projection::IAudioOutput::Pointer& audioOutput, uint32_t channelCount, uint32_t sampleSize, uint32_t sampleRate);
+    IService::Pointer createVideoService(aasdk::messenger::IMessenger::Pointer messenger, SessionTimeline::Pointer sessionTimeline);
+    IService::Pointer createSensorService(aasdk::messenger::IMessenger::Pointer messenger);
     IService::Pointer createBluetoothService(aasdk::messenger::IMessenger::Pointer messenger);
     IService::Pointer createInputService(aasdk::messenger::IMessenger::Pointer messenger);
     void createAudioServices(ServiceList& serviceList, aasdk::messenger::IMessenger::Pointer messenger);
 
     boost::asio::io_service& ioService_;
+    boost::asio::io_service& mediaIoService_;
+    boost::asio::io_service& housekeepingIoService_;
     configuration::IConfiguration::Pointer configuration_;
+    std::mutex mutex_;
+    projection::IAudioInput::Pointer audioInput_;
+    projection::IVideoOutput::Pointer videoOutput_;
+    projection::IAudioOutput::Pointer mediaAudioOutput_;
+    projection::IAudioOutput::Pointer speechAudioOutput_;
+    projection::IAudioOutput::Pointer systemAudioOutput_;
+    configuration::AudioOutputBackendType audioOutputBackendType_;
+
+    struct PrewarmGuard
+    {
+        std::mutex mutex;
+        ServiceFactory* factory = nullptr;
+    };
+
+    std::shared_ptr<PrewarmGuard> prewarmGuard_;
 };
 
 }
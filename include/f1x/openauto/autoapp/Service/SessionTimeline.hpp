@@ -0,0 +1,66 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace service
+{
+
+class SessionTimeline
+{
+public:
+    typedef std::shared_ptr<SessionTimeline> Pointer;
+
+    SessionTimeline(std::string transportName);
+
+    void mark(const std::string& milestone);
+    void report(size_t historySize);
+    std::chrono::steady_clock::time_point getStartTimestamp() const;
+
+private:
+    typedef std::pair<std::string, std::chrono::steady_clock::time_point> Milestone;
+
+    void appendHistory(const std::string& line, size_t historySize);
+
+    std::mutex mutex_;
+    std::string transportName_;
+    std::time_t startTime_;
+    std::chrono::steady_clock::time_point startTimestamp_;
+    std::vector<Milestone> milestones_;
+    bool reported_;
+
+    static const std::string cHistoryFileName;
+};
+
+}
+}
+}
+}
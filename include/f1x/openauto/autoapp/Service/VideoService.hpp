@@ -23,6 +23,7 @@
 #include <f1x/aasdk/Channel/AV/IVideoServiceChannelEventHandler.hpp>
 #include <f1x/openauto/autoapp/Projection/IVideoOutput.hpp>
 #include <f1x/openauto/autoapp/Service/IService.hpp>
+#include <f1x/openauto/autoapp/Service/SessionTimeline.hpp>
 
 namespace f1x
 {
@@ -38,7 +39,7 @@ class VideoService: public aasdk::channel::av::IVideoServiceChannelEventHandler,
 public:
     typedef std::shared_ptr<VideoService> Pointer;
 
-    VideoService(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger, projection::IVideoOutput::Pointer videoOutput);
+    VideoService(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger, projection::IVideoOutput::Pointer videoOutput, SessionTimeline::Pointer sessionTimeline);
 
     void start() override;
     void stop() override;
@@ -57,11 +58,14 @@ public:
 private:
     using std::enable_shared_from_this<VideoService>::shared_from_this;
     void sendVideoFocusIndication();
+    void onFirstFrame();
 
     boost::asio::io_service::strand strand_;
     aasdk::channel::av::VideoServiceChannel::Pointer channel_;
     projection::IVideoOutput::Pointer videoOutput_;
     int32_t session_;
+    SessionTimeline::Pointer sessionTimeline_;
+    bool firstFrameReceived_;
 };
 
 }
@@ -0,0 +1,103 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <bitset>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <QObject>
+#include <QString>
+#include <QSocketNotifier>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+enum class StateFile
+{
+    ENTITY_EXIT,
+    BLANK_SCREEN,
+    SCREENSAVER,
+    BLACK_SCREEN,
+    ANDROID_DEVICE,
+    BLUETOOTH_PAIRABLE,
+    CONFIG_IN_PROGRESS,
+    DEBUG_IN_PROGRESS,
+    ENABLE_PAIRING,
+    NIGHT_MODE_ENABLED,
+    DASHCAM_IS_RECORDING,
+    EXTERNAL_EXIT,
+    HOTSPOT_ACTIVE,
+    MOBILE_HOTSPOT_DETECTED,
+    TEMP_RECENT_LIST,
+    DAYNIGHT_GPIO,
+    TSL2561,
+    CSMT_UPDATE_AVAILABLE,
+    UDEV_UPDATE_AVAILABLE,
+    OPENAUTO_UPDATE_AVAILABLE,
+    SYSTEM_UPDATE_AVAILABLE,
+    BTDEVICE,
+    MEDIA_PLAYING,
+    DEV_MODE_ENABLED,
+    WIFI_SSID,
+    GATEWAY_WLAN0,
+    COUNT
+};
+
+class StateFileMonitor: public QObject
+{
+    Q_OBJECT
+
+public:
+    StateFileMonitor(QObject* parent = nullptr);
+    ~StateFileMonitor() override;
+
+    bool start();
+    bool exists(StateFile file) const;
+    static std::string getPath(StateFile file);
+    static QString readContent(StateFile file);
+
+signals:
+    void stateFileChanged(f1x::openauto::autoapp::StateFile file, bool exists);
+
+private slots:
+    void onInotifyEvent();
+
+private:
+    void refresh();
+
+    std::bitset<static_cast<size_t>(StateFile::COUNT)> state_;
+    std::bitset<static_cast<size_t>(StateFile::COUNT)> contentTracked_;
+    std::unordered_map<std::string, StateFile> names_;
+    int inotifyFd_;
+    std::unique_ptr<QSocketNotifier> notifier_;
+
+    static const std::string cDirectory;
+    static const char* cFileNames[];
+};
+
+}
+}
+}
+
+Q_DECLARE_METATYPE(f1x::openauto::autoapp::StateFile)
@@ -0,0 +1,77 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <QObject>
+#include <QString>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+struct SystemInfo
+{
+    unsigned long freeMemory;
+    int cpuFrequency;
+    int cpuTemperature;
+    QString disconnectTimer;
+    QString shutdownTimer;
+};
+
+class SystemInfoProvider: public QObject
+{
+    Q_OBJECT
+
+public:
+    SystemInfoProvider(QObject* parent = nullptr);
+    ~SystemInfoProvider() override;
+
+    void refresh();
+
+signals:
+    void systemInfoUpdated(const f1x::openauto::autoapp::SystemInfo& info);
+
+private:
+    void run();
+    SystemInfo collect() const;
+    QString getTimerLeft(const QString& pattern) const;
+    static long readValue(const char* path);
+    static QString formatTimespan(unsigned long long usec);
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool refreshRequested_;
+    bool stopping_;
+    std::thread thread_;
+
+    static const char* const cCpuFrequencyPath;
+    static const char* const cCpuTemperaturePath;
+};
+
+}
+}
+}
+
+Q_DECLARE_METATYPE(f1x::openauto::autoapp::SystemInfo)
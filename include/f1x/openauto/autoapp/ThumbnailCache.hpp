@@ -0,0 +1,84 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <QCache>
+#include <QImage>
+#include <QObject>
+#include <QPixmap>
+#include <QSet>
+#include <QStringList>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+class ThumbnailCache: public QObject
+{
+    Q_OBJECT
+
+public:
+    ThumbnailCache(QObject* parent = nullptr);
+    ~ThumbnailCache() override;
+
+    bool find(const QString& key, QPixmap& pixmap) const;
+    void request(const QString& key, const QStringList& candidates, bool urgent = false);
+    void clear();
+    static const QPixmap& getPlaceholder();
+
+signals:
+    void thumbnailReady(const QString& key, const QPixmap& pixmap);
+    void thumbnailDecoded(const QString& key, const QImage& image);
+
+private slots:
+    void onThumbnailDecoded(const QString& key, const QImage& image);
+
+private:
+    struct Job
+    {
+        QString key;
+        QStringList candidates;
+    };
+
+    void run();
+    QImage load(const QStringList& candidates) const;
+
+    QCache<QString, QPixmap> memory_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<Job> jobs_;
+    QSet<QString> pending_;
+    bool stopping_;
+    std::thread thread_;
+
+    static const QString cDiskCacheDirectory;
+    static const int cThumbnailSize;
+    static const int cMemoryCacheSize;
+};
+
+}
+}
+}
@@ -0,0 +1,63 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QStringList>
+#include <f1x/openauto/autoapp/ThumbnailCache.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace ui
+{
+
+class AlbumListModel: public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    AlbumListModel(ThumbnailCache* thumbnailCache, QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    void setAlbums(const QString& rootPath, const QStringList& albums);
+    const QStringList& getAlbums() const;
+    QString getCoverKey(const QString& album) const;
+    QStringList getCovers(const QString& album) const;
+
+private slots:
+    void onThumbnailReady(const QString& key);
+
+private:
+    ThumbnailCache* thumbnailCache_;
+    QString rootPath_;
+    QStringList albums_;
+    QHash<QString, int> rows_;
+};
+
+}
+}
+}
+}
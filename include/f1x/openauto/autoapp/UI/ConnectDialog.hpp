@@ -1,10 +1,15 @@
 #pragma once
 
+#include <mutex>
 #include <QDialog>
 #include <QStringListModel>
 #include <f1x/aasdk/TCP/ITCPEndpoint.hpp>
 #include <f1x/aasdk/TCP/ITCPWrapper.hpp>
 #include <f1x/openauto/autoapp/Configuration/IRecentAddressesList.hpp>
+#include <f1x/openauto/autoapp/ParallelConnector.hpp>
+#include <f1x/openauto/autoapp/HelperClient.hpp>
+#include <f1x/openauto/autoapp/NetworkMonitor.hpp>
+#include <f1x/openauto/Common/TCPTuning.hpp>
 
 namespace Ui {
 class ConnectDialog;
@@ -24,7 +29,7 @@ class ConnectDialog : public QDialog
     Q_OBJECT
 
 public:
-    explicit ConnectDialog(boost::asio::io_service& ioService,  aasdk::tcp::ITCPWrapper& tcpWrapper, openauto::autoapp::configuration::IRecentAddressesList& recentAddressesList, QWidget *parent = nullptr);
+    explicit ConnectDialog(boost::asio::io_service& ioService,  aasdk::tcp::ITCPWrapper& tcpWrapper, openauto::autoapp::configuration::IRecentAddressesList& recentAddressesList, HelperClient& helperClient, NetworkMonitor& networkMonitor, common::TCPTuning tcpTuning, QWidget *parent = nullptr);
     ~ConnectDialog() override;
     void autoconnect();
     void loadClientList();
@@ -33,6 +38,7 @@ signals:
     void connectToDevice(const QString& ipAddress);
     void connectionSucceed(aasdk::tcp::ITCPEndpoint::SocketPointer socket, const std::string& ipAddress);
     void connectionFailed(const QString& message);
+    void clientListUpdated();
 
 private slots:
     void onConnectButtonClicked();
@@ -40,18 +46,33 @@ private slots:
     void onConnectionSucceed(aasdk::tcp::ITCPEndpoint::SocketPointer socket, const std::string& ipAddress);
     void onRecentAddressClicked(const QModelIndex& index);
     void onUpdateButtonClicked();
+    void onHotspotClientAppeared(const QString& address);
 
 private:
     void insertIpAddress(const std::string& ipAddress);
     void loadRecentList();
     void setControlsEnabledStatus(bool status);
+    void connectToCandidates(const std::vector<std::string>& candidates);
     void connectHandler(const boost::system::error_code& ec, const std::string& ipAddress, aasdk::tcp::ITCPEndpoint::SocketPointer socket);
 
     boost::asio::io_service& ioService_;
     aasdk::tcp::ITCPWrapper& tcpWrapper_;
     openauto::autoapp::configuration::IRecentAddressesList& recentAddressesList_;
+    HelperClient& helperClient_;
+    NetworkMonitor& networkMonitor_;
+    common::TCPTuning tcpTuning_;
     Ui::ConnectDialog *ui_;
     QStringListModel recentAddressesModel_;
+    ParallelConnector::Pointer connector_;
+    std::vector<std::string> candidates_;
+
+    struct HandlerGuard
+    {
+        std::mutex mutex;
+        ConnectDialog* dialog = nullptr;
+    };
+
+    std::shared_ptr<HandlerGuard> handlerGuard_;
 };
 
 }
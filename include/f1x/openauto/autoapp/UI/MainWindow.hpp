@@ -21,7 +21,17 @@
 #include <memory>
 #include <QMainWindow>
 #include <QFile>
+#include <QTimer>
 #include <f1x/openauto/autoapp/Configuration/IConfiguration.hpp>
+#include <f1x/openauto/autoapp/BacklightController.hpp>
+#include <f1x/openauto/autoapp/HelperClient.hpp>
+#include <f1x/openauto/autoapp/VolumeController.hpp>
+#include <f1x/openauto/autoapp/MusicLibrary.hpp>
+#include <f1x/openauto/autoapp/NetworkMonitor.hpp>
+#include <f1x/openauto/autoapp/StateFileMonitor.hpp>
+#include <f1x/openauto/autoapp/ThumbnailCache.hpp>
+#include <f1x/openauto/autoapp/UI/AlbumListModel.hpp>
+#include <f1x/openauto/autoapp/UI/TrackListModel.hpp>
 
 #include <QMediaPlayer>
 #include <QListWidgetItem>
@@ -38,13 +48,12 @@
 #include <QFileDialog>
 
 #include <qmediaplayer.h>
-#include <taglib/fileref.h>
-#include <taglib/tag.h>
 
 #include <QFileSystemWatcher>
 #include <QKeyEvent>
 
 #include <QBluetoothLocalDevice>
+#include <QSet>
 //#include <QtBluetooth>
 
 namespace Ui
@@ -65,11 +74,10 @@ class MainWindow : public QMainWindow
 {
     Q_OBJECT
 public:
-    explicit MainWindow(configuration::IConfiguration::Pointer configuration, QWidget *parent = nullptr);
+    explicit MainWindow(configuration::IConfiguration::Pointer configuration, HelperClient& helperClient, VolumeController& volumeController, NetworkMonitor& networkMonitor, QWidget *parent = nullptr);
     ~MainWindow() override;
     QMediaPlayer* player;
     QFileSystemWatcher* watcher;
-    QFileSystemWatcher* watcher_tmp;
 
 signals:
     void exit();
@@ -140,7 +148,7 @@ private slots:
     void on_pushButtonPlayerPause_clicked();
     void on_positionChanged(qint64 position);
     void on_durationChanged(qint64 position);
-    void on_mp3List_itemClicked(QListWidgetItem *item);
+    void on_mp3List_clicked(const QModelIndex &index);
     void metaDataChanged();
     void on_pushButtonPlayerPlayList_clicked();
     void on_pushButtonPlayerNextBig_clicked();
@@ -149,19 +157,29 @@ private slots:
     void on_pushButtonPlayerNextAlbum_clicked();
     void on_pushButtonBackToPlayer_clicked();
     void on_comboBoxAlbum_currentIndexChanged(const QString &arg1);
-    void on_mp3List_currentRowChanged(int currentRow);
+    void onTrackSelected(const QModelIndex& current);
     void on_StateChanged(QMediaPlayer::State state);
     void scanFolders();
     void scanFiles();
+    void updateAlbums(const QStringList& albums);
+    void onAlbumChanged(const QString& album);
+    void onLibraryScanFinished();
+    void onThumbnailReady(const QString& key, const QPixmap& pixmap);
     void tmpChanged();
+    void onStateFileChanged(f1x::openauto::autoapp::StateFile file, bool exists);
+    void onPlaybackVolumeChanged(int value);
+    void onBrightnessChanged(int value);
+    void saveVolume();
     void setTrigger();
     void setRetryUSBConnect();
     void resetRetryUSBMessage();
-    void updateNetworkInfo();
+    void onNetworkSnapshotChanged(const f1x::openauto::autoapp::NetworkSnapshot& snapshot);
     bool check_file_exist(const char *filename);
     void KeyPress(QString key);
 
     void hostModeStateChanged(QBluetoothLocalDevice::HostMode);
+    void onBluetoothDeviceConnected(const QBluetoothAddress& address);
+    void onBluetoothDeviceDisconnected(const QBluetoothAddress& address);
 
     //void on_AlbumCoverListView_clicked(const QModelIndex &index);
     void on_AlbumCoverListView_clicked(const QModelIndex &index);
@@ -169,14 +187,44 @@ private slots:
     void on_pushButtonAlbum_clicked();
 
 private:
+    void handleEntityExit();
+    void updateBlankScreen();
+    void updateScreensaver();
+    void updateBlackScreen();
+    void updateAndroidDevice();
+    void updateBluetoothPairable();
+    void updateProgressInfo();
+    void updateDayNightState();
+    void updateDashCamState();
+    void checkExternalExit();
+    void updateWifiButtons();
+    void updateMenuSettings();
+    void updateLux();
+    void updateLuxBrightness(int lux);
+    void rampBrightness(const QString& key);
+    void updateUpdateNotify();
+    void updateLockLabel();
+    void updateBluetoothDevice();
+    void showCover(const QString& key, const QStringList& candidates);
+    void restorePlayback();
+    QMediaContent getMediaContent(const MusicTrack& track) const;
+
     Ui::MainWindow* ui_;
     configuration::IConfiguration::Pointer configuration_;
+    HelperClient& helperClient_;
+    VolumeController& volumeController_;
+    NetworkMonitor& networkMonitor_;
+    QTimer* volumeSaveTimer_ = nullptr;
+    StateFileMonitor* stateFileMonitor_ = nullptr;
+    MusicLibrary* musicLibrary_ = nullptr;
+    ThumbnailCache* thumbnailCache_ = nullptr;
+    AlbumListModel* albumModel_ = nullptr;
+    TrackListModel* trackModel_ = nullptr;
 
     QString brightnessFilename = "/sys/class/backlight/rpi_backlight/brightness";
     QString brightnessFilenameAlt = "/tmp/custombrightness";
-    QFile *brightnessFile;
-    QFile *brightnessFileAlt;
-    char brightness_str[6];
+    BacklightController* backlightController_ = nullptr;
+    int luxBrightness = -1;
     char volume_str[6];
     int alpha_current_str;
     QString bversion;
@@ -244,6 +292,11 @@ private:
     bool systemDebugmode = false;
 
     bool bluetoothEnabled = false;
+    QSet<quint64> bluetoothDevices;
+    QString bluetoothDeviceName;
+    qint64 clockTickTotal = 0;
+    qint64 clockTickMax = 0;
+    int clockTicks = 0;
 
     bool toggleMute = false;
     bool oldGUIStyle = false;
@@ -261,6 +314,8 @@ private:
     int currentPlaylistIndex = 0;
     bool background_set = false;
     bool mediacontentchanged = true;
+    bool restorePending = false;
+    QString currentCoverKey;
 
     bool lightsensor = false;
     bool holidaybg = false;
@@ -275,6 +330,9 @@ private:
 
     QBluetoothLocalDevice *localDevice;
 
+    static const std::chrono::milliseconds cDayNightRampDuration;
+    static const std::chrono::milliseconds cLuxRampDuration;
+
 protected:
     void keyPressEvent(QKeyEvent *event) override
     {
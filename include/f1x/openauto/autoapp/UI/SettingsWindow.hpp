@@ -21,8 +21,11 @@
 #include <memory>
 #include <QWidget>
 #include <f1x/openauto/autoapp/Configuration/IConfiguration.hpp>
+#include <f1x/openauto/autoapp/HelperClient.hpp>
+#include <f1x/openauto/autoapp/NetworkMonitor.hpp>
+#include <f1x/openauto/autoapp/SystemInfoProvider.hpp>
+#include <f1x/openauto/autoapp/VolumeController.hpp>
 #include <QFileDialog>
-#include <sys/sysinfo.h>
 
 class QCheckBox;
 class QTimer;
@@ -45,7 +48,7 @@ class SettingsWindow : public QWidget
 {
     Q_OBJECT
 public:
-    explicit SettingsWindow(configuration::IConfiguration::Pointer configuration, QWidget *parent = nullptr);
+    explicit SettingsWindow(configuration::IConfiguration::Pointer configuration, HelperClient& helperClient, VolumeController& volumeController, NetworkMonitor& networkMonitor, QWidget *parent = nullptr);
     ~SettingsWindow() override;
     void loadSystemValues();
 
@@ -59,12 +62,16 @@ private slots:
     void onUpdateBrightnessNight(int value);
     void onUpdateSystemVolume(int value);
     void onUpdateSystemCapture(int value);
+    void onPlaybackVolumeChanged(int value);
+    void onCaptureVolumeChanged(int value);
     void setTime();
     void onStartHotspot();
     void onStopHotspot();
     void syncNTPTime();
     void on_pushButtonAudioTest_clicked();
+    void onAudioTestFinished();
     void updateNetworkInfo();
+    void onNetworkSnapshotChanged(const f1x::openauto::autoapp::NetworkSnapshot& snapshot);
     void onUpdateLux1(int value);
     void onUpdateLux2(int value);
     void onUpdateLux3(int value);
@@ -78,6 +85,7 @@ private slots:
     void on_pushButtonNetwork0_clicked();
     void on_pushButtonNetwork1_clicked();
     void updateSystemInfo();
+    void onSystemInfoUpdated(const f1x::openauto::autoapp::SystemInfo& info);
     void updateInfo();
 
 public slots:
@@ -101,6 +109,10 @@ private:
 
     Ui::SettingsWindow* ui_;
     configuration::IConfiguration::Pointer configuration_;
+    HelperClient& helperClient_;
+    VolumeController& volumeController_;
+    NetworkMonitor& networkMonitor_;
+    SystemInfoProvider* systemInfoProvider_;
 };
 
 }
@@ -6,6 +6,7 @@
 #include <QStringList>
 #include <QTimer>
 #include <QFileInfo>
+#include <f1x/openauto/autoapp/HelperClient.hpp>
 
 namespace Ui {
 class UpdateDialog;
@@ -25,7 +26,7 @@ class UpdateDialog : public QDialog
     Q_OBJECT
 
 public:
-    explicit UpdateDialog(QWidget *parent = nullptr);
+    explicit UpdateDialog(HelperClient& helperClient, QWidget *parent = nullptr);
     ~UpdateDialog() override;
 
     void updateCheck();
@@ -39,9 +40,11 @@ private slots:
     void on_pushButtonUpdateSystem_clicked();
     void on_pushButtonUpdateCheck_clicked();
     void on_pushButtonUpdateCancel_clicked();
+    void onUpdateCheckFinished();
 
 private:
     Ui::UpdateDialog *ui_;
+    HelperClient& helperClient_;
     QFileSystemWatcher* watcher_tmp;
     QFileSystemWatcher* watcher_download;
 };
@@ -0,0 +1,54 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <libusb.h>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+class USBEventLoop
+{
+public:
+    USBEventLoop(libusb_context* usbContext);
+
+    void start();
+    void stop();
+    bool join(std::chrono::steady_clock::time_point deadline);
+
+private:
+    void run(std::promise<void> finished);
+
+    libusb_context* usbContext_;
+    std::atomic<bool> stopped_;
+    std::thread thread_;
+    std::future<void> finished_;
+};
+
+}
+}
+}
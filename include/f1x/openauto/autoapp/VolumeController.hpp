@@ -0,0 +1,85 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <QObject>
+
+typedef struct _snd_mixer snd_mixer_t;
+typedef struct _snd_mixer_elem snd_mixer_elem_t;
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+class VolumeController: public QObject
+{
+    Q_OBJECT
+
+public:
+    VolumeController(QObject* parent = nullptr);
+    ~VolumeController() override;
+
+    bool start();
+    void stop();
+    bool isAvailable() const;
+    int getPlaybackVolume() const;
+    int getCaptureVolume() const;
+    void setPlaybackVolume(int percent);
+    void setCaptureVolume(int percent);
+
+signals:
+    void playbackVolumeChanged(int percent);
+    void captureVolumeChanged(int percent);
+
+private:
+    void run();
+    void wake();
+    void apply();
+    void readVolumes();
+    snd_mixer_elem_t* findElement(const char* const names[], bool playback) const;
+    static long toRaw(snd_mixer_elem_t* element, bool playback, int percent);
+    static int toPercent(snd_mixer_elem_t* element, bool playback, long raw);
+
+    snd_mixer_t* mixer_;
+    snd_mixer_elem_t* playbackElement_;
+    snd_mixer_elem_t* captureElement_;
+    int eventFd_;
+    std::atomic<int> pendingPlayback_;
+    std::atomic<int> pendingCapture_;
+    std::atomic<int> playbackVolume_;
+    std::atomic<int> captureVolume_;
+    std::atomic<size_t> coalescedUpdates_;
+    std::atomic<bool> stopping_;
+    long playbackRaw_;
+    long captureRaw_;
+    std::thread thread_;
+
+    static const char* const cCardName;
+    static const char* const cPlaybackElements[];
+    static const char* const cCaptureElements[];
+};
+
+}
+}
+}
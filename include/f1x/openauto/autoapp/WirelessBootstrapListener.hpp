@@ -0,0 +1,70 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <memory>
+#include <boost/asio.hpp>
+#include <QList>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QPointer>
+#include <f1x/aasdk/TCP/ITCPEndpoint.hpp>
+#include <f1x/openauto/Common/TCPTuning.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+class WirelessBootstrapListener: public QObject
+{
+    Q_OBJECT
+
+public:
+    WirelessBootstrapListener(boost::asio::io_service& ioService, common::TCPTuning tcpTuning, QObject* parent = nullptr);
+
+    bool start(const QString& serverName);
+    void stop();
+
+signals:
+    void connectionAccepted(aasdk::tcp::ITCPEndpoint::SocketPointer socket);
+    void listenFinished(bool success);
+
+private slots:
+    void onClientConnected();
+    void onListenFinished(bool success);
+
+private:
+    void handleMessage(QLocalSocket* socket, const QString& message);
+    void listen(uint16_t port);
+    void onAccepted(const boost::system::error_code& error, aasdk::tcp::ITCPEndpoint::SocketPointer socket);
+
+    boost::asio::io_service& ioService_;
+    boost::asio::io_service::strand strand_;
+    boost::asio::ip::tcp::acceptor acceptor_;
+    common::TCPTuning tcpTuning_;
+    std::unique_ptr<QLocalServer> localServer_;
+    QList<QPointer<QLocalSocket>> pendingReplies_;
+};
+
+}
+}
+}
@@ -20,8 +20,10 @@
 
 #include <stdint.h>
 #include <memory>
+#include <string>
 #include <QBluetoothServer>
 #include <f1x/openauto/btservice/IAndroidBluetoothServer.hpp>
+#include <f1x/openauto/btservice/IAutoappNotifier.hpp>
 
 namespace f1x
 {
@@ -35,7 +37,7 @@ class AndroidBluetoothServer: public QObject, public IAndroidBluetoothServer
     Q_OBJECT
 
 public:
-    AndroidBluetoothServer();
+    AndroidBluetoothServer(IAutoappNotifier& notifier, std::string hostapdConfigFile, QString interfaceName, uint16_t wirelessPort);
 
     bool start(const QBluetoothAddress& address, uint16_t portNumber) override;
 
@@ -44,6 +46,10 @@ private slots:
 
 private:
     std::unique_ptr<QBluetoothServer> rfcommServer_;
+    IAutoappNotifier& notifier_;
+    std::string hostapdConfigFile_;
+    QString interfaceName_;
+    uint16_t wirelessPort_;
 };
 
 }
@@ -0,0 +1,95 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <chrono>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include <QByteArray>
+#include <QIODevice>
+#include <QTimer>
+#include <f1x/openauto/btservice/IAutoappNotifier.hpp>
+#include <f1x/openauto/btservice/WirelessCredentials.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace btservice
+{
+
+enum class WirelessMessageId: uint16_t
+{
+    START_REQUEST = 1,
+    INFO_REQUEST = 2,
+    INFO_RESPONSE = 3,
+    CONNECTION_STATUS = 6,
+    START_RESPONSE = 7
+};
+
+class WirelessBootstrap: public QObject
+{
+    Q_OBJECT
+
+public:
+    WirelessBootstrap(QIODevice* device, WirelessCredentials credentials, IAutoappNotifier& notifier, QObject* parent = nullptr);
+
+    void start();
+
+signals:
+    void finished(bool success);
+
+private slots:
+    void onReadyRead();
+    void onTimeout();
+
+private:
+    typedef std::chrono::steady_clock Clock;
+    typedef std::map<uint32_t, uint64_t> VarintFields;
+
+    void sendMessage(WirelessMessageId messageId, const QByteArray& payload);
+    void handleMessage(uint16_t messageId, const QByteArray& payload);
+    void mark(const std::string& step);
+    void finish(bool success, const std::string& reason);
+
+    static void appendVarint(QByteArray& buffer, uint64_t value);
+    static void appendVarintField(QByteArray& buffer, uint32_t field, uint64_t value);
+    static void appendStringField(QByteArray& buffer, uint32_t field, const std::string& value);
+    static bool readVarintFields(const QByteArray& payload, VarintFields& fields);
+
+    QIODevice* device_;
+    WirelessCredentials credentials_;
+    IAutoappNotifier& notifier_;
+    QByteArray buffer_;
+    QTimer timeoutTimer_;
+    Clock::time_point startTimestamp_;
+    std::vector<std::pair<std::string, Clock::time_point>> steps_;
+    bool finished_;
+
+    static const int cTimeoutMs;
+    static const uint64_t cSecurityModeWpa2Personal;
+    static const uint64_t cAccessPointTypeStatic;
+};
+
+}
+}
+}
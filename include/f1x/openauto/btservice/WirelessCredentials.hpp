@@ -0,0 +1,45 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <QString>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace btservice
+{
+
+struct WirelessCredentials
+{
+    std::string ssid;
+    std::string key;
+    std::string bssid;
+    std::string ipAddress;
+    uint16_t port;
+
+    static bool read(const std::string& hostapdConfigFile, const QString& interfaceName, uint16_t port, WirelessCredentials& credentials);
+};
+
+}
+}
+}
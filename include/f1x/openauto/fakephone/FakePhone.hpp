@@ -0,0 +1,99 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <map>
+#include <deque>
+#include <chrono>
+#include <string>
+#include <openssl/ssl.h>
+#include <f1x/openauto/Common/SessionRecord.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace fakephone
+{
+
+class FakePhone
+{
+public:
+    typedef std::vector<common::SessionRecordEntry> Entries;
+
+    FakePhone(const std::string& certificateFile, const std::string& privateKeyFile);
+    ~FakePhone();
+
+    bool listen(uint16_t port);
+    bool accept();
+    bool handshake();
+    void replay(const Entries& entries, double speed);
+    void close();
+
+private:
+    struct Message
+    {
+        uint8_t channelId;
+        bool encrypted;
+        bool control;
+        std::vector<uint8_t> payload;
+    };
+
+    typedef std::chrono::steady_clock Clock;
+
+    bool initSSL();
+    bool sendMessage(uint8_t channelId, bool encrypted, bool control, const std::vector<uint8_t>& payload);
+    bool sendHandshakeData();
+    bool receiveMessage(Message& message);
+    bool handleMessage(const Message& message);
+    bool processIncoming(Clock::time_point deadline);
+    bool encrypt(const uint8_t* data, size_t size, std::vector<uint8_t>& output);
+    bool decrypt(const std::vector<uint8_t>& data, std::vector<uint8_t>& output);
+    bool writeAll(const uint8_t* data, size_t size);
+    bool readAll(uint8_t* data, size_t size);
+    bool isReplayed(const common::SessionRecordEntry& entry) const;
+    void report(Clock::duration elapsed) const;
+
+    static uint16_t getMessageId(const std::vector<uint8_t>& payload);
+    static std::vector<uint8_t> createPayload(uint16_t messageId, const uint8_t* data, size_t size);
+
+    std::string certificateFile_;
+    std::string privateKeyFile_;
+    int listenSocket_;
+    int socket_;
+    SSL_CTX* context_;
+    SSL* ssl_;
+    BIO* readBio_;
+    BIO* writeBio_;
+
+    std::map<uint8_t, std::deque<Clock::time_point>> pendingAcks_;
+    size_t messagesSent_;
+    size_t bytesSent_;
+    size_t messagesReceived_;
+    size_t acksReceived_;
+    size_t pingsAnswered_;
+    Clock::duration ackLatencyTotal_;
+    Clock::duration ackLatencyMax_;
+
+    static const size_t cMaxFramePayloadSize;
+};
+
+}
+}
+}
@@ -0,0 +1,43 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <f1x/openauto/Common/SessionRecord.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace fakephone
+{
+
+class SyntheticSession
+{
+public:
+    typedef std::vector<common::SessionRecordEntry> Entries;
+
+    static Entries create(size_t fps, size_t frameSize, size_t duration);
+
+private:
+    static void append(Entries& entries, uint64_t timestamp, uint8_t channelId, bool control, uint16_t messageId, const std::string& message);
+};
+
+}
+}
+}
@@ -0,0 +1,85 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <sys/types.h>
+#include <boost/asio.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace helperd
+{
+
+class HelperServer
+{
+public:
+    HelperServer(boost::asio::io_service& ioService, std::string socketPath);
+
+    bool start();
+    void stop();
+
+private:
+    class Session: public std::enable_shared_from_this<Session>
+    {
+    public:
+        Session(HelperServer& server, boost::asio::io_service& ioService);
+
+        boost::asio::local::stream_protocol::socket& getSocket();
+        void start();
+        void send(uint32_t id, int status);
+        void close();
+
+    private:
+        void read();
+        void write();
+
+        HelperServer& server_;
+        boost::asio::local::stream_protocol::socket socket_;
+        boost::asio::streambuf buffer_;
+        std::deque<std::string> writeQueue_;
+    };
+
+    struct Child
+    {
+        std::weak_ptr<Session> session;
+        uint32_t id;
+        std::string command;
+    };
+
+    void accept();
+    void waitChildren();
+    void execute(std::shared_ptr<Session> session, uint32_t id, const std::string& command);
+
+    boost::asio::io_service& ioService_;
+    std::string socketPath_;
+    boost::asio::local::stream_protocol::acceptor acceptor_;
+    boost::asio::signal_set childSignal_;
+    std::map<pid_t, Child> children_;
+    size_t sessions_;
+};
+
+}
+}
+}
@@ -30,7 +30,7 @@ namespace autoapp
 {
 
 App::App(boost::asio::io_service& ioService, aasdk::usb::USBWrapper& usbWrapper, aasdk::tcp::ITCPWrapper& tcpWrapper, service::IAndroidAutoEntityFactory& androidAutoEntityFactory,
-         aasdk::usb::IUSBHub::Pointer usbHub, aasdk::usb::IConnectedAccessoriesEnumerator::Pointer connectedAccessoriesEnumerator)
+         aasdk::usb::IUSBHub::Pointer usbHub, aasdk::usb::IConnectedAccessoriesEnumerator::Pointer connectedAccessoriesEnumerator, configuration::IConfiguration::Pointer configuration)
     : ioService_(ioService)
     , usbWrapper_(usbWrapper)
     , tcpWrapper_(tcpWrapper)
@@ -38,6 +38,7 @@ App::App(boost::asio::io_service& ioService, aasdk::usb::USBWrapper& usbWrapper,
     , androidAutoEntityFactory_(androidAutoEntityFactory)
     , usbHub_(std::move(usbHub))
     , connectedAccessoriesEnumerator_(std::move(connectedAccessoriesEnumerator))
+    , configuration_(std::move(configuration))
     , isStopped_(false)
 {
 
@@ -68,7 +69,8 @@ void App::waitForUSBDevice()
 
 void App::start(aasdk::tcp::ITCPEndpoint::SocketPointer socket)
 {
-    strand_.dispatch([this, self = this->shared_from_this(), socket = std::move(socket)]() mutable {
+    auto sessionTimeline(std::make_shared<service::SessionTimeline>("tcp"));
+    strand_.dispatch([this, self = this->shared_from_this(), socket = std::move(socket), sessionTimeline = std::move(sessionTimeline)]() mutable {
         if(androidAutoEntity_ != nullptr)
         {
             tcpWrapper_.close(*socket);
@@ -81,8 +83,9 @@ void App::start(aasdk::tcp::ITCPEndpoint::SocketPointer socket)
             usbHub_->cancel();
             connectedAccessoriesEnumerator_->cancel();
 
+            this->tuneSocket(*socket);
             auto tcpEndpoint(std::make_shared<aasdk::tcp::TCPEndpoint>(tcpWrapper_, std::move(socket)));
-            androidAutoEntity_ = androidAutoEntityFactory_.create(std::move(tcpEndpoint));
+            androidAutoEntity_ = androidAutoEntityFactory_.create(std::move(tcpEndpoint), std::move(sessionTimeline));
             androidAutoEntity_->start(*this);
         }
         catch(const aasdk::error::Error& error)
@@ -129,6 +132,7 @@ void App::stop()
 
 void App::aoapDeviceHandler(aasdk::usb::DeviceHandle deviceHandle)
 {
+    auto sessionTimeline(std::make_shared<service::SessionTimeline>("usb"));
     OPENAUTO_LOG(info) << "[App] Device connected.";
 
     if(androidAutoEntity_ != nullptr)
@@ -145,7 +149,8 @@ void App::aoapDeviceHandler(aasdk::usb::DeviceHandle deviceHandle)
             connectedAccessoriesEnumerator_->cancel();
 
             auto aoapDevice(aasdk::usb::AOAPDevice::create(usbWrapper_, ioService_, deviceHandle));
-            androidAutoEntity_ = androidAutoEntityFactory_.create(std::move(aoapDevice));
+            sessionTimeline->mark("aoap device");
+            androidAutoEntity_ = androidAutoEntityFactory_.create(std::move(aoapDevice), std::move(sessionTimeline));
             androidAutoEntity_->start(*this);
         } else {
             OPENAUTO_LOG(info) << "[App] Start Android Auto not allowed - skip.";
@@ -247,6 +252,19 @@ void App::onUSBHubError(const aasdk::error::Error& error)
     }
 }
 
+void App::tuneSocket(boost::asio::ip::tcp::socket& socket)
+{
+    const auto tuning = configuration_->getTCPTuning();
+    const auto failures = common::TCPTuner::apply(socket.native_handle(), tuning);
+
+    OPENAUTO_LOG(info) << "[App] tcp tuning applied, " << common::TCPTuner::describe(tuning);
+
+    for(const auto& failure : failures)
+    {
+        OPENAUTO_LOG(warning) << "[App] failed to set " << failure << ".";
+    }
+}
+
 }
 }
 }
@@ -0,0 +1,254 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <f1x/openauto/autoapp/BacklightController.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+const std::chrono::milliseconds BacklightController::cFrameInterval(16);
+
+BacklightController::BacklightController(QObject* parent)
+    : QObject(parent)
+    , fd_(-1)
+    , regularFile_(false)
+    , target_(-1)
+    , rampFrom_(-1)
+    , rampDuration_(0)
+    , refreshRequested_(false)
+    , stopping_(false)
+    , coalescedWrites_(0)
+    , brightness_(-1)
+{
+
+}
+
+BacklightController::~BacklightController()
+{
+    this->stop();
+}
+
+bool BacklightController::start(const std::string& path)
+{
+    path_ = path;
+    fd_ = open(path_.c_str(), O_RDWR | O_CLOEXEC);
+    if(fd_ < 0)
+    {
+        OPENAUTO_LOG(error) << "[BacklightController] Cannot open " << path_ << ", errno: " << errno;
+        return false;
+    }
+
+    struct stat fileStat;
+    regularFile_ = fstat(fd_, &fileStat) == 0 && S_ISREG(fileStat.st_mode);
+
+    int value = 0;
+    if(this->readBrightness(value))
+    {
+        brightness_ = value;
+    }
+
+    OPENAUTO_LOG(info) << "[BacklightController] Using " << path_ << ", brightness: " << brightness_ << ".";
+    thread_ = std::thread(&BacklightController::run, this);
+    return true;
+}
+
+void BacklightController::stop()
+{
+    if(thread_.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+
+        condition_.notify_all();
+        thread_.join();
+        OPENAUTO_LOG(info) << "[BacklightController] Stopped, coalesced writes: " << coalescedWrites_ << ".";
+    }
+
+    if(fd_ >= 0)
+    {
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool BacklightController::isAvailable() const
+{
+    return fd_ >= 0;
+}
+
+int BacklightController::getBrightness() const
+{
+    return brightness_;
+}
+
+void BacklightController::setBrightness(int value)
+{
+    this->rampTo(value, std::chrono::milliseconds(0));
+}
+
+void BacklightController::rampTo(int value, std::chrono::milliseconds duration)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(target_ >= 0)
+        {
+            ++coalescedWrites_;
+        }
+
+        target_ = std::max(0, value);
+        rampFrom_ = -1;
+        rampStart_ = std::chrono::steady_clock::now();
+        rampDuration_ = duration;
+    }
+
+    condition_.notify_all();
+}
+
+void BacklightController::refresh()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        refreshRequested_ = true;
+    }
+
+    condition_.notify_all();
+}
+
+void BacklightController::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto nextFrame = std::chrono::steady_clock::now();
+
+    while(true)
+    {
+        condition_.wait(lock, [this]() { return stopping_ || target_ >= 0 || refreshRequested_; });
+        if(stopping_)
+        {
+            break;
+        }
+
+        if(refreshRequested_ && target_ < 0)
+        {
+            refreshRequested_ = false;
+            lock.unlock();
+
+            int value = 0;
+            if(this->readBrightness(value) && brightness_.exchange(value) != value)
+            {
+                emit brightnessChanged(value);
+            }
+
+            lock.lock();
+            continue;
+        }
+
+        if(condition_.wait_until(lock, nextFrame, [this]() { return stopping_; }))
+        {
+            break;
+        }
+
+        if(rampFrom_ < 0)
+        {
+            int value = brightness_;
+            rampFrom_ = rampDuration_.count() > 0 && this->readBrightness(value) ? value : std::max(0, value);
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - rampStart_);
+        const bool finished = elapsed >= rampDuration_;
+        int value = target_;
+        if(finished)
+        {
+            target_ = -1;
+            refreshRequested_ = false;
+        }
+        else
+        {
+            value = rampFrom_ + static_cast<int>((target_ - rampFrom_) * elapsed.count() / rampDuration_.count());
+        }
+
+        lock.unlock();
+        if((finished || brightness_ != value) && this->writeBrightness(value))
+        {
+            brightness_ = value;
+            emit brightnessChanged(value);
+        }
+        lock.lock();
+
+        nextFrame = now + cFrameInterval;
+    }
+}
+
+bool BacklightController::readBrightness(int& value) const
+{
+    char buffer[16];
+    const ssize_t size = pread(fd_, buffer, sizeof(buffer) - 1, 0);
+    if(size <= 0)
+    {
+        return false;
+    }
+
+    buffer[size] = '\0';
+    char* end = nullptr;
+    const long result = std::strtol(buffer, &end, 10);
+    if(end == buffer)
+    {
+        return false;
+    }
+
+    value = static_cast<int>(result);
+    return true;
+}
+
+bool BacklightController::writeBrightness(int value)
+{
+    char buffer[16];
+    const int size = std::snprintf(buffer, sizeof(buffer), "%d\n", value);
+
+    if(regularFile_ && ftruncate(fd_, 0) < 0)
+    {
+        OPENAUTO_LOG(error) << "[BacklightController] Cannot truncate " << path_ << ", errno: " << errno;
+        return false;
+    }
+
+    if(pwrite(fd_, buffer, size, 0) != size)
+    {
+        OPENAUTO_LOG(error) << "[BacklightController] Cannot write " << path_ << ", errno: " << errno;
+        return false;
+    }
+
+    return true;
+}
+
+}
+}
+}
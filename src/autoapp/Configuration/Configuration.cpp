@@ -30,6 +30,8 @@ namespace configuration
 {
 
 const std::string Configuration::cConfigFileName = "openauto.ini";
+const std::string Configuration::cCSEnvFileName = "/boot/crankshaft/crankshaft_env.sh";
+const std::string Configuration::cCSDefaultEnvFileName = "/opt/crankshaft/crankshaft_default_env.sh";
 
 const std::string Configuration::cGeneralShowClockKey = "General.ShowClock";
 
@@ -52,6 +54,7 @@ const std::string Configuration::cGeneralMp3TrackKey = "General.Mp3Track";
 const std::string Configuration::cGeneralMp3AutoPlayKey = "General.Mp3AutoPlay";
 const std::string Configuration::cGeneralShowAutoPlayKey = "General.ShowAutoPlay";
 const std::string Configuration::cGeneralInstantPlayKey = "General.InstantPlay";
+const std::string Configuration::cGeneralSaveDelayKey = "General.SaveDelay";
 
 const std::string Configuration::cVideoFPSKey = "Video.FPS";
 const std::string Configuration::cVideoResolutionKey = "Video.Resolution";
@@ -64,6 +67,27 @@ const std::string Configuration::cAudioMusicAudioChannelEnabled = "Audio.MusicAu
 const std::string Configuration::cAudioSpeechAudioChannelEnabled = "Audio.SpeechAudioChannelEnabled";
 const std::string Configuration::cAudioOutputBackendType = "Audio.OutputBackendType";
 
+const std::string Configuration::cSensorCANInterfaceKey = "Sensor.CANInterface";
+const std::string Configuration::cSensorCANDecodingTableKey = "Sensor.CANDecodingTable";
+const std::string Configuration::cSensorCANPublishIntervalKey = "Sensor.CANPublishInterval";
+const std::string Configuration::cSensorBatchWindowKey = "Sensor.BatchWindow";
+
+const std::string Configuration::cDiagnosticsSessionRecordingPathKey = "Diagnostics.SessionRecordingPath";
+const std::string Configuration::cDiagnosticsSessionHistorySizeKey = "Diagnostics.SessionHistorySize";
+
+const std::string Configuration::cExecutorsMediaKey = "Executors.Media";
+const std::string Configuration::cExecutorsControlKey = "Executors.Control";
+const std::string Configuration::cExecutorsTransportKey = "Executors.Transport";
+const std::string Configuration::cExecutorsHousekeepingKey = "Executors.Housekeeping";
+const std::string Configuration::cExecutorsShutdownTimeoutKey = "Executors.ShutdownTimeout";
+const ExecutorConfig Configuration::cMediaExecutorDefaults = {2, "", 0, 0};
+const ExecutorConfig Configuration::cControlExecutorDefaults = {2, "", 0, 0};
+const ExecutorConfig Configuration::cTransportExecutorDefaults = {2, "", 0, 0};
+const ExecutorConfig Configuration::cHousekeepingExecutorDefaults = {1, "", 0, 10};
+
+const std::string Configuration::cTCPKey = "TCP.";
+const common::TCPTuning Configuration::cTCPTuningDefaults = {true, 1048576, 262144, true, 5, 2, 3, 10000, 0};
+
 const std::string Configuration::cBluetoothAdapterTypeKey = "Bluetooth.AdapterType";
 const std::string Configuration::cBluetoothRemoteAdapterAddressKey = "Bluetooth.RemoteAdapterAddress";
 
@@ -87,6 +111,8 @@ const std::string Configuration::cInputBackButtonKey = "Input.BackButton";
 const std::string Configuration::cInputEnterButtonKey = "Input.EnterButton";
 
 Configuration::Configuration()
+    : store_(std::make_shared<ConfigurationStore>())
+    , writer_(std::make_unique<ConfigurationWriter>(cConfigFileName))
 {
     this->load();
 }
@@ -118,6 +144,7 @@ void Configuration::load()
         mp3AutoPlay_ = iniConfig.get<bool>(cGeneralMp3AutoPlayKey, false);
         showAutoPlay_ = iniConfig.get<bool>(cGeneralShowAutoPlayKey, false);
         instantPlay_ = iniConfig.get<bool>(cGeneralInstantPlayKey, false);
+        saveDelay_ = iniConfig.get<size_t>(cGeneralSaveDelayKey, 2000);
 
         videoFPS_ = static_cast<aasdk::proto::enums::VideoFPS::Enum>(iniConfig.get<uint32_t>(cVideoFPSKey,
                                                                                              aasdk::proto::enums::VideoFPS::_30));
@@ -140,6 +167,19 @@ void Configuration::load()
         musicAudioChannelEnabled_ = iniConfig.get<bool>(cAudioMusicAudioChannelEnabled, true);
         speechAudiochannelEnabled_ = iniConfig.get<bool>(cAudioSpeechAudioChannelEnabled, true);
         audioOutputBackendType_ = static_cast<AudioOutputBackendType>(iniConfig.get<uint32_t>(cAudioOutputBackendType, static_cast<uint32_t>(AudioOutputBackendType::RTAUDIO)));
+
+        canInterface_ = iniConfig.get<std::string>(cSensorCANInterfaceKey, "");
+        canDecodingTable_ = iniConfig.get<std::string>(cSensorCANDecodingTableKey, "openauto_can.ini");
+        canPublishInterval_ = iniConfig.get<size_t>(cSensorCANPublishIntervalKey, 100);
+        sensorBatchWindow_ = iniConfig.get<size_t>(cSensorBatchWindowKey, 50);
+        sessionRecordingPath_ = iniConfig.get<std::string>(cDiagnosticsSessionRecordingPathKey, "");
+        sessionHistorySize_ = iniConfig.get<size_t>(cDiagnosticsSessionHistorySizeKey, 20);
+        this->readExecutorConfig(iniConfig, ExecutorType::MEDIA, cMediaExecutorDefaults);
+        this->readExecutorConfig(iniConfig, ExecutorType::CONTROL, cControlExecutorDefaults);
+        this->readExecutorConfig(iniConfig, ExecutorType::TRANSPORT, cTransportExecutorDefaults);
+        this->readExecutorConfig(iniConfig, ExecutorType::HOUSEKEEPING, cHousekeepingExecutorDefaults);
+        shutdownTimeout_ = iniConfig.get<size_t>(cExecutorsShutdownTimeoutKey, 3000);
+        this->readTCPTuning(iniConfig);
     }
     catch(const boost::property_tree::ini_parser_error& e)
     {
@@ -170,6 +210,7 @@ void Configuration::reset()
     mp3AutoPlay_ = false;
     showAutoPlay_ = false;
     instantPlay_ = false;
+    saveDelay_ = 2000;
     videoFPS_ = aasdk::proto::enums::VideoFPS::_30;
     videoResolution_ = aasdk::proto::enums::VideoResolution::_480p;
     screenDPI_ = 140;
@@ -183,6 +224,18 @@ void Configuration::reset()
     musicAudioChannelEnabled_ = true;
     speechAudiochannelEnabled_ = true;
     audioOutputBackendType_ = AudioOutputBackendType::QT;
+    canInterface_ = "";
+    canDecodingTable_ = "openauto_can.ini";
+    canPublishInterval_ = 100;
+    sensorBatchWindow_ = 50;
+    sessionRecordingPath_ = "";
+    sessionHistorySize_ = 20;
+    executorConfigs_[ExecutorType::MEDIA] = cMediaExecutorDefaults;
+    executorConfigs_[ExecutorType::CONTROL] = cControlExecutorDefaults;
+    executorConfigs_[ExecutorType::TRANSPORT] = cTransportExecutorDefaults;
+    executorConfigs_[ExecutorType::HOUSEKEEPING] = cHousekeepingExecutorDefaults;
+    shutdownTimeout_ = 3000;
+    tcpTuning_ = cTCPTuningDefaults;
 }
 
 void Configuration::save()
@@ -207,6 +260,7 @@ void Configuration::save()
     iniConfig.put<bool>(cGeneralMp3AutoPlayKey, mp3AutoPlay_);
     iniConfig.put<bool>(cGeneralShowAutoPlayKey, showAutoPlay_);
     iniConfig.put<bool>(cGeneralInstantPlayKey, instantPlay_);
+    iniConfig.put<size_t>(cGeneralSaveDelayKey, saveDelay_);
 
     iniConfig.put<uint32_t>(cVideoFPSKey, static_cast<uint32_t>(videoFPS_));
     iniConfig.put<uint32_t>(cVideoResolutionKey, static_cast<uint32_t>(videoResolution_));
@@ -225,7 +279,30 @@ void Configuration::save()
     iniConfig.put<bool>(cAudioMusicAudioChannelEnabled, musicAudioChannelEnabled_);
     iniConfig.put<bool>(cAudioSpeechAudioChannelEnabled, speechAudiochannelEnabled_);
     iniConfig.put<uint32_t>(cAudioOutputBackendType, static_cast<uint32_t>(audioOutputBackendType_));
-    boost::property_tree::ini_parser::write_ini(cConfigFileName, iniConfig);
+
+    iniConfig.put<std::string>(cSensorCANInterfaceKey, canInterface_);
+    iniConfig.put<std::string>(cSensorCANDecodingTableKey, canDecodingTable_);
+    iniConfig.put<size_t>(cSensorCANPublishIntervalKey, canPublishInterval_);
+    iniConfig.put<size_t>(cSensorBatchWindowKey, sensorBatchWindow_);
+    iniConfig.put<std::string>(cDiagnosticsSessionRecordingPathKey, sessionRecordingPath_);
+    iniConfig.put<size_t>(cDiagnosticsSessionHistorySizeKey, sessionHistorySize_);
+    this->writeExecutorConfig(iniConfig, ExecutorType::MEDIA);
+    this->writeExecutorConfig(iniConfig, ExecutorType::CONTROL);
+    this->writeExecutorConfig(iniConfig, ExecutorType::TRANSPORT);
+    this->writeExecutorConfig(iniConfig, ExecutorType::HOUSEKEEPING);
+    iniConfig.put<size_t>(cExecutorsShutdownTimeoutKey, shutdownTimeout_);
+    this->writeTCPTuning(iniConfig);
+
+    writer_->write(std::move(iniConfig), std::chrono::milliseconds(saveDelay_));
+    if(saveDelay_ == 0)
+    {
+        writer_->flush();
+    }
+}
+
+void Configuration::flush()
+{
+    writer_->flush();
 }
 
 bool Configuration::hasTouchScreen() const
@@ -557,127 +634,157 @@ void Configuration::setAudioOutputBackendType(AudioOutputBackendType value)
     audioOutputBackendType_ = value;
 }
 
-QString Configuration::getCSValue(QString searchString) const
+std::string Configuration::getCANInterface() const
 {
-    using namespace std;
-    ifstream inFile;
-    ifstream inFile2;
-    string line;
-    searchString = searchString.append("=");
-    inFile.open("/boot/crankshaft/crankshaft_env.sh");
-    inFile2.open("/opt/crankshaft/crankshaft_default_env.sh");
+    return canInterface_;
+}
 
-    size_t pos;
+void Configuration::setCANInterface(const std::string& value)
+{
+    canInterface_ = value;
+}
 
-    if(inFile) {
-        while(inFile.good())
-        {
-            getline(inFile,line); // get line from file
-            if (line[0] != '#') {
-                pos=line.find(searchString.toStdString()); // search
-                if(pos!=std::string::npos) // string::npos is returned if string is not found
-                {
-                    int equalPosition = line.find("=");
-                    QString value = line.substr(equalPosition + 1).c_str();
-                    value.replace("\"","");
-                    OPENAUTO_LOG(info) << "[Configuration] CS param found: " << searchString.toStdString() << " Value:" << value.toStdString();
-                    return value;
-                }
-            }
-        }
-        OPENAUTO_LOG(warning) << "[Configuration] unable to find cs param: " << searchString.toStdString();
-        OPENAUTO_LOG(warning) << "[Configuration] Fallback to /opt/crankshaft/crankshaft_default_env.sh)";
-        while(inFile2.good())
-        {
-            getline(inFile2,line); // get line from file
-            if (line[0] != '#') {
-                pos=line.find(searchString.toStdString()); // search
-                if(pos!=std::string::npos) // string::npos is returned if string is not found
-                {
-                    int equalPosition = line.find("=");
-                    QString value = line.substr(equalPosition + 1).c_str();
-                    value.replace("\"","");
-                    OPENAUTO_LOG(info) << "[Configuration] CS param found: " << searchString.toStdString() << " Value:" << value.toStdString();
-                    return value;
-                }
-            }
-        }
-        return "";
-    } else {
-        OPENAUTO_LOG(warning) << "[Configuration] unable to open cs param file (/boot/crankshaft/crankshaft_env.sh)";
-        OPENAUTO_LOG(warning) << "[Configuration] Fallback to /opt/crankshaft/crankshaft_default_env.sh)";
+std::string Configuration::getCANDecodingTable() const
+{
+    return canDecodingTable_;
+}
 
-        while(inFile2.good())
-        {
-            getline(inFile2,line); // get line from file
-            if (line[0] != '#') {
-                pos=line.find(searchString.toStdString()); // search
-                if(pos!=std::string::npos) // string::npos is returned if string is not found
-                {
-                    int equalPosition = line.find("=");
-                    QString value = line.substr(equalPosition + 1).c_str();
-                    value.replace("\"","");
-                    OPENAUTO_LOG(info) << "[Configuration] CS param found: " << searchString.toStdString() << " Value:" << value.toStdString();
-                    return value;
-                }
-            }
-        }
-        return "";
-    }
+void Configuration::setCANDecodingTable(const std::string& value)
+{
+    canDecodingTable_ = value;
 }
 
-QString Configuration::getParamFromFile(QString fileName, QString searchString) const
+size_t Configuration::getCANPublishInterval() const
+{
+    return canPublishInterval_;
+}
+
+void Configuration::setCANPublishInterval(size_t value)
+{
+    canPublishInterval_ = value;
+}
+
+size_t Configuration::getSensorBatchWindow() const
+{
+    return sensorBatchWindow_;
+}
+
+void Configuration::setSensorBatchWindow(size_t value)
+{
+    sensorBatchWindow_ = value;
+}
+
+std::string Configuration::getSessionRecordingPath() const
+{
+    return sessionRecordingPath_;
+}
+
+void Configuration::setSessionRecordingPath(const std::string& value)
+{
+    sessionRecordingPath_ = value;
+}
+
+size_t Configuration::getSessionHistorySize() const
+{
+    return sessionHistorySize_;
+}
+
+void Configuration::setSessionHistorySize(size_t value)
+{
+    sessionHistorySize_ = value;
+}
+
+ExecutorConfig Configuration::getExecutorConfig(ExecutorType type) const
+{
+    return executorConfigs_.at(type);
+}
+
+void Configuration::setExecutorConfig(ExecutorType type, const ExecutorConfig& value)
+{
+    executorConfigs_[type] = value;
+}
+
+size_t Configuration::getShutdownTimeout() const
+{
+    return shutdownTimeout_;
+}
+
+void Configuration::setShutdownTimeout(size_t value)
+{
+    shutdownTimeout_ = value;
+}
+
+common::TCPTuning Configuration::getTCPTuning() const
+{
+    return tcpTuning_;
+}
+
+void Configuration::setTCPTuning(const common::TCPTuning& value)
 {
-    OPENAUTO_LOG(info) << "[Configuration] Request param from file: " << fileName.toStdString() << " param: " << searchString.toStdString();
-    using namespace std;
-    ifstream inFile;
-    string line;
-    if (!searchString.contains("dtoverlay")) {
-        searchString = searchString.append("=");
+    tcpTuning_ = value;
+}
+
+size_t Configuration::getSaveDelay() const
+{
+    return saveDelay_;
+}
+
+void Configuration::setSaveDelay(size_t value)
+{
+    saveDelay_ = value;
+}
+
+QString Configuration::getCSValue(QString searchString) const
+{
+    const auto key = searchString.toStdString();
+    std::string value;
+
+    if(store_->getValue(cCSEnvFileName, key, value) || store_->getValue(cCSDefaultEnvFileName, key, value))
+    {
+        return QString::fromStdString(value);
     }
-    inFile.open(fileName.toStdString());
 
-    size_t pos;
+    OPENAUTO_LOG(warning) << "[Configuration] unable to find cs param: " << key;
+    return "";
+}
 
-    if(inFile) {
-        while(inFile.good())
-        {
-            getline(inFile,line); // get line from file
-            if (line[0] != '#') {
-                pos=line.find(searchString.toStdString()); // search
-                if(pos!=std::string::npos) // string::npos is returned if string is not found
-                {
-                    int equalPosition = line.find("=");
-                    QString value = line.substr(equalPosition + 1).c_str();
-                    value.replace("\"","");
-                    OPENAUTO_LOG(info) << "[Configuration] Param from file: " << fileName.toStdString() << " found: " << searchString.toStdString() << " Value:" << value.toStdString();
-                    return value;
-                }
-            }
-        }
-        return "";
-    } else {
-        return "";
+QString Configuration::getParamFromFile(QString fileName, QString searchString) const
+{
+    std::string value;
+
+    if(searchString.contains("dtoverlay"))
+    {
+        store_->findLine(fileName.toStdString(), searchString.toStdString(), value);
+    }
+    else
+    {
+        store_->getValue(fileName.toStdString(), searchString.toStdString(), value);
     }
+
+    return QString::fromStdString(value);
 }
 
 QString Configuration::readFileContent(QString fileName) const
 {
-    using namespace std;
-    ifstream inFile;
-    string line;
-    inFile.open(fileName.toStdString());
-    string result = "";
-    if(inFile) {
-        while(inFile.good())
+    std::string content;
+    store_->getContent(fileName.toStdString(), content);
+    return QString::fromStdString(content);
+}
+
+void Configuration::subscribeCSValues(std::function<void(const QStringList& keys)> handler)
+{
+    auto storeHandler = [handler](const std::string&, const std::vector<std::string>& keys) {
+        QStringList changedKeys;
+        for(const auto& key : keys)
         {
-            getline(inFile,line); // get line from file
-            result.append(line);
+            changedKeys.append(QString::fromStdString(key));
         }
-        return result.c_str();
-    } else {
-        return "";
-    }
+
+        handler(changedKeys);
+    };
+
+    store_->subscribe(cCSEnvFileName, storeHandler);
+    store_->subscribe(cCSDefaultEnvFileName, storeHandler);
 }
 
 void Configuration::readButtonCodes(boost::property_tree::ptree& iniConfig)
@@ -728,6 +835,72 @@ void Configuration::writeButtonCodes(boost::property_tree::ptree& iniConfig)
     iniConfig.put<bool>(cInputEnterButtonKey, std::find(buttonCodes_.begin(), buttonCodes_.end(), aasdk::proto::enums::ButtonCode::ENTER) != buttonCodes_.end());
 }
 
+void Configuration::readExecutorConfig(boost::property_tree::ptree& iniConfig, ExecutorType type, const ExecutorConfig& defaultConfig)
+{
+    const auto key = getExecutorKey(type);
+
+    ExecutorConfig config;
+    config.threads = std::max<size_t>(1, iniConfig.get<size_t>(key + "Threads", defaultConfig.threads));
+    config.cpus = iniConfig.get<std::string>(key + "CPUs", defaultConfig.cpus);
+    config.priority = iniConfig.get<int32_t>(key + "Priority", defaultConfig.priority);
+    config.nice = iniConfig.get<int32_t>(key + "Nice", defaultConfig.nice);
+    executorConfigs_[type] = config;
+}
+
+void Configuration::writeExecutorConfig(boost::property_tree::ptree& iniConfig, ExecutorType type)
+{
+    const auto key = getExecutorKey(type);
+    const auto& config = executorConfigs_.at(type);
+
+    iniConfig.put<size_t>(key + "Threads", config.threads);
+    iniConfig.put<std::string>(key + "CPUs", config.cpus);
+    iniConfig.put<int32_t>(key + "Priority", config.priority);
+    iniConfig.put<int32_t>(key + "Nice", config.nice);
+}
+
+std::string Configuration::getExecutorKey(ExecutorType type)
+{
+    switch(type)
+    {
+    case ExecutorType::MEDIA:
+        return cExecutorsMediaKey;
+
+    case ExecutorType::CONTROL:
+        return cExecutorsControlKey;
+
+    case ExecutorType::TRANSPORT:
+        return cExecutorsTransportKey;
+
+    default:
+        return cExecutorsHousekeepingKey;
+    }
+}
+
+void Configuration::readTCPTuning(boost::property_tree::ptree& iniConfig)
+{
+    tcpTuning_.noDelay = iniConfig.get<bool>(cTCPKey + "NoDelay", cTCPTuningDefaults.noDelay);
+    tcpTuning_.receiveBufferSize = iniConfig.get<int32_t>(cTCPKey + "ReceiveBufferSize", cTCPTuningDefaults.receiveBufferSize);
+    tcpTuning_.sendBufferSize = iniConfig.get<int32_t>(cTCPKey + "SendBufferSize", cTCPTuningDefaults.sendBufferSize);
+    tcpTuning_.keepAlive = iniConfig.get<bool>(cTCPKey + "KeepAlive", cTCPTuningDefaults.keepAlive);
+    tcpTuning_.keepAliveIdle = iniConfig.get<int32_t>(cTCPKey + "KeepAliveIdle", cTCPTuningDefaults.keepAliveIdle);
+    tcpTuning_.keepAliveInterval = iniConfig.get<int32_t>(cTCPKey + "KeepAliveInterval", cTCPTuningDefaults.keepAliveInterval);
+    tcpTuning_.keepAliveCount = iniConfig.get<int32_t>(cTCPKey + "KeepAliveCount", cTCPTuningDefaults.keepAliveCount);
+    tcpTuning_.userTimeout = iniConfig.get<uint32_t>(cTCPKey + "UserTimeout", cTCPTuningDefaults.userTimeout);
+    tcpTuning_.busyPoll = iniConfig.get<int32_t>(cTCPKey + "BusyPoll", cTCPTuningDefaults.busyPoll);
+}
+
+void Configuration::writeTCPTuning(boost::property_tree::ptree& iniConfig)
+{
+    iniConfig.put<bool>(cTCPKey + "NoDelay", tcpTuning_.noDelay);
+    iniConfig.put<int32_t>(cTCPKey + "ReceiveBufferSize", tcpTuning_.receiveBufferSize);
+    iniConfig.put<int32_t>(cTCPKey + "SendBufferSize", tcpTuning_.sendBufferSize);
+    iniConfig.put<bool>(cTCPKey + "KeepAlive", tcpTuning_.keepAlive);
+    iniConfig.put<int32_t>(cTCPKey + "KeepAliveIdle", tcpTuning_.keepAliveIdle);
+    iniConfig.put<int32_t>(cTCPKey + "KeepAliveInterval", tcpTuning_.keepAliveInterval);
+    iniConfig.put<int32_t>(cTCPKey + "KeepAliveCount", tcpTuning_.keepAliveCount);
+    iniConfig.put<uint32_t>(cTCPKey + "UserTimeout", tcpTuning_.userTimeout);
+    iniConfig.put<int32_t>(cTCPKey + "BusyPoll", tcpTuning_.busyPoll);
+}
 }
 }
 }
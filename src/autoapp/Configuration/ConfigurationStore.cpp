@@ -0,0 +1,306 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <set>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <f1x/openauto/autoapp/Configuration/ConfigurationStore.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace configuration
+{
+
+ConfigurationStore::ConfigurationStore(QObject* parent)
+    : QObject(parent)
+    , inotifyFd_(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+{
+    if(inotifyFd_ >= 0)
+    {
+        notifier_ = std::make_unique<QSocketNotifier>(inotifyFd_, QSocketNotifier::Read, this);
+        connect(notifier_.get(), &QSocketNotifier::activated, this, &ConfigurationStore::onInotifyEvent);
+    }
+    else
+    {
+        OPENAUTO_LOG(error) << "[ConfigurationStore] inotify init failed, errno: " << errno << ". Files will be read on every lookup.";
+    }
+}
+
+ConfigurationStore::~ConfigurationStore()
+{
+    notifier_.reset();
+
+    if(inotifyFd_ >= 0)
+    {
+        close(inotifyFd_);
+    }
+}
+
+bool ConfigurationStore::getValue(const std::string& fileName, const std::string& key, std::string& value)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto& file = this->getFile(fileName);
+    const auto it = file.values.find(key);
+
+    if(it == file.values.end())
+    {
+        return false;
+    }
+
+    value = it->second;
+    return true;
+}
+
+bool ConfigurationStore::findLine(const std::string& fileName, const std::string& pattern, std::string& value)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto& file = this->getFile(fileName);
+
+    for(const auto& line : file.lines)
+    {
+        if(!line.empty() && line[0] != '#' && line.find(pattern) != std::string::npos)
+        {
+            const auto separator = line.find('=');
+            value = separator != std::string::npos ? unquote(line.substr(separator + 1)) : std::string();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool ConfigurationStore::getContent(const std::string& fileName, std::string& content)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto& file = this->getFile(fileName);
+    content = file.content;
+    return file.exists;
+}
+
+void ConfigurationStore::subscribe(const std::string& fileName, Handler handler)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    this->getFile(fileName);
+    handlers_.emplace(fileName, std::move(handler));
+}
+
+ConfigurationStore::File& ConfigurationStore::getFile(const std::string& fileName)
+{
+    auto it = files_.find(fileName);
+    if(it == files_.end())
+    {
+        it = files_.emplace(fileName, File{true, false, false, {}, {}, {}}).first;
+        it->second.watched = this->watch(fileName);
+    }
+
+    auto& file = it->second;
+    if(file.stale || !file.watched)
+    {
+        parse(fileName, file);
+        file.stale = false;
+    }
+
+    return file;
+}
+
+bool ConfigurationStore::watch(const std::string& fileName)
+{
+    if(inotifyFd_ < 0 || fileName.compare(0, 5, "/sys/") == 0 || fileName.compare(0, 6, "/proc/") == 0)
+    {
+        return false;
+    }
+
+    const auto separator = fileName.rfind('/');
+    const auto directory = separator == std::string::npos ? std::string(".") : fileName.substr(0, std::max<size_t>(separator, 1));
+
+    if(directoryWatches_.count(directory) != 0)
+    {
+        return true;
+    }
+
+    const int wd = inotify_add_watch(inotifyFd_, directory.c_str(), IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO);
+    if(wd < 0)
+    {
+        OPENAUTO_LOG(warning) << "[ConfigurationStore] cannot watch " << directory << ", errno: " << errno << ". " << fileName << " will not be cached.";
+        return false;
+    }
+
+    directoryWatches_[directory] = wd;
+    watchedDirectories_[wd] = directory;
+    return true;
+}
+
+void ConfigurationStore::onInotifyEvent()
+{
+    alignas(struct inotify_event) char buffer[4096];
+    std::set<std::string> changedFiles;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        ssize_t size;
+        while((size = read(inotifyFd_, buffer, sizeof(buffer))) > 0)
+        {
+            for(char* ptr = buffer; ptr < buffer + size; ptr += sizeof(struct inotify_event) + reinterpret_cast<struct inotify_event*>(ptr)->len)
+            {
+                const auto* event = reinterpret_cast<struct inotify_event*>(ptr);
+                const auto directory = watchedDirectories_.find(event->wd);
+                if(directory == watchedDirectories_.end() || event->len == 0)
+                {
+                    continue;
+                }
+
+                const auto fileName = (directory->second == "/" ? std::string() : directory->second) + "/" + event->name;
+                auto file = files_.find(fileName);
+                if(file != files_.end())
+                {
+                    file->second.stale = true;
+
+                    if((event->mask & IN_MODIFY) == 0 && handlers_.count(fileName) != 0)
+                    {
+                        changedFiles.insert(fileName);
+                    }
+                }
+            }
+        }
+    }
+
+    for(const auto& fileName : changedFiles)
+    {
+        std::vector<std::string> keys;
+        std::vector<Handler> handlers;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            keys = this->reload(fileName, files_.at(fileName));
+
+            const auto range = handlers_.equal_range(fileName);
+            for(auto it = range.first; it != range.second; ++it)
+            {
+                handlers.push_back(it->second);
+            }
+        }
+
+        if(!keys.empty())
+        {
+            for(const auto& handler : handlers)
+            {
+                handler(fileName, keys);
+            }
+        }
+    }
+}
+
+std::vector<std::string> ConfigurationStore::reload(const std::string& fileName, File& file)
+{
+    const auto previous = std::move(file.values);
+    parse(fileName, file);
+    file.stale = false;
+
+    std::vector<std::string> keys;
+    for(const auto& entry : file.values)
+    {
+        const auto it = previous.find(entry.first);
+        if(it == previous.end() || it->second != entry.second)
+        {
+            keys.push_back(entry.first);
+        }
+    }
+
+    for(const auto& entry : previous)
+    {
+        if(file.values.count(entry.first) == 0)
+        {
+            keys.push_back(entry.first);
+        }
+    }
+
+    return keys;
+}
+
+void ConfigurationStore::parse(const std::string& fileName, File& file)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    file.lines.clear();
+    file.content.clear();
+    file.values.clear();
+
+    std::ifstream stream(fileName);
+    file.exists = static_cast<bool>(stream);
+
+    std::string line;
+    while(std::getline(stream, line))
+    {
+        file.content.append(line);
+
+        if(!line.empty() && line[0] != '#')
+        {
+            const auto separator = line.find('=');
+            if(separator != std::string::npos)
+            {
+                auto key = line.substr(0, separator);
+                key.erase(0, key.find_first_not_of(" \t"));
+                if(key.compare(0, 7, "export ") == 0)
+                {
+                    key.erase(0, 7);
+                }
+                key.erase(key.find_last_not_of(" \t") + 1);
+
+                file.values.emplace(key, unquote(line.substr(separator + 1)));
+            }
+        }
+
+        file.lines.push_back(std::move(line));
+    }
+
+    if(file.exists && file.watched)
+    {
+        OPENAUTO_LOG(info) << "[ConfigurationStore] indexed " << file.values.size() << " keys from " << fileName
+                           << " in " << std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() << " us.";
+    }
+}
+
+std::string ConfigurationStore::unquote(const std::string& value)
+{
+    std::string result;
+    result.reserve(value.size());
+
+    for(const auto c : value)
+    {
+        if(c != '"')
+        {
+            result.push_back(c);
+        }
+    }
+
+    return result;
+}
+
+}
+}
+}
+}
@@ -0,0 +1,192 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <sstream>
+#include <boost/property_tree/ini_parser.hpp>
+#include <f1x/openauto/autoapp/Configuration/ConfigurationWriter.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace configuration
+{
+
+ConfigurationWriter::ConfigurationWriter(std::string fileName)
+    : fileName_(std::move(fileName))
+    , coalescedWrites_(0)
+    , writing_(false)
+    , stopping_(false)
+    , thread_(&ConfigurationWriter::run, this)
+{
+
+}
+
+ConfigurationWriter::~ConfigurationWriter()
+{
+    this->flush();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+
+    condition_.notify_all();
+    thread_.join();
+}
+
+void ConfigurationWriter::write(boost::property_tree::ptree iniConfig, std::chrono::milliseconds delay)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(pending_ == nullptr)
+        {
+            deadline_ = std::chrono::steady_clock::now() + delay;
+        }
+        else
+        {
+            ++coalescedWrites_;
+        }
+
+        pending_ = std::make_unique<boost::property_tree::ptree>(std::move(iniConfig));
+    }
+
+    condition_.notify_all();
+}
+
+void ConfigurationWriter::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    deadline_ = std::chrono::steady_clock::now();
+    condition_.notify_all();
+    condition_.wait(lock, [this]() { return pending_ == nullptr && !writing_; });
+}
+
+void ConfigurationWriter::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while(!stopping_)
+    {
+        if(pending_ == nullptr)
+        {
+            condition_.wait(lock);
+            continue;
+        }
+
+        if(std::chrono::steady_clock::now() < deadline_)
+        {
+            condition_.wait_until(lock, deadline_);
+            continue;
+        }
+
+        auto iniConfig = std::move(pending_);
+        const auto coalescedWrites = coalescedWrites_;
+        coalescedWrites_ = 0;
+        writing_ = true;
+        lock.unlock();
+
+        const auto start = std::chrono::steady_clock::now();
+        const bool written = this->writeFile(*iniConfig);
+        const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        if(written)
+        {
+            OPENAUTO_LOG(info) << "[ConfigurationWriter] " << fileName_ << " written in " << duration.count() << " ms, coalesced saves: " << coalescedWrites << ".";
+        }
+
+        lock.lock();
+        writing_ = false;
+        condition_.notify_all();
+    }
+}
+
+bool ConfigurationWriter::writeFile(const boost::property_tree::ptree& iniConfig)
+{
+    std::ostringstream stream;
+    try
+    {
+        boost::property_tree::ini_parser::write_ini(stream, iniConfig);
+    }
+    catch(const boost::property_tree::ini_parser_error& e)
+    {
+        OPENAUTO_LOG(error) << "[ConfigurationWriter] failed to serialize configuration: " << e.what();
+        return false;
+    }
+
+    const auto content = stream.str();
+    const auto temporaryFileName = fileName_ + ".tmp";
+
+    const int fd = ::open(temporaryFileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if(fd < 0)
+    {
+        OPENAUTO_LOG(error) << "[ConfigurationWriter] cannot open " << temporaryFileName << ", errno: " << errno;
+        return false;
+    }
+
+    size_t offset = 0;
+    while(offset < content.size())
+    {
+        const auto written = ::write(fd, content.data() + offset, content.size() - offset);
+        if(written < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+
+            OPENAUTO_LOG(error) << "[ConfigurationWriter] write to " << temporaryFileName << " failed, errno: " << errno;
+            ::close(fd);
+            ::unlink(temporaryFileName.c_str());
+            return false;
+        }
+
+        offset += written;
+    }
+
+    const bool synced = ::fsync(fd) == 0;
+    const bool closed = ::close(fd) == 0;
+    if(!synced || !closed || std::rename(temporaryFileName.c_str(), fileName_.c_str()) != 0)
+    {
+        OPENAUTO_LOG(error) << "[ConfigurationWriter] cannot commit " << fileName_ << ", errno: " << errno;
+        ::unlink(temporaryFileName.c_str());
+        return false;
+    }
+
+    const auto separator = fileName_.rfind('/');
+    const auto directory = separator == std::string::npos ? std::string(".") : fileName_.substr(0, separator + 1);
+    const int directoryFd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if(directoryFd >= 0)
+    {
+        ::fsync(directoryFd);
+        ::close(directoryFd);
+    }
+
+    return true;
+}
+
+}
+}
+}
+}
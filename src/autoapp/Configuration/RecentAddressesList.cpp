@@ -46,12 +46,12 @@ void RecentAddressesList::read()
 
 void RecentAddressesList::insertAddress(const std::string& address)
 {
-    if(std::find(list_.begin(), list_.end(), address) != list_.end())
+    auto it = std::find(list_.begin(), list_.end(), address);
+    if(it != list_.end())
     {
-        return;
+        list_.erase(it);
     }
-
-    if(list_.size() >= maxListSize_)
+    else if(list_.size() >= maxListSize_)
     {
         list_.pop_back();
     }
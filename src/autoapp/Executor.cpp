@@ -0,0 +1,182 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <f1x/openauto/autoapp/Executor.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+const std::chrono::milliseconds Executor::cForcedStopGrace(200);
+
+Executor::Executor(std::string name, configuration::ExecutorConfig config)
+    : name_(std::move(name))
+    , config_(std::move(config))
+    , work_(std::make_unique<boost::asio::io_service::work>(ioService_))
+{
+
+}
+
+boost::asio::io_service& Executor::getIoService()
+{
+    return ioService_;
+}
+
+void Executor::start()
+{
+    OPENAUTO_LOG(info) << "[Executor] " << this->describe();
+
+    for(size_t i = 0; i < config_.threads; ++i)
+    {
+        std::promise<void> finished;
+        finished_.push_back(finished.get_future());
+        threads_.emplace_back(&Executor::run, this, i, std::move(finished));
+    }
+}
+
+void Executor::stop()
+{
+    work_.reset();
+}
+
+bool Executor::join(std::chrono::steady_clock::time_point deadline)
+{
+    bool joined = true;
+    bool drained = true;
+
+    for(size_t i = 0; i < threads_.size(); ++i)
+    {
+        if(drained && finished_[i].wait_until(deadline) != std::future_status::ready)
+        {
+            OPENAUTO_LOG(warning) << "[Executor] " << name_ << ": pending work not drained before deadline, stopping.";
+            ioService_.stop();
+            drained = false;
+        }
+
+        if(finished_[i].wait_for(drained ? std::chrono::milliseconds(0) : cForcedStopGrace) == std::future_status::ready)
+        {
+            threads_[i].join();
+        }
+        else
+        {
+            OPENAUTO_LOG(error) << "[Executor] " << name_ << ": thread " << i << " did not exit before deadline.";
+            threads_[i].detach();
+            joined = false;
+        }
+    }
+
+    threads_.clear();
+    finished_.clear();
+    return joined;
+}
+
+bool Executor::isFinished() const
+{
+    return std::all_of(finished_.begin(), finished_.end(), [](const std::future<void>& finished) {
+        return finished.wait_for(std::chrono::milliseconds(0)) == std::future_status::ready;
+    });
+}
+
+std::string Executor::describe() const
+{
+    std::ostringstream description;
+    description << name_ << ": " << config_.threads << " thread(s)"
+                << ", cpus: " << (config_.cpus.empty() ? "any" : config_.cpus)
+                << ", policy: " << (config_.priority > 0 ? "SCHED_FIFO " + std::to_string(config_.priority) : "SCHED_OTHER")
+                << ", nice: " << config_.nice;
+    return description.str();
+}
+
+void Executor::run(size_t index, std::promise<void> finished)
+{
+    this->applyThreadSettings(index);
+    ioService_.run();
+    finished.set_value();
+}
+
+void Executor::applyThreadSettings(size_t index)
+{
+    const std::string threadName = ("oa-" + name_ + "-" + std::to_string(index)).substr(0, 15);
+    pthread_setname_np(pthread_self(), threadName.c_str());
+
+    if(!config_.cpus.empty())
+    {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+
+        std::istringstream cpus(config_.cpus);
+        std::string range;
+        while(std::getline(cpus, range, ','))
+        {
+            const auto separator = range.find('-');
+            try
+            {
+                const int first = std::stoi(range.substr(0, separator));
+                const int last = separator == std::string::npos ? first : std::stoi(range.substr(separator + 1));
+                for(int cpu = first; cpu <= last && cpu < CPU_SETSIZE; ++cpu)
+                {
+                    CPU_SET(cpu, &cpuSet);
+                }
+            }
+            catch(const std::exception&)
+            {
+                OPENAUTO_LOG(warning) << "[Executor] " << name_ << ": invalid cpu range: " << range;
+            }
+        }
+
+        const auto result = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+        if(result != 0)
+        {
+            OPENAUTO_LOG(warning) << "[Executor] " << name_ << ": failed to set cpu affinity " << config_.cpus << ", error: " << std::strerror(result);
+        }
+    }
+
+    if(config_.priority > 0)
+    {
+        sched_param param;
+        param.sched_priority = config_.priority;
+
+        const auto result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if(result != 0)
+        {
+            OPENAUTO_LOG(warning) << "[Executor] " << name_ << ": failed to set SCHED_FIFO priority " << config_.priority << ", error: " << std::strerror(result);
+        }
+    }
+
+    if(config_.nice != 0 && setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), config_.nice) != 0)
+    {
+        OPENAUTO_LOG(warning) << "[Executor] " << name_ << ": failed to set nice " << config_.nice << ", error: " << std::strerror(errno);
+    }
+}
+
+}
+}
+}
@@ -0,0 +1,306 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <f1x/openauto/autoapp/HelperClient.hpp>
+#include <f1x/openauto/Common/HelperProtocol.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+
+extern char** environ;
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+const size_t HelperClient::cRetryInterval = 250;
+
+HelperClient::HelperClient(boost::asio::io_service& ioService, std::string socketPath, std::string helperPath)
+    : strand_(ioService)
+    , socket_(ioService)
+    , retryTimer_(ioService)
+    , socketPath_(std::move(socketPath))
+    , helperPath_(std::move(helperPath))
+    , nextId_(1)
+    , connected_(false)
+    , connecting_(false)
+    , stopped_(false)
+    , helperPid_(-1)
+    , coalescedCommands_(0)
+{
+
+}
+
+void HelperClient::execute(std::string command, Handler handler)
+{
+    this->enqueue(std::string(), std::move(command), std::move(handler));
+}
+
+void HelperClient::coalesce(std::string key, std::string command, Handler handler)
+{
+    this->enqueue(std::move(key), std::move(command), std::move(handler));
+}
+
+void HelperClient::stop()
+{
+    strand_.dispatch([this]() {
+        stopped_ = true;
+        boost::system::error_code ec;
+        retryTimer_.cancel(ec);
+        this->fail();
+
+        for(auto& command : queue_)
+        {
+            complete(command, common::cHelperFailedStatus);
+        }
+        queue_.clear();
+
+        OPENAUTO_LOG(info) << "[HelperClient] Stopped, coalesced commands: " << coalescedCommands_ << ".";
+    });
+}
+
+void HelperClient::enqueue(std::string key, std::string command, Handler handler)
+{
+    strand_.dispatch([this, key = std::move(key), command = std::move(command), handler = std::move(handler)]() mutable {
+        if(stopped_)
+        {
+            if(handler)
+            {
+                handler(common::cHelperFailedStatus);
+            }
+            return;
+        }
+
+        if(!key.empty())
+        {
+            for(auto& queued : queue_)
+            {
+                if(queued.key == key)
+                {
+                    OPENAUTO_LOG(debug) << "[HelperClient] " << queued.command << " superseded by " << command << ".";
+                    queued.command = std::move(command);
+                    queued.handlers.push_back(std::move(handler));
+                    ++coalescedCommands_;
+                    return;
+                }
+            }
+        }
+
+        queue_.push_back(Command{nextId_++, std::move(key), std::move(command), {std::move(handler)}, std::chrono::steady_clock::now()});
+        this->flush();
+    });
+}
+
+void HelperClient::flush()
+{
+    if(!connected_)
+    {
+        this->connect();
+        return;
+    }
+
+    const bool idle = writeQueue_.empty();
+    for(auto it = queue_.begin(); it != queue_.end();)
+    {
+        if(!it->key.empty() && busyKeys_.count(it->key) != 0)
+        {
+            ++it;
+            continue;
+        }
+
+        if(!it->key.empty())
+        {
+            busyKeys_.insert(it->key);
+        }
+
+        writeQueue_.push_back(common::HelperProtocol::encode(it->id, it->command));
+        const auto id = it->id;
+        inFlight_.emplace(id, std::move(*it));
+        it = queue_.erase(it);
+    }
+
+    if(idle && !writeQueue_.empty())
+    {
+        this->write();
+    }
+}
+
+void HelperClient::connect()
+{
+    if(connecting_ || stopped_)
+    {
+        return;
+    }
+
+    connecting_ = true;
+    socket_.async_connect(boost::asio::local::stream_protocol::endpoint(socketPath_),
+                          strand_.wrap([this](const boost::system::error_code& ec) { this->onConnect(ec); }));
+}
+
+void HelperClient::onConnect(const boost::system::error_code& ec)
+{
+    connecting_ = false;
+    if(stopped_)
+    {
+        return;
+    }
+
+    if(ec)
+    {
+        OPENAUTO_LOG(warning) << "[HelperClient] Cannot connect to " << socketPath_ << ": " << ec.message();
+
+        boost::system::error_code closeError;
+        socket_.close(closeError);
+        this->spawnHelper();
+
+        retryTimer_.expires_from_now(boost::posix_time::milliseconds(cRetryInterval));
+        retryTimer_.async_wait(strand_.wrap([this](const boost::system::error_code& error) {
+            if(!error && !queue_.empty())
+            {
+                this->connect();
+            }
+        }));
+        return;
+    }
+
+    ::fcntl(socket_.native_handle(), F_SETFD, FD_CLOEXEC);
+    connected_ = true;
+    OPENAUTO_LOG(info) << "[HelperClient] Connected to " << socketPath_ << ".";
+
+    this->read();
+    this->flush();
+}
+
+void HelperClient::read()
+{
+    boost::asio::async_read_until(socket_, buffer_, '\n', strand_.wrap([this](const boost::system::error_code& ec, size_t) {
+        if(ec)
+        {
+            if(ec != boost::asio::error::operation_aborted)
+            {
+                OPENAUTO_LOG(warning) << "[HelperClient] Connection lost: " << ec.message();
+                this->fail();
+            }
+            return;
+        }
+
+        std::istream stream(&buffer_);
+        std::string line;
+        std::getline(stream, line);
+
+        uint32_t id = 0;
+        std::string payload;
+        if(common::HelperProtocol::decode(line, id, payload))
+        {
+            auto it = inFlight_.find(id);
+            if(it != inFlight_.end())
+            {
+                const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - it->second.timestamp);
+                const int status = std::atoi(payload.c_str());
+                OPENAUTO_LOG(debug) << "[HelperClient] " << it->second.command << " finished in " << duration.count() << " ms, status: " << status << ".";
+
+                busyKeys_.erase(it->second.key);
+                complete(it->second, status);
+                inFlight_.erase(it);
+            }
+        }
+
+        this->flush();
+        this->read();
+    }));
+}
+
+void HelperClient::write()
+{
+    boost::asio::async_write(socket_, boost::asio::buffer(writeQueue_.front()), strand_.wrap([this](const boost::system::error_code& ec, size_t) {
+        if(ec)
+        {
+            if(ec != boost::asio::error::operation_aborted)
+            {
+                OPENAUTO_LOG(warning) << "[HelperClient] Write failed: " << ec.message();
+                this->fail();
+            }
+            return;
+        }
+
+        writeQueue_.pop_front();
+        if(!writeQueue_.empty())
+        {
+            this->write();
+        }
+    }));
+}
+
+void HelperClient::fail()
+{
+    boost::system::error_code ec;
+    socket_.close(ec);
+    connected_ = false;
+    writeQueue_.clear();
+    buffer_.consume(buffer_.size());
+    busyKeys_.clear();
+
+    for(auto& command : inFlight_)
+    {
+        complete(command.second, common::cHelperFailedStatus);
+    }
+    inFlight_.clear();
+
+    if(!queue_.empty())
+    {
+        this->connect();
+    }
+}
+
+void HelperClient::spawnHelper()
+{
+    if(helperPid_ > 0 && ::waitpid(helperPid_, nullptr, WNOHANG) == 0)
+    {
+        return;
+    }
+
+    const char* argv[] = {helperPath_.c_str(), "--socket", socketPath_.c_str(), nullptr};
+    const int result = ::posix_spawn(&helperPid_, helperPath_.c_str(), nullptr, nullptr, const_cast<char* const*>(argv), environ);
+    if(result != 0)
+    {
+        helperPid_ = -1;
+        OPENAUTO_LOG(error) << "[HelperClient] Cannot start " << helperPath_ << ", error: " << result << ".";
+        return;
+    }
+
+    OPENAUTO_LOG(info) << "[HelperClient] Started " << helperPath_ << ", pid: " << helperPid_ << ".";
+}
+
+void HelperClient::complete(Command& command, int status)
+{
+    for(auto& handler : command.handlers)
+    {
+        if(handler)
+        {
+            handler(status);
+        }
+    }
+}
+
+}
+}
+}
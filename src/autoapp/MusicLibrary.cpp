@@ -0,0 +1,374 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <taglib/fileref.h>
+#include <taglib/tag.h>
+#include <f1x/openauto/autoapp/MusicLibrary.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+const QString MusicLibrary::cCacheFileName = "openauto_library.cache";
+const quint32 MusicLibrary::cCacheMagic = 0x4f414d4c;
+const quint32 MusicLibrary::cCacheVersion = 1;
+const QStringList MusicLibrary::cFileFilters = QStringList() << "*.mp3" << "*.flac" << "*.aac" << "*.ogg" << "*.mp4" << "*.mp4a" << "*.wma" << "*.strm";
+const unsigned int MusicLibrary::cMaxWorkers = 4;
+
+bool MusicTrack::operator==(const MusicTrack& other) const
+{
+    return fileName == other.fileName && artist == other.artist && title == other.title
+            && track == other.track && hasTags == other.hasTags && streamUrl == other.streamUrl;
+}
+
+bool MusicTrack::operator!=(const MusicTrack& other) const
+{
+    return !(*this == other);
+}
+
+MusicLibrary::MusicLibrary(QObject* parent)
+    : QObject(parent)
+    , cancelled_(false)
+{
+
+}
+
+MusicLibrary::~MusicLibrary()
+{
+    this->cancel();
+}
+
+bool MusicLibrary::load(const QString& rootPath)
+{
+    this->cancel();
+
+    QStringList albums;
+    std::map<QString, Tracks> tracks;
+    Cache cache;
+
+    const auto start = std::chrono::steady_clock::now();
+    const bool loaded = this->loadCache(rootPath, albums, tracks, cache);
+    if(!loaded)
+    {
+        albums.clear();
+        tracks.clear();
+        cache.clear();
+    }
+    const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+    OPENAUTO_LOG(info) << "[MusicLibrary] Loaded " << albums.size() << " albums, " << cache.size() << " tracks from cache in " << duration.count() << " ms.";
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    rootPath_ = rootPath;
+    albums_ = std::move(albums);
+    tracks_ = std::move(tracks);
+    cache_ = std::move(cache);
+    return loaded;
+}
+
+void MusicLibrary::scan(const QString& rootPath)
+{
+    this->cancel();
+    thread_ = std::thread(&MusicLibrary::run, this, rootPath);
+}
+
+QStringList MusicLibrary::getAlbums() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return albums_;
+}
+
+MusicLibrary::Tracks MusicLibrary::getTracks(const QString& album) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = tracks_.find(album);
+    return it != tracks_.end() ? it->second : Tracks();
+}
+
+void MusicLibrary::cancel()
+{
+    if(thread_.joinable())
+    {
+        cancelled_ = true;
+        thread_.join();
+    }
+
+    cancelled_ = false;
+}
+
+void MusicLibrary::run(QString rootPath)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    QDir directory(rootPath);
+    const QStringList albums = directory.entryList(QStringList() << "*", QDir::AllDirs | QDir::NoDotAndDotDot, QDir::Name);
+
+    Cache cache;
+    bool albumListChanged = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(rootPath_ != rootPath)
+        {
+            rootPath_ = rootPath;
+            tracks_.clear();
+            cache_.clear();
+        }
+
+        albumListChanged = albums_ != albums;
+        albums_ = albums;
+        cache = cache_;
+    }
+
+    if(albumListChanged)
+    {
+        emit albumsChanged(albums);
+    }
+
+    std::atomic<int> nextAlbum(0);
+    std::atomic<size_t> tagsRead(0);
+    std::vector<Cache> scanned(std::max(1u, std::min(std::thread::hardware_concurrency(), cMaxWorkers)));
+    std::vector<std::thread> workers;
+
+    for(size_t i = 0; i < scanned.size(); ++i)
+    {
+        workers.emplace_back([&, i]() {
+            size_t workerTagsRead = 0;
+            for(int index = nextAlbum++; index < albums.size() && !cancelled_; index = nextAlbum++)
+            {
+                const QString& album = albums[index];
+                auto tracks = this->scanAlbum(rootPath, album, cache, scanned[i], workerTagsRead);
+                if(cancelled_)
+                {
+                    break;
+                }
+
+                bool changed = false;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    auto& current = tracks_[album];
+                    changed = current != tracks;
+                    current = std::move(tracks);
+                }
+
+                if(changed)
+                {
+                    emit albumChanged(album);
+                }
+            }
+            tagsRead += workerTagsRead;
+        });
+    }
+
+    for(auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    if(cancelled_)
+    {
+        OPENAUTO_LOG(info) << "[MusicLibrary] Scan of " << rootPath.toStdString() << " cancelled.";
+        return;
+    }
+
+    size_t trackCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cache_.clear();
+        for(const auto& workerCache : scanned)
+        {
+            for(auto it = workerCache.begin(); it != workerCache.end(); ++it)
+            {
+                cache_.insert(it.key(), it.value());
+            }
+        }
+        trackCount = cache_.size();
+
+        for(auto it = tracks_.begin(); it != tracks_.end();)
+        {
+            it = albums_.contains(it->first) ? std::next(it) : tracks_.erase(it);
+        }
+    }
+
+    if(albumListChanged || tagsRead > 0 || trackCount != static_cast<size_t>(cache.size()))
+    {
+        this->saveCache(rootPath);
+    }
+
+    const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    OPENAUTO_LOG(info) << "[MusicLibrary] Scanned " << albums.size() << " albums, " << trackCount << " tracks in " << duration.count()
+                       << " ms, tags read: " << tagsRead << ".";
+
+    emit scanFinished();
+}
+
+MusicLibrary::Tracks MusicLibrary::scanAlbum(const QString& rootPath, const QString& album, const Cache& cache, Cache& scanned, size_t& tagsRead)
+{
+    Tracks tracks;
+
+    QDir directory(rootPath + "/" + album);
+    const QFileInfoList files = directory.entryInfoList(cFileFilters, QDir::Files, QDir::Name);
+
+    for(const auto& file : files)
+    {
+        if(cancelled_)
+        {
+            break;
+        }
+
+        const QString key = album + "/" + file.fileName();
+        const qint64 modified = file.lastModified().toMSecsSinceEpoch();
+
+        auto it = cache.find(key);
+        if(it != cache.end() && it->size == file.size() && it->modified == modified)
+        {
+            tracks.push_back(it->track);
+            scanned.insert(key, *it);
+            continue;
+        }
+
+        CacheEntry entry;
+        entry.size = file.size();
+        entry.modified = modified;
+        entry.track = readTrack(file.filePath(), file.fileName());
+        ++tagsRead;
+
+        tracks.push_back(entry.track);
+        scanned.insert(key, entry);
+    }
+
+    return tracks;
+}
+
+MusicTrack MusicLibrary::readTrack(const QString& path, const QString& fileName)
+{
+    MusicTrack track{fileName, QString(), QString(), 0, false, QString()};
+
+    if(fileName.endsWith(".strm"))
+    {
+        QFile file(path);
+        if(file.open(QIODevice::ReadOnly))
+        {
+            track.streamUrl = QString::fromUtf8(file.readAll()).trimmed();
+        }
+
+        return track;
+    }
+
+    TagLib::FileRef file(path.toUtf8().constData(), false);
+    if(!file.isNull() && file.tag() != nullptr)
+    {
+        track.artist = QString::fromStdWString(file.tag()->artist().toCWString());
+        track.title = QString::fromStdWString(file.tag()->title().toCWString());
+        track.track = file.tag()->track();
+        track.hasTags = true;
+    }
+
+    return track;
+}
+
+bool MusicLibrary::loadCache(const QString& rootPath, QStringList& albums, std::map<QString, Tracks>& tracks, Cache& cache) const
+{
+    QFile file(cCacheFileName);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString cachedRootPath;
+    stream >> magic >> version >> cachedRootPath;
+
+    if(magic != cCacheMagic || version != cCacheVersion || cachedRootPath != rootPath)
+    {
+        return false;
+    }
+
+    stream >> albums;
+
+    quint32 count = 0;
+    stream >> count;
+    for(quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i)
+    {
+        QString album;
+        CacheEntry entry;
+        quint32 trackNumber = 0;
+        stream >> album >> entry.size >> entry.modified >> entry.track.fileName >> entry.track.artist >> entry.track.title
+               >> trackNumber >> entry.track.hasTags >> entry.track.streamUrl;
+        entry.track.track = trackNumber;
+
+        tracks[album].push_back(entry.track);
+        cache.insert(album + "/" + entry.track.fileName, entry);
+    }
+
+    return stream.status() == QDataStream::Ok;
+}
+
+void MusicLibrary::saveCache(const QString& rootPath) const
+{
+    QSaveFile file(cCacheFileName);
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        OPENAUTO_LOG(error) << "[MusicLibrary] Cannot open " << cCacheFileName.toStdString() << " for writing.";
+        return;
+    }
+
+    QDataStream stream(&file);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        quint32 count = 0;
+        for(const auto& album : tracks_)
+        {
+            count += album.second.size();
+        }
+
+        stream << cCacheMagic << cCacheVersion << rootPath << albums_ << count;
+
+        for(const auto& album : tracks_)
+        {
+            for(const auto& track : album.second)
+            {
+                const auto& entry = cache_[album.first + "/" + track.fileName];
+                stream << album.first << entry.size << entry.modified << track.fileName << track.artist << track.title
+                       << static_cast<quint32>(track.track) << track.hasTags << track.streamUrl;
+            }
+        }
+    }
+
+    if(!file.commit())
+    {
+        OPENAUTO_LOG(error) << "[MusicLibrary] Cannot write " << cCacheFileName.toStdString() << ".";
+    }
+}
+
+}
+}
+}
@@ -0,0 +1,582 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <linux/neighbour.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <f1x/openauto/autoapp/NetworkMonitor.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+const char* const NetworkMonitor::cWirelessInterface = "wlan0";
+const char* const NetworkMonitor::cHotspotStatePath = "/tmp/hotspot_active";
+const char* const NetworkMonitor::cWifiSsidPath = "/tmp/wifi_ssid";
+const char* const NetworkMonitor::cWirelessGatewayPath = "/tmp/gateway_wlan0";
+const char* const NetworkMonitor::cHostapdConfigPath = "/etc/hostapd/hostapd.conf";
+const size_t NetworkMonitor::cBufferSize = 32768;
+
+NetworkMonitor::NetworkMonitor(QObject* parent)
+    : QObject(parent)
+    , socket_(-1)
+    , eventFd_(-1)
+    , sequence_(0)
+    , synchronising_(false)
+    , refreshRequested_(false)
+    , stopping_(false)
+    , buffer_(cBufferSize)
+    , hotspotActive_(false)
+{
+    qRegisterMetaType<NetworkSnapshot>("f1x::openauto::autoapp::NetworkSnapshot");
+}
+
+NetworkMonitor::~NetworkMonitor()
+{
+    this->stop();
+}
+
+bool NetworkMonitor::start()
+{
+    socket_ = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if(socket_ < 0)
+    {
+        OPENAUTO_LOG(error) << "[NetworkMonitor] Cannot open netlink socket, errno: " << errno;
+        return false;
+    }
+
+    sockaddr_nl address;
+    std::memset(&address, 0, sizeof(address));
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV4_ROUTE | RTMGRP_NEIGH;
+
+    if(bind(socket_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0)
+    {
+        OPENAUTO_LOG(error) << "[NetworkMonitor] Cannot bind netlink socket, errno: " << errno;
+        this->stop();
+        return false;
+    }
+
+    eventFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if(eventFd_ < 0)
+    {
+        OPENAUTO_LOG(error) << "[NetworkMonitor] Cannot create eventfd, errno: " << errno;
+        this->stop();
+        return false;
+    }
+
+    if(!this->synchronise())
+    {
+        this->stop();
+        return false;
+    }
+
+    this->publish();
+    OPENAUTO_LOG(info) << "[NetworkMonitor] Watching " << links_.size() << " interfaces.";
+    thread_ = std::thread(&NetworkMonitor::run, this);
+    return true;
+}
+
+void NetworkMonitor::stop()
+{
+    if(thread_.joinable())
+    {
+        stopping_ = true;
+        this->wake();
+        thread_.join();
+    }
+
+    if(eventFd_ >= 0)
+    {
+        close(eventFd_);
+        eventFd_ = -1;
+    }
+
+    if(socket_ >= 0)
+    {
+        close(socket_);
+        socket_ = -1;
+    }
+}
+
+void NetworkMonitor::refresh()
+{
+    refreshRequested_ = true;
+    this->wake();
+}
+
+NetworkSnapshot NetworkMonitor::getSnapshot() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return snapshot_;
+}
+
+void NetworkMonitor::wake()
+{
+    if(eventFd_ >= 0)
+    {
+        const uint64_t value = 1;
+        if(write(eventFd_, &value, sizeof(value)) < 0 && errno != EAGAIN)
+        {
+            OPENAUTO_LOG(error) << "[NetworkMonitor] Cannot wake worker, errno: " << errno;
+        }
+    }
+}
+
+void NetworkMonitor::run()
+{
+    while(!stopping_)
+    {
+        pollfd descriptors[2];
+        descriptors[0].fd = eventFd_;
+        descriptors[0].events = POLLIN;
+        descriptors[0].revents = 0;
+        descriptors[1].fd = socket_;
+        descriptors[1].events = POLLIN;
+        descriptors[1].revents = 0;
+
+        if(poll(descriptors, 2, -1) < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+
+            OPENAUTO_LOG(error) << "[NetworkMonitor] poll failed, errno: " << errno;
+            break;
+        }
+
+        if(descriptors[0].revents & POLLIN)
+        {
+            uint64_t value = 0;
+            if(read(eventFd_, &value, sizeof(value)) < 0 && errno != EAGAIN)
+            {
+                OPENAUTO_LOG(error) << "[NetworkMonitor] Cannot read eventfd, errno: " << errno;
+            }
+        }
+
+        if(stopping_)
+        {
+            break;
+        }
+
+        bool overrun = false;
+        if(descriptors[1].revents & POLLIN)
+        {
+            while(true)
+            {
+                const ssize_t size = recv(socket_, buffer_.data(), buffer_.size(), MSG_DONTWAIT);
+                if(size < 0)
+                {
+                    if(errno == ENOBUFS)
+                    {
+                        overrun = true;
+                        continue;
+                    }
+                    else if(errno == EINTR)
+                    {
+                        continue;
+                    }
+
+                    break;
+                }
+
+                this->process(buffer_.data(), size, 0);
+            }
+        }
+
+        if(overrun)
+        {
+            OPENAUTO_LOG(warning) << "[NetworkMonitor] Netlink events lost, resynchronising.";
+            this->synchronise();
+        }
+
+        if(refreshRequested_.exchange(false))
+        {
+            this->readWirelessState();
+        }
+
+        this->publish();
+    }
+}
+
+bool NetworkMonitor::synchronise()
+{
+    links_.clear();
+    addresses_.clear();
+    gateways_.clear();
+    neighbours_.clear();
+
+    synchronising_ = true;
+    const bool result = this->dump(RTM_GETLINK) && this->dump(RTM_GETADDR) && this->dump(RTM_GETROUTE) && this->dump(RTM_GETNEIGH);
+    synchronising_ = false;
+
+    this->readWirelessState();
+    return result;
+}
+
+bool NetworkMonitor::dump(int type)
+{
+    struct
+    {
+        nlmsghdr header;
+        rtgenmsg message;
+    } request;
+
+    std::memset(&request, 0, sizeof(request));
+    request.header.nlmsg_len = NLMSG_LENGTH(sizeof(rtgenmsg));
+    request.header.nlmsg_type = type;
+    request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    request.header.nlmsg_seq = ++sequence_;
+    request.message.rtgen_family = type == RTM_GETLINK ? AF_UNSPEC : AF_INET;
+
+    sockaddr_nl kernel;
+    std::memset(&kernel, 0, sizeof(kernel));
+    kernel.nl_family = AF_NETLINK;
+
+    if(sendto(socket_, &request, request.header.nlmsg_len, 0, reinterpret_cast<sockaddr*>(&kernel), sizeof(kernel)) < 0)
+    {
+        OPENAUTO_LOG(error) << "[NetworkMonitor] Cannot request dump " << type << ", errno: " << errno;
+        return false;
+    }
+
+    while(true)
+    {
+        const ssize_t size = recv(socket_, buffer_.data(), buffer_.size(), 0);
+        if(size < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+
+            OPENAUTO_LOG(error) << "[NetworkMonitor] Cannot receive dump " << type << ", errno: " << errno;
+            return false;
+        }
+
+        if(this->process(buffer_.data(), size, sequence_))
+        {
+            return true;
+        }
+    }
+}
+
+bool NetworkMonitor::process(const char* buffer, size_t size, uint32_t sequence)
+{
+    bool finished = false;
+    int length = static_cast<int>(size);
+
+    for(auto header = reinterpret_cast<const nlmsghdr*>(buffer); NLMSG_OK(header, length); header = NLMSG_NEXT(header, length))
+    {
+        switch(header->nlmsg_type)
+        {
+        case NLMSG_DONE:
+            finished = finished || (sequence != 0 && header->nlmsg_seq == sequence);
+            break;
+        case NLMSG_ERROR:
+            if(sequence != 0 && header->nlmsg_seq == sequence)
+            {
+                OPENAUTO_LOG(error) << "[NetworkMonitor] Dump failed, error: " << -static_cast<const nlmsgerr*>(NLMSG_DATA(header))->error;
+                finished = true;
+            }
+            break;
+        case RTM_NEWLINK:
+        case RTM_DELLINK:
+            this->handleLink(header);
+            break;
+        case RTM_NEWADDR:
+        case RTM_DELADDR:
+            this->handleAddress(header);
+            break;
+        case RTM_NEWROUTE:
+        case RTM_DELROUTE:
+            this->handleRoute(header);
+            break;
+        case RTM_NEWNEIGH:
+        case RTM_DELNEIGH:
+            this->handleNeighbour(header);
+            break;
+        default:
+            break;
+        }
+    }
+
+    return finished;
+}
+
+void NetworkMonitor::handleLink(const nlmsghdr* header)
+{
+    const auto message = static_cast<const ifinfomsg*>(NLMSG_DATA(header));
+    if(header->nlmsg_type == RTM_DELLINK)
+    {
+        links_.erase(message->ifi_index);
+        addresses_.erase(message->ifi_index);
+        gateways_.erase(message->ifi_index);
+        neighbours_.erase(message->ifi_index);
+        return;
+    }
+
+    const rtattr* attributes[IFLA_MAX + 1];
+    parseAttributes(header, sizeof(ifinfomsg), attributes, IFLA_MAX);
+
+    auto& link = links_[message->ifi_index];
+    if(attributes[IFLA_IFNAME] != nullptr)
+    {
+        link.name = static_cast<const char*>(RTA_DATA(attributes[IFLA_IFNAME]));
+    }
+    link.up = (message->ifi_flags & IFF_UP) != 0;
+}
+
+void NetworkMonitor::handleAddress(const nlmsghdr* header)
+{
+    const auto message = static_cast<const ifaddrmsg*>(NLMSG_DATA(header));
+    if(message->ifa_family != AF_INET)
+    {
+        return;
+    }
+
+    const rtattr* attributes[IFA_MAX + 1];
+    parseAttributes(header, sizeof(ifaddrmsg), attributes, IFA_MAX);
+
+    const rtattr* local = attributes[IFA_LOCAL] != nullptr ? attributes[IFA_LOCAL] : attributes[IFA_ADDRESS];
+    if(local == nullptr)
+    {
+        return;
+    }
+
+    const auto address = toString(AF_INET, RTA_DATA(local));
+    auto& addresses = addresses_[message->ifa_index];
+    auto it = std::find_if(addresses.begin(), addresses.end(), [&address](const Address& entry) { return entry.address == address; });
+
+    if(header->nlmsg_type == RTM_DELADDR)
+    {
+        if(it != addresses.end())
+        {
+            addresses.erase(it);
+        }
+    }
+    else if(it != addresses.end())
+    {
+        it->prefixLength = message->ifa_prefixlen;
+    }
+    else
+    {
+        addresses.push_back({address, message->ifa_prefixlen});
+    }
+}
+
+void NetworkMonitor::handleRoute(const nlmsghdr* header)
+{
+    const auto message = static_cast<const rtmsg*>(NLMSG_DATA(header));
+    if(message->rtm_family != AF_INET || message->rtm_dst_len != 0 || message->rtm_type != RTN_UNICAST)
+    {
+        return;
+    }
+
+    const rtattr* attributes[RTA_MAX + 1];
+    parseAttributes(header, sizeof(rtmsg), attributes, RTA_MAX);
+
+    const uint32_t table = attributes[RTA_TABLE] != nullptr ? *static_cast<const uint32_t*>(RTA_DATA(attributes[RTA_TABLE])) : message->rtm_table;
+    if(table != RT_TABLE_MAIN || attributes[RTA_OIF] == nullptr || attributes[RTA_GATEWAY] == nullptr)
+    {
+        return;
+    }
+
+    const int index = *static_cast<const int*>(RTA_DATA(attributes[RTA_OIF]));
+    const auto gateway = toString(AF_INET, RTA_DATA(attributes[RTA_GATEWAY]));
+
+    if(header->nlmsg_type == RTM_NEWROUTE)
+    {
+        gateways_[index] = gateway;
+    }
+    else if(gateways_.count(index) != 0 && gateways_[index] == gateway)
+    {
+        gateways_.erase(index);
+    }
+}
+
+void NetworkMonitor::handleNeighbour(const nlmsghdr* header)
+{
+    const auto message = static_cast<const ndmsg*>(NLMSG_DATA(header));
+    if(message->ndm_family != AF_INET)
+    {
+        return;
+    }
+
+    const rtattr* attributes[NDA_MAX + 1];
+    parseAttributes(header, sizeof(ndmsg), attributes, NDA_MAX);
+    if(attributes[NDA_DST] == nullptr)
+    {
+        return;
+    }
+
+    const auto address = toString(AF_INET, RTA_DATA(attributes[NDA_DST]));
+    const bool present = header->nlmsg_type == RTM_NEWNEIGH && (message->ndm_state & (NUD_REACHABLE | NUD_STALE | NUD_DELAY | NUD_PROBE | NUD_PERMANENT)) != 0;
+
+    if(!present)
+    {
+        neighbours_[message->ndm_ifindex].erase(address);
+    }
+    else if(neighbours_[message->ndm_ifindex].insert(address).second && !synchronising_ && hotspotActive_
+            && links_.count(message->ndm_ifindex) != 0 && links_[message->ndm_ifindex].name == cWirelessInterface)
+    {
+        appearedClients_.append(QString::fromStdString(address));
+    }
+}
+
+void NetworkMonitor::readWirelessState()
+{
+    hotspotActive_ = access(cHotspotStatePath, F_OK) == 0;
+
+    if(hotspotActive_)
+    {
+        ssid_.clear();
+
+        std::ifstream config(cHostapdConfigPath);
+        std::string line;
+        while(std::getline(config, line))
+        {
+            if(line.compare(0, 5, "ssid=") == 0)
+            {
+                ssid_ = line.substr(5);
+                break;
+            }
+        }
+    }
+    else
+    {
+        ssid_ = readFile(cWifiSsidPath);
+    }
+
+    wirelessGateway_ = readFile(cWirelessGatewayPath);
+}
+
+void NetworkMonitor::publish()
+{
+    NetworkSnapshot snapshot;
+    snapshot.hotspotActive = hotspotActive_;
+    snapshot.ssid = QString::fromStdString(ssid_).simplified();
+
+    for(const auto& link : links_)
+    {
+        NetworkInterfaceState state;
+        state.up = link.second.up;
+
+        const auto addresses = addresses_.find(link.first);
+        if(addresses != addresses_.end() && !addresses->second.empty())
+        {
+            state.address = QString::fromStdString(addresses->second.front().address);
+            state.netmask = toNetmask(addresses->second.front().prefixLength);
+        }
+
+        const auto gateway = gateways_.find(link.first);
+        if(gateway != gateways_.end())
+        {
+            state.gateway = QString::fromStdString(gateway->second);
+        }
+        else if(link.second.name == cWirelessInterface)
+        {
+            state.gateway = QString::fromStdString(wirelessGateway_).simplified();
+        }
+
+        const auto neighbours = neighbours_.find(link.first);
+        if(hotspotActive_ && link.second.name == cWirelessInterface && neighbours != neighbours_.end())
+        {
+            for(const auto& neighbour : neighbours->second)
+            {
+                snapshot.hotspotClients.append(QString::fromStdString(neighbour));
+            }
+        }
+
+        snapshot.interfaces.insert(QString::fromStdString(link.second.name), state);
+    }
+
+    bool changed = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        changed = !(snapshot_ == snapshot);
+        if(changed)
+        {
+            snapshot_ = snapshot;
+        }
+    }
+
+    if(changed)
+    {
+        emit snapshotChanged(snapshot);
+    }
+
+    for(const auto& address : appearedClients_)
+    {
+        OPENAUTO_LOG(info) << "[NetworkMonitor] Hotspot client appeared: " << address.toStdString();
+        emit hotspotClientAppeared(address);
+    }
+
+    appearedClients_.clear();
+}
+
+void NetworkMonitor::parseAttributes(const nlmsghdr* header, size_t headerSize, const rtattr* attributes[], int maxType)
+{
+    std::fill(attributes, attributes + maxType + 1, nullptr);
+
+    int length = static_cast<int>(header->nlmsg_len) - static_cast<int>(NLMSG_LENGTH(headerSize));
+    for(auto attribute = reinterpret_cast<const rtattr*>(static_cast<const char*>(NLMSG_DATA(header)) + NLMSG_ALIGN(headerSize));
+        RTA_OK(attribute, length); attribute = RTA_NEXT(attribute, length))
+    {
+        if(attribute->rta_type <= maxType)
+        {
+            attributes[attribute->rta_type] = attribute;
+        }
+    }
+}
+
+std::string NetworkMonitor::readFile(const char* path)
+{
+    std::ifstream file(path);
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return content;
+}
+
+std::string NetworkMonitor::toString(int family, const void* address)
+{
+    char buffer[INET6_ADDRSTRLEN];
+    return inet_ntop(family, address, buffer, sizeof(buffer)) != nullptr ? buffer : std::string();
+}
+
+QString NetworkMonitor::toNetmask(int prefixLength)
+{
+    const uint32_t mask = prefixLength <= 0 ? 0 : htonl(~uint32_t(0) << (32 - std::min(prefixLength, 32)));
+    return QString::fromStdString(toString(AF_INET, &mask));
+}
+
+}
+}
+}
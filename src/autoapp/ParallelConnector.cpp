@@ -0,0 +1,203 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <f1x/openauto/autoapp/ParallelConnector.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+ParallelConnector::ParallelConnector(boost::asio::io_service& ioService, aasdk::tcp::ITCPWrapper& tcpWrapper, common::TCPTuning tcpTuning, uint16_t port, size_t staggerDelay, size_t attemptTimeout)
+    : ioService_(ioService)
+    , strand_(ioService)
+    , tcpWrapper_(tcpWrapper)
+    , tcpTuning_(std::move(tcpTuning))
+    , port_(port)
+    , staggerDelay_(staggerDelay)
+    , attemptTimeout_(attemptTimeout)
+    , pendingAttempts_(0)
+{
+
+}
+
+void ParallelConnector::connect(std::vector<std::string> addresses, Handler handler)
+{
+    strand_.dispatch([this, self = this->shared_from_this(), addresses = std::move(addresses), handler = std::move(handler)]() mutable {
+        handler_ = std::move(handler);
+        startTimestamp_ = std::chrono::steady_clock::now();
+        lastError_ = boost::asio::error::host_not_found;
+
+        for(const auto& address : addresses)
+        {
+            attempts_.push_back(Attempt{address, std::make_shared<boost::asio::ip::tcp::socket>(ioService_), std::make_shared<boost::asio::deadline_timer>(ioService_), false});
+        }
+
+        pendingAttempts_ = attempts_.size();
+        if(pendingAttempts_ == 0)
+        {
+            auto handler = std::move(handler_);
+            handler(lastError_, std::string(), nullptr);
+            return;
+        }
+
+        OPENAUTO_LOG(info) << "[ParallelConnector] connecting to " << attempts_.size() << " candidate(s).";
+
+        for(size_t i = 0; i < attempts_.size(); ++i)
+        {
+            if(i == 0)
+            {
+                this->startAttempt(i);
+            }
+            else
+            {
+                attempts_[i].timer->expires_from_now(boost::posix_time::milliseconds(staggerDelay_ * i));
+                attempts_[i].timer->async_wait(strand_.wrap([this, self = this->shared_from_this(), i](const boost::system::error_code& error) {
+                    if(!error && !attempts_[i].finished)
+                    {
+                        this->startAttempt(i);
+                    }
+                }));
+            }
+        }
+    });
+}
+
+void ParallelConnector::cancel()
+{
+    strand_.dispatch([this, self = this->shared_from_this()]() {
+        this->closeAll();
+        handler_ = nullptr;
+    });
+}
+
+void ParallelConnector::startAttempt(size_t index)
+{
+    auto& attempt = attempts_[index];
+
+    try
+    {
+        this->openSocket(attempt);
+        tcpWrapper_.asyncConnect(*attempt.socket, attempt.address, port_,
+                                 strand_.wrap(std::bind(&ParallelConnector::onConnect, this->shared_from_this(), std::placeholders::_1, index)));
+    }
+    catch(const boost::system::system_error& se)
+    {
+        this->finishAttempt(index, se.code());
+        return;
+    }
+
+    attempt.timer->expires_from_now(boost::posix_time::milliseconds(attemptTimeout_));
+    attempt.timer->async_wait(strand_.wrap(std::bind(&ParallelConnector::onTimeout, this->shared_from_this(), std::placeholders::_1, index)));
+}
+
+void ParallelConnector::openSocket(Attempt& attempt)
+{
+    boost::system::error_code ec;
+    const auto address = boost::asio::ip::address::from_string(attempt.address, ec);
+    if(ec)
+    {
+        return;
+    }
+
+    attempt.socket->open(address.is_v6() ? boost::asio::ip::tcp::v6() : boost::asio::ip::tcp::v4());
+
+    for(const auto& failure : common::TCPTuner::applyBuffers(attempt.socket->native_handle(), tcpTuning_))
+    {
+        OPENAUTO_LOG(warning) << "[ParallelConnector] failed to set " << failure << " for " << attempt.address << ".";
+    }
+}
+
+void ParallelConnector::onConnect(const boost::system::error_code& error, size_t index)
+{
+    auto& attempt = attempts_[index];
+    if(attempt.finished)
+    {
+        return;
+    }
+
+    if(!error && handler_ != nullptr)
+    {
+        attempt.finished = true;
+        attempt.timer->cancel();
+
+        const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTimestamp_);
+        OPENAUTO_LOG(info) << "[ParallelConnector] connected to " << attempt.address << " after " << duration.count() << " ms.";
+
+        auto socket = std::move(attempt.socket);
+        auto handler = std::move(handler_);
+        handler_ = nullptr;
+        this->closeAll();
+        handler(error, attempt.address, std::move(socket));
+    }
+    else
+    {
+        this->finishAttempt(index, error ? error : boost::asio::error::operation_aborted);
+    }
+}
+
+void ParallelConnector::onTimeout(const boost::system::error_code& error, size_t index)
+{
+    if(!error && !attempts_[index].finished)
+    {
+        OPENAUTO_LOG(info) << "[ParallelConnector] " << attempts_[index].address << " timed out.";
+        this->finishAttempt(index, boost::asio::error::timed_out);
+    }
+}
+
+void ParallelConnector::finishAttempt(size_t index, const boost::system::error_code& error)
+{
+    auto& attempt = attempts_[index];
+    attempt.finished = true;
+    attempt.timer->cancel();
+    tcpWrapper_.close(*attempt.socket);
+
+    lastError_ = error;
+    --pendingAttempts_;
+
+    OPENAUTO_LOG(info) << "[ParallelConnector] " << attempt.address << " failed: " << error.message();
+
+    if(pendingAttempts_ == 0 && handler_ != nullptr)
+    {
+        auto handler = std::move(handler_);
+        handler_ = nullptr;
+        handler(lastError_, std::string(), nullptr);
+    }
+}
+
+void ParallelConnector::closeAll()
+{
+    for(auto& attempt : attempts_)
+    {
+        if(!attempt.finished)
+        {
+            attempt.finished = true;
+            attempt.timer->cancel();
+            tcpWrapper_.close(*attempt.socket);
+        }
+    }
+
+    pendingAttempts_ = 0;
+}
+
+}
+}
+}
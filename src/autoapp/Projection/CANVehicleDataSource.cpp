@@ -0,0 +1,432 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <cmath>
+#include <poll.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/eventfd.h>
+#include <linux/can/raw.h>
+#include <boost/property_tree/ini_parser.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/autoapp/Projection/IVehicleDataSourceEventHandler.hpp>
+#include <f1x/openauto/autoapp/Projection/CANVehicleDataSource.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace projection
+{
+
+const std::string CANVehicleDataSource::cSpeedSection = "Speed";
+const std::string CANVehicleDataSource::cGearSection = "Gear";
+const std::string CANVehicleDataSource::cParkingBrakeSection = "ParkingBrake";
+const std::string CANVehicleDataSource::cHeadlightsSection = "Headlights";
+
+CANVehicleDataSource::CANVehicleDataSource(std::string interfaceName, std::string decodingTable, std::chrono::milliseconds publishInterval)
+    : interfaceName_(std::move(interfaceName))
+    , decodingTable_(std::move(decodingTable))
+    , socket_(-1)
+    , wakeupFd_(-1)
+    , eventHandler_(nullptr)
+    , publishInterval_(publishInterval)
+    , framesCount_(0)
+    , publishCount_(0)
+{
+    this->loadDecodingTable();
+}
+
+CANVehicleDataSource::~CANVehicleDataSource()
+{
+    this->stop();
+}
+
+void CANVehicleDataSource::start(IVehicleDataSourceEventHandler& eventHandler)
+{
+    if(thread_.joinable())
+    {
+        return;
+    }
+
+    if(signals_.empty() || !this->open())
+    {
+        OPENAUTO_LOG(warning) << "[CANVehicleDataSource] not started, interface: " << interfaceName_;
+        this->close();
+        return;
+    }
+
+    OPENAUTO_LOG(info) << "[CANVehicleDataSource] start, interface: " << interfaceName_
+                       << ", signals: " << signals_.size()
+                       << ", publish interval: " << publishInterval_.count() << "ms.";
+
+    eventHandler_ = &eventHandler;
+    pending_ = VehicleData();
+    published_ = VehicleData();
+    lastPublish_ = std::chrono::steady_clock::time_point();
+    framesCount_ = 0;
+    publishCount_ = 0;
+    thread_ = std::thread(&CANVehicleDataSource::run, this);
+}
+
+void CANVehicleDataSource::stop()
+{
+    if(!thread_.joinable())
+    {
+        return;
+    }
+
+    uint64_t value = 1;
+    if(::write(wakeupFd_, &value, sizeof(value)) != sizeof(value))
+    {
+        OPENAUTO_LOG(error) << "[CANVehicleDataSource] failed to wake up reader thread.";
+    }
+
+    thread_.join();
+    this->close();
+    eventHandler_ = nullptr;
+
+    OPENAUTO_LOG(info) << "[CANVehicleDataSource] stop, frames: " << framesCount_ << ", updates published: " << publishCount_;
+}
+
+CANVehicleDataSource::SensorTypes CANVehicleDataSource::getSupportedSensors() const
+{
+    SensorTypes sensorTypes;
+
+    for(const auto& signal : signals_)
+    {
+        switch(signal.type)
+        {
+        case SignalType::SPEED:
+            sensorTypes.push_back(aasdk::proto::enums::SensorType::CAR_SPEED);
+            break;
+
+        case SignalType::GEAR:
+            sensorTypes.push_back(aasdk::proto::enums::SensorType::GEAR);
+            break;
+
+        case SignalType::PARKING_BRAKE:
+            sensorTypes.push_back(aasdk::proto::enums::SensorType::PARKING_BRAKE);
+            break;
+
+        case SignalType::HEADLIGHTS:
+            sensorTypes.push_back(aasdk::proto::enums::SensorType::NIGHT_DATA);
+            break;
+        }
+    }
+
+    return sensorTypes;
+}
+
+void CANVehicleDataSource::loadDecodingTable()
+{
+    boost::property_tree::ptree iniConfig;
+
+    try
+    {
+        boost::property_tree::ini_parser::read_ini(decodingTable_, iniConfig);
+
+        this->readSignal(iniConfig, cSpeedSection, SignalType::SPEED);
+        this->readSignal(iniConfig, cGearSection, SignalType::GEAR);
+        this->readSignal(iniConfig, cParkingBrakeSection, SignalType::PARKING_BRAKE);
+        this->readSignal(iniConfig, cHeadlightsSection, SignalType::HEADLIGHTS);
+    }
+    catch(const std::exception& e)
+    {
+        OPENAUTO_LOG(warning) << "[CANVehicleDataSource] failed to read decoding table: " << decodingTable_
+                              << ", error: " << e.what();
+        signals_.clear();
+    }
+}
+
+void CANVehicleDataSource::readSignal(const boost::property_tree::ptree& iniConfig, const std::string& section, SignalType type)
+{
+    auto child = iniConfig.get_child_optional(section);
+    if(!child)
+    {
+        return;
+    }
+
+    Signal signal;
+    signal.type = type;
+    signal.frameId = static_cast<canid_t>(std::stoul(child->get<std::string>("FrameId"), nullptr, 0));
+    if(signal.frameId > CAN_SFF_MASK)
+    {
+        signal.frameId = (signal.frameId & CAN_EFF_MASK) | CAN_EFF_FLAG;
+    }
+
+    signal.startBit = child->get<uint32_t>("StartBit", 0);
+    signal.length = std::max<uint32_t>(1, std::min<uint32_t>(child->get<uint32_t>("Length", 1), 64));
+    signal.bigEndian = child->get<std::string>("ByteOrder", "little") == "big";
+    signal.isSigned = child->get<bool>("Signed", false);
+    signal.scale = child->get<double>("Scale", 1.0);
+    signal.offset = child->get<double>("Offset", 0.0);
+
+    if(type == SignalType::GEAR)
+    {
+        const std::map<std::string, aasdk::proto::enums::Gear::Enum> gears = {
+            {"Neutral", aasdk::proto::enums::Gear::NEUTRAL},
+            {"Gear1", aasdk::proto::enums::Gear::GEAR_1},
+            {"Gear2", aasdk::proto::enums::Gear::GEAR_2},
+            {"Gear3", aasdk::proto::enums::Gear::GEAR_3},
+            {"Gear4", aasdk::proto::enums::Gear::GEAR_4},
+            {"Gear5", aasdk::proto::enums::Gear::GEAR_5},
+            {"Gear6", aasdk::proto::enums::Gear::GEAR_6},
+            {"Drive", aasdk::proto::enums::Gear::DRIVE},
+            {"Park", aasdk::proto::enums::Gear::PARK},
+            {"Reverse", aasdk::proto::enums::Gear::REVERSE}
+        };
+
+        for(const auto& gear : gears)
+        {
+            auto value = child->get_optional<int64_t>(gear.first);
+            if(value)
+            {
+                signal.gearValues[*value] = gear.second;
+            }
+        }
+    }
+
+    OPENAUTO_LOG(info) << "[CANVehicleDataSource] signal: " << section
+                       << ", frame id: 0x" << std::hex << (signal.frameId & CAN_EFF_MASK) << std::dec
+                       << ", start bit: " << signal.startBit
+                       << ", length: " << signal.length;
+
+    signals_.push_back(std::move(signal));
+}
+
+bool CANVehicleDataSource::open()
+{
+    socket_ = ::socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, CAN_RAW);
+    if(socket_ < 0)
+    {
+        OPENAUTO_LOG(error) << "[CANVehicleDataSource] failed to create socket, errno: " << errno;
+        return false;
+    }
+
+    struct ifreq ifr;
+    std::memset(&ifr, 0, sizeof(ifr));
+    std::strncpy(ifr.ifr_name, interfaceName_.c_str(), IFNAMSIZ - 1);
+    if(::ioctl(socket_, SIOCGIFINDEX, &ifr) < 0)
+    {
+        OPENAUTO_LOG(error) << "[CANVehicleDataSource] unknown interface: " << interfaceName_;
+        return false;
+    }
+
+    std::vector<struct can_filter> filters;
+    for(const auto& signal : signals_)
+    {
+        struct can_filter filter;
+        filter.can_id = signal.frameId;
+        filter.can_mask = CAN_EFF_FLAG | CAN_RTR_FLAG | ((signal.frameId & CAN_EFF_FLAG) ? CAN_EFF_MASK : CAN_SFF_MASK);
+        filters.push_back(filter);
+    }
+
+    if(::setsockopt(socket_, SOL_CAN_RAW, CAN_RAW_FILTER, filters.data(), filters.size() * sizeof(struct can_filter)) < 0)
+    {
+        OPENAUTO_LOG(error) << "[CANVehicleDataSource] failed to set frame filters, errno: " << errno;
+        return false;
+    }
+
+    struct sockaddr_can address;
+    std::memset(&address, 0, sizeof(address));
+    address.can_family = AF_CAN;
+    address.can_ifindex = ifr.ifr_ifindex;
+    if(::bind(socket_, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) < 0)
+    {
+        OPENAUTO_LOG(error) << "[CANVehicleDataSource] failed to bind socket, errno: " << errno;
+        return false;
+    }
+
+    wakeupFd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    return wakeupFd_ >= 0;
+}
+
+void CANVehicleDataSource::close()
+{
+    if(socket_ >= 0)
+    {
+        ::close(socket_);
+        socket_ = -1;
+    }
+
+    if(wakeupFd_ >= 0)
+    {
+        ::close(wakeupFd_);
+        wakeupFd_ = -1;
+    }
+}
+
+void CANVehicleDataSource::run()
+{
+    bool dirty = false;
+
+    while(true)
+    {
+        int timeout = -1;
+        if(dirty)
+        {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(lastPublish_ + publishInterval_ - std::chrono::steady_clock::now());
+            timeout = std::max<int>(0, remaining.count());
+        }
+
+        struct pollfd fds[2] = {{socket_, POLLIN, 0}, {wakeupFd_, POLLIN, 0}};
+        if(::poll(fds, 2, timeout) < 0 && errno != EINTR)
+        {
+            OPENAUTO_LOG(error) << "[CANVehicleDataSource] poll failed, errno: " << errno;
+            break;
+        }
+
+        if(fds[1].revents & POLLIN)
+        {
+            break;
+        }
+
+        if(fds[0].revents & POLLIN)
+        {
+            this->readFrames();
+            dirty = true;
+        }
+        else if(fds[0].revents & (POLLERR | POLLHUP | POLLNVAL))
+        {
+            OPENAUTO_LOG(error) << "[CANVehicleDataSource] socket error, interface: " << interfaceName_;
+            break;
+        }
+
+        if(dirty && std::chrono::steady_clock::now() >= lastPublish_ + publishInterval_)
+        {
+            this->publish();
+            dirty = false;
+        }
+    }
+}
+
+void CANVehicleDataSource::readFrames()
+{
+    struct can_frame frame;
+
+    while(::read(socket_, &frame, sizeof(frame)) == sizeof(frame))
+    {
+        ++framesCount_;
+        this->decode(frame);
+    }
+}
+
+void CANVehicleDataSource::decode(const struct can_frame& frame)
+{
+    const canid_t frameId = frame.can_id & (CAN_EFF_FLAG | CAN_EFF_MASK);
+
+    for(const auto& signal : signals_)
+    {
+        if(signal.frameId != frameId || signal.startBit + signal.length > 64)
+        {
+            continue;
+        }
+
+        const int64_t raw = extract(frame, signal);
+        const double value = raw * signal.scale + signal.offset;
+
+        switch(signal.type)
+        {
+        case SignalType::SPEED:
+            pending_.speed = static_cast<int32_t>(std::lround(value));
+            break;
+
+        case SignalType::GEAR:
+            {
+                auto gear = signal.gearValues.find(raw);
+                if(gear != signal.gearValues.end())
+                {
+                    pending_.gear = gear->second;
+                }
+            }
+            break;
+
+        case SignalType::PARKING_BRAKE:
+            pending_.parkingBrake = value != 0;
+            break;
+
+        case SignalType::HEADLIGHTS:
+            pending_.headlights = value != 0;
+            break;
+        }
+    }
+}
+
+void CANVehicleDataSource::publish()
+{
+    VehicleData update;
+
+    if(pending_.speed && pending_.speed != published_.speed)
+    {
+        update.speed = pending_.speed;
+    }
+
+    if(pending_.gear && pending_.gear != published_.gear)
+    {
+        update.gear = pending_.gear;
+    }
+
+    if(pending_.parkingBrake && pending_.parkingBrake != published_.parkingBrake)
+    {
+        update.parkingBrake = pending_.parkingBrake;
+    }
+
+    if(pending_.headlights && pending_.headlights != published_.headlights)
+    {
+        update.headlights = pending_.headlights;
+    }
+
+    lastPublish_ = std::chrono::steady_clock::now();
+
+    if(update.speed || update.gear || update.parkingBrake || update.headlights)
+    {
+        published_ = pending_;
+        ++publishCount_;
+        eventHandler_->onVehicleDataUpdate(update);
+    }
+}
+
+int64_t CANVehicleDataSource::extract(const struct can_frame& frame, const Signal& signal)
+{
+    uint64_t payload = 0;
+    for(uint8_t i = 0; i < frame.can_dlc && i < CAN_MAX_DLEN; ++i)
+    {
+        payload |= static_cast<uint64_t>(frame.data[i]) << (signal.bigEndian ? 56 - i * 8 : i * 8);
+    }
+
+    const uint64_t mask = signal.length >= 64 ? ~0ULL : (1ULL << signal.length) - 1;
+    uint64_t value = (payload >> signal.startBit) & mask;
+
+    if(signal.isSigned && signal.length < 64 && (value & (1ULL << (signal.length - 1))) != 0)
+    {
+        value |= ~mask;
+    }
+
+    return static_cast<int64_t>(value);
+}
+
+}
+}
+}
+}
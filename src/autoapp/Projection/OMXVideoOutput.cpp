@@ -59,6 +59,7 @@ bool OMXVideoOutput::open()
     std::lock_guard<decltype(mutex_)> lock(mutex_);
 
     OPENAUTO_LOG(info) << "[OMXVideoOutput] open.";
+    portSettingsChanged_ = false;
 
     bcm_host_init();
     if(OMX_Init() != OMX_ErrorNone)
@@ -17,6 +17,7 @@
 */
 
 #include <QApplication>
+#include <QThread>
 #include <f1x/openauto/autoapp/Projection/QtAudioInput.hpp>
 #include <f1x/openauto/Common/Log.hpp>
 
@@ -43,7 +44,6 @@ QtAudioInput::QtAudioInput(uint32_t channelCount, uint32_t sampleSize, uint32_t
 
     this->moveToThread(QApplication::instance()->thread());
     connect(this, &QtAudioInput::startRecording, this, &QtAudioInput::onStartRecording, Qt::QueuedConnection);
-    connect(this, &QtAudioInput::stopRecording, this, &QtAudioInput::onStopRecording, Qt::QueuedConnection);
     QMetaObject::invokeMethod(this, "createAudioInput", Qt::BlockingQueuedConnection);
 }
 
@@ -92,7 +92,8 @@ void QtAudioInput::start(StartPromise::Pointer promise)
 
 void QtAudioInput::stop()
 {
-    emit stopRecording();
+    const auto connectionType = QThread::currentThread() == this->thread() ? Qt::DirectConnection : Qt::BlockingQueuedConnection;
+    QMetaObject::invokeMethod(this, "onStopRecording", connectionType);
 }
 
 uint32_t QtAudioInput::getSampleSize() const
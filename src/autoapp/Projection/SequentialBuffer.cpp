@@ -41,6 +41,7 @@ bool SequentialBuffer::open(OpenMode mode)
 {
     std::lock_guard<decltype(mutex_)> lock(mutex_);
 
+    data_.clear();
     return QIODevice::open(mode);
 }
 
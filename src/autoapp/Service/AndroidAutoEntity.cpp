@@ -35,7 +35,8 @@ AndroidAutoEntity::AndroidAutoEntity(boost::asio::io_service& ioService,
                                      aasdk::messenger::IMessenger::Pointer messenger,
                                      configuration::IConfiguration::Pointer configuration,
                                      ServiceList serviceList,
-                                     IPinger::Pointer pinger)
+                                     IPinger::Pointer pinger,
+                                     SessionTimeline::Pointer sessionTimeline)
     : strand_(ioService)
     , cryptor_(std::move(cryptor))
     , transport_(std::move(transport))
@@ -45,6 +46,8 @@ AndroidAutoEntity::AndroidAutoEntity(boost::asio::io_service& ioService,
     , serviceList_(std::move(serviceList))
     , pinger_(std::move(pinger))
     , eventHandler_(nullptr)
+    , sessionTimeline_(std::move(sessionTimeline))
+    , handshakeRound_(0)
 {
 }
 
@@ -59,8 +62,9 @@ void AndroidAutoEntity::start(IAndroidAutoEntityEventHandler& eventHandler)
         OPENAUTO_LOG(info) << "[AndroidAutoEntity] start.";
 
         eventHandler_ = eventHandler;
+        sessionTimeline_->mark("entity start");
         std::for_each(serviceList_.begin(), serviceList_.end(), std::bind(&IService::start, std::placeholders::_1));
-        //this->schedulePing();
+        this->schedulePing();
 
         auto versionRequestPromise = aasdk::channel::SendPromise::defer(strand_);
         versionRequestPromise->then([]() {}, std::bind(&AndroidAutoEntity::onChannelError, this->shared_from_this(), std::placeholders::_1));
@@ -77,10 +81,11 @@ void AndroidAutoEntity::stop()
         try {
             eventHandler_ = nullptr;
             std::for_each(serviceList_.begin(), serviceList_.end(), std::bind(&IService::stop, std::placeholders::_1));
-            //pinger_->cancel();
+            pinger_->cancel();
             messenger_->stop();
             transport_->stop();
             cryptor_->deinit();
+            sessionTimeline_->report(configuration_->getSessionHistorySize());
         } catch (...) {
             OPENAUTO_LOG(info) << "[AndroidAutoEntity] exception in stop.";
         }
@@ -118,6 +123,7 @@ void AndroidAutoEntity::onVersionResponse(uint16_t majorCode, uint16_t minorCode
     OPENAUTO_LOG(info) << "[AndroidAutoEntity] version response, version: " << majorCode
                        << "." << minorCode
                        << ", status: " << status;
+    sessionTimeline_->mark("version response");
 
     if(status == aasdk::proto::enums::VersionResponseStatus::MISMATCH)
     {
@@ -147,6 +153,7 @@ void AndroidAutoEntity::onVersionResponse(uint16_t majorCode, uint16_t minorCode
 void AndroidAutoEntity::onHandshake(const aasdk::common::DataConstBuffer& payload)
 {
     OPENAUTO_LOG(info) << "[AndroidAutoEntity] Handshake, size: " << payload.size;
+    sessionTimeline_->mark("handshake round " + std::to_string(++handshakeRound_));
 
     try
     {
@@ -162,7 +169,9 @@ void AndroidAutoEntity::onHandshake(const aasdk::common::DataConstBuffer& payloa
         }
         else
         {
-            OPENAUTO_LOG(info) << "[AndroidAutoEntity] Auth completed.";
+            const auto handshakeDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - sessionTimeline_->getStartTimestamp());
+            OPENAUTO_LOG(info) << "[AndroidAutoEntity] Auth completed, connect to handshake: " << handshakeDuration.count() << " ms.";
+            sessionTimeline_->mark("auth complete");
 
             aasdk::proto::messages::AuthCompleteIndication authCompleteIndication;
             authCompleteIndication.set_status(aasdk::proto::enums::Status::OK);
@@ -184,6 +193,7 @@ void AndroidAutoEntity::onServiceDiscoveryRequest(const aasdk::proto::messages::
 {
     OPENAUTO_LOG(info) << "[AndroidAutoEntity] Discovery request, device name: " << request.device_name()
                        << ", brand: " << request.device_brand();
+    sessionTimeline_->mark("service discovery");
 
     aasdk::proto::messages::ServiceDiscoveryResponse serviceDiscoveryResponse;
     serviceDiscoveryResponse.mutable_channels()->Reserve(256);
@@ -257,9 +267,9 @@ void AndroidAutoEntity::onNavigationFocusRequest(const aasdk::proto::messages::N
     controlServiceChannel_->receive(this->shared_from_this());
 }
 
-void AndroidAutoEntity::onPingResponse(const aasdk::proto::messages::PingResponse&)
+void AndroidAutoEntity::onPingResponse(const aasdk::proto::messages::PingResponse& response)
 {
-    pinger_->pong();
+    pinger_->pong(response.timestamp());
     controlServiceChannel_->receive(this->shared_from_this());
 }
 
@@ -16,6 +16,8 @@
 *  along with openauto. If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <chrono>
+#include <ctime>
 #include <f1x/aasdk/USB/AOAPDevice.hpp>
 #include <f1x/aasdk/Transport/SSLWrapper.hpp>
 #include <f1x/aasdk/Transport/USBTransport.hpp>
@@ -27,6 +29,11 @@
 #include <f1x/openauto/autoapp/Service/AndroidAutoEntityFactory.hpp>
 #include <f1x/openauto/autoapp/Service/AndroidAutoEntity.hpp>
 #include <f1x/openauto/autoapp/Service/Pinger.hpp>
+#include <f1x/openauto/autoapp/Service/PriorityMessenger.hpp>
+#include <f1x/openauto/autoapp/Service/CachedSSLWrapper.hpp>
+#include <f1x/openauto/autoapp/Service/RecordingMessenger.hpp>
+#include <f1x/openauto/autoapp/Service/TimelineMessenger.hpp>
+#include <f1x/openauto/Common/Log.hpp>
 
 namespace f1x
 {
@@ -38,40 +45,75 @@ namespace service
 {
 
 AndroidAutoEntityFactory::AndroidAutoEntityFactory(boost::asio::io_service& ioService,
+                                                   boost::asio::io_service& transportIoService,
                                                    configuration::IConfiguration::Pointer configuration,
                                                    IServiceFactory& serviceFactory)
     : ioService_(ioService)
+    , transportIoService_(transportIoService)
     , configuration_(std::move(configuration))
     , serviceFactory_(serviceFactory)
+    , sslWrapper_(std::make_shared<CachedSSLWrapper>(std::make_shared<aasdk::transport::SSLWrapper>()))
 {
-
+    try
+    {
+        aasdk::messenger::Cryptor cryptor(sslWrapper_);
+        cryptor.init();
+        cryptor.deinit();
+    }
+    catch(const aasdk::error::Error& e)
+    {
+        OPENAUTO_LOG(error) << "[AndroidAutoEntityFactory] SSL pre-warm failed: " << e.what();
+    }
 }
 
-IAndroidAutoEntity::Pointer AndroidAutoEntityFactory::create(aasdk::usb::IAOAPDevice::Pointer aoapDevice)
+IAndroidAutoEntity::Pointer AndroidAutoEntityFactory::create(aasdk::usb::IAOAPDevice::Pointer aoapDevice, SessionTimeline::Pointer sessionTimeline)
 {
-    auto transport(std::make_shared<aasdk::transport::USBTransport>(ioService_, std::move(aoapDevice)));
-    return create(std::move(transport));
+    auto transport(std::make_shared<aasdk::transport::USBTransport>(transportIoService_, std::move(aoapDevice)));
+    return create(std::move(transport), std::move(sessionTimeline));
 }
 
-IAndroidAutoEntity::Pointer AndroidAutoEntityFactory::create(aasdk::tcp::ITCPEndpoint::Pointer tcpEndpoint)
+IAndroidAutoEntity::Pointer AndroidAutoEntityFactory::create(aasdk::tcp::ITCPEndpoint::Pointer tcpEndpoint, SessionTimeline::Pointer sessionTimeline)
 {
-    auto transport(std::make_shared<aasdk::transport::TCPTransport>(ioService_, std::move(tcpEndpoint)));
-    return create(std::move(transport));
+    auto transport(std::make_shared<aasdk::transport::TCPTransport>(transportIoService_, std::move(tcpEndpoint)));
+    return create(std::move(transport), std::move(sessionTimeline));
 }
 
-IAndroidAutoEntity::Pointer AndroidAutoEntityFactory::create(aasdk::transport::ITransport::Pointer transport)
+IAndroidAutoEntity::Pointer AndroidAutoEntityFactory::create(aasdk::transport::ITransport::Pointer transport, SessionTimeline::Pointer sessionTimeline)
 {
-    auto sslWrapper(std::make_shared<aasdk::transport::SSLWrapper>());
-    auto cryptor(std::make_shared<aasdk::messenger::Cryptor>(std::move(sslWrapper)));
+    const auto initStart = std::chrono::steady_clock::now();
+    auto cryptor(std::make_shared<aasdk::messenger::Cryptor>(sslWrapper_));
     cryptor->init();
+    const auto initDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - initStart);
+    OPENAUTO_LOG(info) << "[AndroidAutoEntityFactory] cryptor init: " << initDuration.count() << " us.";
+    sessionTimeline->mark("cryptor init");
+
+    aasdk::messenger::IMessenger::Pointer messenger(std::make_shared<aasdk::messenger::Messenger>(transportIoService_,
+                                                                                                  std::make_shared<aasdk::messenger::MessageInStream>(transportIoService_, transport, cryptor),
+                                                                                                  std::make_shared<aasdk::messenger::MessageOutStream>(transportIoService_, transport, cryptor)));
+
+    if(!configuration_->getSessionRecordingPath().empty())
+    {
+        messenger = std::make_shared<RecordingMessenger>(transportIoService_, std::move(messenger), this->getRecordingFileName());
+    }
+
+    messenger = std::make_shared<TimelineMessenger>(transportIoService_, std::move(messenger), sessionTimeline);
+    messenger = std::make_shared<PriorityMessenger>(transportIoService_, std::move(messenger));
 
-    auto messenger(std::make_shared<aasdk::messenger::Messenger>(ioService_,
-                                                                 std::make_shared<aasdk::messenger::MessageInStream>(ioService_, transport, cryptor),
-                                                                 std::make_shared<aasdk::messenger::MessageOutStream>(ioService_, transport, cryptor)));
+    auto serviceList = serviceFactory_.create(messenger, sessionTimeline);
+    sessionTimeline->mark("services created");
 
-    auto serviceList = serviceFactory_.create(messenger);
-    auto pinger(std::make_shared<Pinger>(ioService_, 5000));
-    return std::make_shared<AndroidAutoEntity>(ioService_, std::move(cryptor), std::move(transport), std::move(messenger), configuration_, std::move(serviceList), std::move(pinger));
+    auto pinger(std::make_shared<Pinger>(ioService_, 1000));
+    auto androidAutoEntity(std::make_shared<AndroidAutoEntity>(ioService_, std::move(cryptor), std::move(transport), std::move(messenger), configuration_, std::move(serviceList), std::move(pinger), sessionTimeline));
+    sessionTimeline->mark("entity created");
+    return androidAutoEntity;
+}
+
+std::string AndroidAutoEntityFactory::getRecordingFileName() const
+{
+    const auto now = std::time(nullptr);
+    char timestamp[32];
+    std::strftime(timestamp, sizeof(timestamp), "%Y%m%d_%H%M%S", std::localtime(&now));
+    return configuration_->getSessionRecordingPath() + "/session_" + timestamp + ".oarec";
 }
 
 }
@@ -0,0 +1,236 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <f1x/openauto/autoapp/Service/CachedSSLWrapper.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace service
+{
+
+CachedSSLWrapper::CachedSSLWrapper(aasdk::transport::ISSLWrapper::Pointer sslWrapper)
+    : sslWrapper_(std::move(sslWrapper))
+    , certificate_(nullptr)
+    , privateKey_(nullptr)
+    , context_(nullptr)
+    , certificateInUse_(false)
+    , privateKeyInUse_(false)
+{
+
+}
+
+CachedSSLWrapper::~CachedSSLWrapper()
+{
+    if(context_ != nullptr)
+    {
+        sslWrapper_->free(context_);
+    }
+
+    if(certificate_ != nullptr)
+    {
+        sslWrapper_->free(certificate_);
+    }
+
+    if(privateKey_ != nullptr)
+    {
+        sslWrapper_->free(privateKey_);
+    }
+}
+
+X509* CachedSSLWrapper::readCertificate(const std::string& certificate)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    if(certificate_ == nullptr)
+    {
+        certificate_ = sslWrapper_->readCertificate(certificate);
+    }
+
+    return certificate_;
+}
+
+EVP_PKEY* CachedSSLWrapper::readPrivateKey(const std::string& privateKey)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    if(privateKey_ == nullptr)
+    {
+        privateKey_ = sslWrapper_->readPrivateKey(privateKey);
+    }
+
+    return privateKey_;
+}
+
+const SSL_METHOD* CachedSSLWrapper::getMethod()
+{
+    return sslWrapper_->getMethod();
+}
+
+SSL_CTX* CachedSSLWrapper::createContext(const SSL_METHOD* method)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    if(context_ == nullptr)
+    {
+        context_ = sslWrapper_->createContext(method);
+    }
+
+    return context_;
+}
+
+bool CachedSSLWrapper::useCertificate(SSL_CTX* context, X509* certificate)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    if(context == context_ && certificate == certificate_)
+    {
+        if(!certificateInUse_)
+        {
+            certificateInUse_ = sslWrapper_->useCertificate(context, certificate);
+        }
+
+        return certificateInUse_;
+    }
+
+    return sslWrapper_->useCertificate(context, certificate);
+}
+
+bool CachedSSLWrapper::usePrivateKey(SSL_CTX* context, EVP_PKEY* privateKey)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    if(context == context_ && privateKey == privateKey_)
+    {
+        if(!privateKeyInUse_)
+        {
+            privateKeyInUse_ = sslWrapper_->usePrivateKey(context, privateKey);
+        }
+
+        return privateKeyInUse_;
+    }
+
+    return sslWrapper_->usePrivateKey(context, privateKey);
+}
+
+SSL* CachedSSLWrapper::createInstance(SSL_CTX* context)
+{
+    return sslWrapper_->createInstance(context);
+}
+
+bool CachedSSLWrapper::checkPrivateKey(SSL* ssl)
+{
+    return sslWrapper_->checkPrivateKey(ssl);
+}
+
+CachedSSLWrapper::BIOs CachedSSLWrapper::createBIOs()
+{
+    return sslWrapper_->createBIOs();
+}
+
+void CachedSSLWrapper::setBIOs(SSL* ssl, const BIOs& bIOs, size_t maxBufferSize)
+{
+    sslWrapper_->setBIOs(ssl, bIOs, maxBufferSize);
+}
+
+void CachedSSLWrapper::setConnectState(SSL* ssl)
+{
+    sslWrapper_->setConnectState(ssl);
+}
+
+int CachedSSLWrapper::doHandshake(SSL* ssl)
+{
+    return sslWrapper_->doHandshake(ssl);
+}
+
+int CachedSSLWrapper::getError(SSL* ssl, int returnCode)
+{
+    return sslWrapper_->getError(ssl, returnCode);
+}
+
+void CachedSSLWrapper::free(SSL* ssl)
+{
+    sslWrapper_->free(ssl);
+}
+
+void CachedSSLWrapper::free(SSL_CTX* context)
+{
+    if(context != context_)
+    {
+        sslWrapper_->free(context);
+    }
+}
+
+void CachedSSLWrapper::free(BIO* bio)
+{
+    sslWrapper_->free(bio);
+}
+
+void CachedSSLWrapper::free(X509* certificate)
+{
+    if(certificate != certificate_)
+    {
+        sslWrapper_->free(certificate);
+    }
+}
+
+void CachedSSLWrapper::free(EVP_PKEY* privateKey)
+{
+    if(privateKey != privateKey_)
+    {
+        sslWrapper_->free(privateKey);
+    }
+}
+
+size_t CachedSSLWrapper::bioCtrlPending(BIO* b)
+{
+    return sslWrapper_->bioCtrlPending(b);
+}
+
+int CachedSSLWrapper::bioRead(BIO *b, void *data, int len)
+{
+    return sslWrapper_->bioRead(b, data, len);
+}
+
+int CachedSSLWrapper::bioWrite(BIO *b, const void *data, int len)
+{
+    return sslWrapper_->bioWrite(b, data, len);
+}
+
+int CachedSSLWrapper::getAvailableBytes(const SSL* ssl)
+{
+    return sslWrapper_->getAvailableBytes(ssl);
+}
+
+int CachedSSLWrapper::sslRead(SSL *ssl, void *buf, int num)
+{
+    return sslWrapper_->sslRead(ssl, buf, num);
+}
+
+int CachedSSLWrapper::sslWrite(SSL *ssl, const void *buf, int num)
+{
+    return sslWrapper_->sslWrite(ssl, buf, num);
+}
+
+}
+}
+}
+}
@@ -16,6 +16,10 @@
 *  along with openauto. If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 #include <f1x/openauto/autoapp/Service/Pinger.hpp>
 #include <f1x/openauto/Common/Log.hpp>
 
@@ -28,6 +32,8 @@ namespace autoapp
 namespace service
 {
 
+const std::string Pinger::cStatisticsFilePath = "/tmp/android_link_rtt";
+
 Pinger::Pinger(boost::asio::io_service& ioService, time_t duration)
     : strand_(ioService)
     , timer_(ioService)
@@ -35,6 +41,10 @@ Pinger::Pinger(boost::asio::io_service& ioService, time_t duration)
     , cancelled_(false)
     , pingsCount_(0)
     , pongsCount_(0)
+    , rttSamples_(cRttSamplesCount)
+    , smoothedRtt_(0)
+    , rttVariation_(0)
+    , timeout_(cInitialTimeout)
 {
 
 }
@@ -50,9 +60,6 @@ void Pinger::ping(Promise::Pointer promise)
         }
         else
         {
-            ++pingsCount_;
-            OPENAUTO_LOG(info) << "[Pinger] Ping counter: " << pingsCount_;
-
             promise_ = std::move(promise);
             timer_.expires_from_now(boost::posix_time::milliseconds(duration_));
             timer_.async_wait(strand_.wrap(std::bind(&Pinger::onTimerExceeded, this->shared_from_this(), std::placeholders::_1)));
@@ -60,14 +67,87 @@ void Pinger::ping(Promise::Pointer promise)
     });
 }
 
-void Pinger::pong()
+void Pinger::pong(int64_t timestamp)
 {
-    strand_.dispatch([this, self = this->shared_from_this()]() {
+    strand_.dispatch([this, self = this->shared_from_this(), timestamp]() {
         ++pongsCount_;
-        OPENAUTO_LOG(info) << "[Pinger] Pong counter: " << pongsCount_;
+
+        if(!pendingPings_.empty())
+        {
+            pendingPings_.pop_front();
+        }
+
+        const auto now = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+        const auto rtt = now - timestamp;
+
+        if(rtt < 0 || rtt > cMaxTimeout)
+        {
+            OPENAUTO_LOG(warning) << "[Pinger] Ignoring pong with invalid timestamp, rtt: " << rtt << " us.";
+            return;
+        }
+
+        rttSamples_.push_back(rtt);
+        this->updateTimeout(rtt);
+
+        if(pongsCount_ % cStatisticsInterval == 0)
+        {
+            this->publishStatistics();
+        }
     });
 }
 
+void Pinger::updateTimeout(int64_t rtt)
+{
+    if(smoothedRtt_ == 0)
+    {
+        smoothedRtt_ = rtt;
+        rttVariation_ = rtt / 2;
+    }
+    else
+    {
+        rttVariation_ = (3 * rttVariation_ + std::abs(smoothedRtt_ - rtt)) / 4;
+        smoothedRtt_ = (7 * smoothedRtt_ + rtt) / 8;
+    }
+
+    timeout_ = smoothedRtt_ + 4 * rttVariation_;
+    timeout_ = timeout_ < cMinTimeout ? cMinTimeout : timeout_;
+    timeout_ = timeout_ > cMaxTimeout ? cMaxTimeout : timeout_;
+}
+
+void Pinger::publishStatistics()
+{
+    std::vector<int64_t> samples(rttSamples_.begin(), rttSamples_.end());
+    std::sort(samples.begin(), samples.end());
+
+    const auto p50 = samples[samples.size() / 2];
+    const auto p95 = samples[samples.size() * 95 / 100];
+    const auto max = samples.back();
+
+    const int64_t bucketLimits[] = {5000, 10000, 20000, 50000, 100000, 200000, 500000};
+    size_t buckets[sizeof(bucketLimits) / sizeof(bucketLimits[0]) + 1] = {0};
+    for(const auto& sample : samples)
+    {
+        ++buckets[std::upper_bound(std::begin(bucketLimits), std::end(bucketLimits), sample) - std::begin(bucketLimits)];
+    }
+
+    OPENAUTO_LOG(info) << "[Pinger] rtt p50: " << p50 / 1000 << " ms, p95: " << p95 / 1000 << " ms, max: " << max / 1000
+                       << " ms, jitter: " << rttVariation_ / 1000 << " ms, timeout: " << timeout_ / 1000 << " ms.";
+
+    std::ofstream file(cStatisticsFilePath, std::ios::trunc);
+    file << "p50=" << p50 << std::endl;
+    file << "p95=" << p95 << std::endl;
+    file << "max=" << max << std::endl;
+    file << "srtt=" << smoothedRtt_ << std::endl;
+    file << "jitter=" << rttVariation_ << std::endl;
+    file << "timeout=" << timeout_ << std::endl;
+    file << "histogram=";
+    for(size_t i = 0; i < sizeof(buckets) / sizeof(buckets[0]); ++i)
+    {
+        file << (i == 0 ? "" : ",") << buckets[i];
+    }
+    file << std::endl;
+}
+
 void Pinger::onTimerExceeded(const boost::system::error_code& error)
 {
     if(promise_ == nullptr)
@@ -78,12 +158,16 @@ void Pinger::onTimerExceeded(const boost::system::error_code& error)
     {
         promise_->reject(aasdk::error::Error(aasdk::error::ErrorCode::OPERATION_ABORTED));
     }
-    else if(pingsCount_ - pongsCount_ > 4)
+    else if(pongsCount_ > 0 && !pendingPings_.empty() &&
+            std::chrono::steady_clock::now() - pendingPings_.front() > std::chrono::microseconds(timeout_))
     {
+        OPENAUTO_LOG(error) << "[Pinger] No pong within " << timeout_ / 1000 << " ms, pings: " << pingsCount_ << ", pongs: " << pongsCount_;
         promise_->reject(aasdk::error::Error());
     }
     else
     {
+        ++pingsCount_;
+        pendingPings_.push_back(std::chrono::steady_clock::now());
         promise_->resolve();
     }
 
@@ -95,6 +179,7 @@ void Pinger::cancel()
     strand_.dispatch([this, self = this->shared_from_this()]() {
         cancelled_ = true;
         timer_.cancel();
+        std::remove(cStatisticsFilePath.c_str());
     });
 }
 
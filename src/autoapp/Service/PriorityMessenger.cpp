@@ -0,0 +1,214 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <f1x/openauto/autoapp/Service/PriorityMessenger.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace service
+{
+
+PriorityMessenger::PriorityMessenger(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger)
+    : strand_(ioService)
+    , messenger_(std::move(messenger))
+    , consecutiveHighPriority_(0)
+    , sendInProgress_(false)
+    , stopped_(false)
+{
+    statistics_.fill(SendStatistics{0, 0, 0});
+}
+
+void PriorityMessenger::enqueueReceive(aasdk::messenger::ChannelId channelId, aasdk::messenger::ReceivePromise::Pointer promise)
+{
+    messenger_->enqueueReceive(channelId, std::move(promise));
+}
+
+void PriorityMessenger::enqueueSend(aasdk::messenger::Message::Pointer message, aasdk::messenger::SendPromise::Pointer promise)
+{
+    PendingSend pendingSend{std::move(message), std::move(promise), std::chrono::steady_clock::now()};
+
+    strand_.dispatch([this, self = this->shared_from_this(), pendingSend = std::move(pendingSend)]() mutable {
+        if(stopped_)
+        {
+            pendingSend.promise->reject(aasdk::error::Error(aasdk::error::ErrorCode::OPERATION_ABORTED));
+            return;
+        }
+
+        const auto sendClass = static_cast<size_t>(classify(*pendingSend.message));
+        queues_[sendClass].push_back(std::move(pendingSend));
+
+        if(!sendInProgress_)
+        {
+            this->sendNext();
+        }
+    });
+}
+
+void PriorityMessenger::stop()
+{
+    strand_.dispatch([this, self = this->shared_from_this()]() {
+        stopped_ = true;
+
+        for(auto& queue : queues_)
+        {
+            for(auto& pendingSend : queue)
+            {
+                pendingSend.promise->reject(aasdk::error::Error(aasdk::error::ErrorCode::OPERATION_ABORTED));
+            }
+
+            queue.clear();
+        }
+
+        this->logStatistics();
+    });
+
+    messenger_->stop();
+}
+
+PriorityMessenger::SendClass PriorityMessenger::classify(const aasdk::messenger::Message& message)
+{
+    if(message.getType() == aasdk::messenger::MessageType::CONTROL)
+    {
+        return SendClass::CONTROL;
+    }
+
+    switch(message.getChannelId())
+    {
+    case aasdk::messenger::ChannelId::CONTROL:
+    case aasdk::messenger::ChannelId::INPUT:
+    case aasdk::messenger::ChannelId::BLUETOOTH:
+        return SendClass::CONTROL;
+
+    case aasdk::messenger::ChannelId::SENSOR:
+        return SendClass::SENSOR;
+
+    default:
+        return SendClass::MEDIA;
+    }
+}
+
+const char* PriorityMessenger::sendClassToString(size_t sendClass)
+{
+    switch(static_cast<SendClass>(sendClass))
+    {
+    case SendClass::CONTROL:
+        return "control";
+
+    case SendClass::SENSOR:
+        return "sensor";
+
+    default:
+        return "media";
+    }
+}
+
+size_t PriorityMessenger::selectQueue()
+{
+    size_t highest = queues_.size();
+    size_t oldestLower = queues_.size();
+
+    for(size_t i = 0; i < queues_.size(); ++i)
+    {
+        if(queues_[i].empty())
+        {
+            continue;
+        }
+
+        if(highest == queues_.size())
+        {
+            highest = i;
+        }
+        else if(oldestLower == queues_.size() || queues_[i].front().timestamp < queues_[oldestLower].front().timestamp)
+        {
+            oldestLower = i;
+        }
+    }
+
+    if(oldestLower != queues_.size() && consecutiveHighPriority_ >= cStarvationLimit)
+    {
+        consecutiveHighPriority_ = 0;
+        return oldestLower;
+    }
+
+    consecutiveHighPriority_ = oldestLower != queues_.size() ? consecutiveHighPriority_ + 1 : 0;
+    return highest;
+}
+
+void PriorityMessenger::sendNext()
+{
+    const auto index = this->selectQueue();
+    if(index == queues_.size())
+    {
+        sendInProgress_ = false;
+        return;
+    }
+
+    auto pendingSend = std::move(queues_[index].front());
+    queues_[index].pop_front();
+
+    const auto delay = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - pendingSend.timestamp).count();
+    auto& statistics = statistics_[index];
+    ++statistics.count;
+    statistics.totalDelay += delay;
+    statistics.maxDelay = std::max<int64_t>(statistics.maxDelay, delay);
+
+    if(statistics.count % cStatisticsInterval == 0)
+    {
+        this->logStatistics();
+    }
+
+    sendInProgress_ = true;
+
+    auto promise = std::move(pendingSend.promise);
+    auto sendPromise = aasdk::messenger::SendPromise::defer(strand_);
+    sendPromise->then([this, self = this->shared_from_this(), promise]() {
+                          promise->resolve();
+                          this->sendNext();
+                      },
+                      [this, self = this->shared_from_this(), promise](const aasdk::error::Error& e) {
+                          promise->reject(e);
+                          this->sendNext();
+                      });
+
+    messenger_->enqueueSend(std::move(pendingSend.message), std::move(sendPromise));
+}
+
+void PriorityMessenger::logStatistics()
+{
+    for(size_t i = 0; i < statistics_.size(); ++i)
+    {
+        const auto& statistics = statistics_[i];
+        if(statistics.count > 0)
+        {
+            OPENAUTO_LOG(info) << "[PriorityMessenger] " << sendClassToString(i) << ": " << statistics.count << " messages"
+                               << ", avg queueing delay: " << statistics.totalDelay / static_cast<int64_t>(statistics.count) << " us"
+                               << ", max: " << statistics.maxDelay << " us";
+        }
+    }
+}
+
+}
+}
+}
+}
@@ -0,0 +1,109 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/autoapp/Service/RecordingMessenger.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace service
+{
+
+RecordingMessenger::RecordingMessenger(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger, const std::string& fileName)
+    : ioService_(ioService)
+    , messenger_(std::move(messenger))
+    , file_(fileName, std::ios::out | std::ios::binary | std::ios::trunc)
+    , writer_(file_)
+    , startTimestamp_(std::chrono::steady_clock::now())
+    , messagesCount_(0)
+    , bytesCount_(0)
+    , recording_(file_.is_open())
+{
+    if(recording_)
+    {
+        OPENAUTO_LOG(info) << "[RecordingMessenger] recording session to: " << fileName;
+    }
+    else
+    {
+        OPENAUTO_LOG(error) << "[RecordingMessenger] cannot open " << fileName << ", session will not be recorded.";
+    }
+}
+
+void RecordingMessenger::enqueueReceive(aasdk::messenger::ChannelId channelId, aasdk::messenger::ReceivePromise::Pointer promise)
+{
+    auto recordPromise = aasdk::messenger::ReceivePromise::defer(ioService_);
+    recordPromise->then([this, self = this->shared_from_this(), promise](aasdk::messenger::Message::Pointer message) {
+                            this->record(common::SessionRecordDirection::FROM_PHONE, *message);
+                            promise->resolve(std::move(message));
+                        },
+                        [promise](const aasdk::error::Error& e) {
+                            promise->reject(e);
+                        });
+
+    messenger_->enqueueReceive(channelId, std::move(recordPromise));
+}
+
+void RecordingMessenger::enqueueSend(aasdk::messenger::Message::Pointer message, aasdk::messenger::SendPromise::Pointer promise)
+{
+    this->record(common::SessionRecordDirection::TO_PHONE, *message);
+    messenger_->enqueueSend(std::move(message), std::move(promise));
+}
+
+void RecordingMessenger::stop()
+{
+    messenger_->stop();
+
+    if(!recording_)
+    {
+        return;
+    }
+
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    file_.flush();
+    OPENAUTO_LOG(info) << "[RecordingMessenger] stop, recorded messages: " << messagesCount_ << ", payload bytes: " << bytesCount_;
+}
+
+void RecordingMessenger::record(common::SessionRecordDirection direction, const aasdk::messenger::Message& message)
+{
+    if(!recording_)
+    {
+        return;
+    }
+
+    common::SessionRecordEntry entry;
+    entry.timestamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimestamp_).count();
+    entry.direction = direction;
+    entry.channelId = static_cast<uint8_t>(message.getChannelId());
+    entry.encrypted = message.getEncryptionType() == aasdk::messenger::EncryptionType::ENCRYPTED;
+    entry.control = message.getType() == aasdk::messenger::MessageType::CONTROL;
+    entry.payload = message.getPayload();
+
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    writer_.write(entry);
+    ++messagesCount_;
+    bytesCount_ += entry.payload.size();
+}
+
+}
+}
+}
+}
@@ -16,7 +16,6 @@
 *  along with openauto. If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include <aasdk_proto/DrivingStatusEnum.pb.h>
 #include <f1x/openauto/Common/Log.hpp>
 #include <f1x/openauto/autoapp/Service/SensorService.hpp>
 #include <fstream>
@@ -30,10 +29,20 @@ namespace autoapp
 namespace service
 {
 
-SensorService::SensorService(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger)
+const int32_t SensorService::cDrivingSpeedThreshold = 1400;
+
+SensorService::SensorService(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger, configuration::IConfiguration::Pointer configuration, projection::IVehicleDataSource::Pointer vehicleDataSource)
     : strand_(ioService),
       timer_(ioService),
-      channel_(std::make_shared<aasdk::channel::sensor::SensorServiceChannel>(strand_, std::move(messenger)))
+      batchTimer_(ioService),
+      channel_(std::make_shared<aasdk::channel::sensor::SensorServiceChannel>(strand_, std::move(messenger))),
+      vehicleDataSource_(std::move(vehicleDataSource)),
+      drivingStatus_(aasdk::proto::enums::DrivingStatus::UNRESTRICTED),
+      batchWindow_(configuration->getSensorBatchWindow()),
+      batchPending_(false),
+      batchGeneration_(0),
+      updatesCount_(0),
+      messagesCount_(0)
 {
 
 }
@@ -46,6 +55,7 @@ void SensorService::start()
         }
         this->nightSensorPolling();
         OPENAUTO_LOG(info) << "[SensorService] start.";
+        vehicleDataSource_->start(*this);
         channel_->receive(this->shared_from_this());
     });
 }
@@ -54,7 +64,11 @@ void SensorService::stop()
 {
     this->stopPolling = true;
     strand_.dispatch([this, self = this->shared_from_this()]() {
-        OPENAUTO_LOG(info) << "[SensorService] stop.";
+        vehicleDataSource_->stop();
+        this->flushSensorEvents();
+        OPENAUTO_LOG(info) << "[SensorService] stop, sensor updates: " << updatesCount_
+                           << ", messages sent: " << messagesCount_
+                           << ", messages saved: " << updatesCount_ - messagesCount_;
     });
 }
 
@@ -83,6 +97,14 @@ void SensorService::fillFeatures(aasdk::proto::messages::ServiceDiscoveryRespons
     sensorChannel->add_sensors()->set_type(aasdk::proto::enums::SensorType::DRIVING_STATUS);
     //sensorChannel->add_sensors()->set_type(aasdk::proto::enums::SensorType::LOCATION);
     sensorChannel->add_sensors()->set_type(aasdk::proto::enums::SensorType::NIGHT_DATA);
+
+    for(auto sensorType : vehicleDataSource_->getSupportedSensors())
+    {
+        if(sensorType != aasdk::proto::enums::SensorType::NIGHT_DATA)
+        {
+            sensorChannel->add_sensors()->set_type(sensorType);
+        }
+    }
 }
 
 void SensorService::onChannelOpenRequest(const aasdk::proto::messages::ChannelOpenRequest& request)
@@ -112,7 +134,14 @@ void SensorService::onSensorStartRequest(const aasdk::proto::messages::SensorSta
 
     if(request.sensor_type() == aasdk::proto::enums::SensorType::DRIVING_STATUS)
     {
-        promise->then(std::bind(&SensorService::sendDrivingStatusUnrestricted, this->shared_from_this()),
+        promise->then(std::bind(&SensorService::sendDrivingStatus, this->shared_from_this()),
+                      std::bind(&SensorService::onChannelError, this->shared_from_this(), std::placeholders::_1));
+    }
+    else if(request.sensor_type() == aasdk::proto::enums::SensorType::CAR_SPEED ||
+            request.sensor_type() == aasdk::proto::enums::SensorType::GEAR ||
+            request.sensor_type() == aasdk::proto::enums::SensorType::PARKING_BRAKE)
+    {
+        promise->then(std::bind(&SensorService::sendVehicleData, this->shared_from_this()),
                       std::bind(&SensorService::onChannelError, this->shared_from_this(), std::placeholders::_1));
     }
     else if(request.sensor_type() == aasdk::proto::enums::SensorType::NIGHT_DATA)
@@ -129,14 +158,11 @@ void SensorService::onSensorStartRequest(const aasdk::proto::messages::SensorSta
     channel_->receive(this->shared_from_this());
 }
 
-void SensorService::sendDrivingStatusUnrestricted()
+void SensorService::sendDrivingStatus()
 {
     aasdk::proto::messages::SensorEventIndication indication;
-    indication.add_driving_status()->set_status(aasdk::proto::enums::DrivingStatus::UNRESTRICTED);
-
-    auto promise = aasdk::channel::SendPromise::defer(strand_);
-    promise->then([]() {}, std::bind(&SensorService::onChannelError, this->shared_from_this(), std::placeholders::_1));
-    channel_->sendSensorEventIndication(indication, std::move(promise));
+    indication.add_driving_status()->set_status(drivingStatus_);
+    this->queueSensorEvent(indication, true);
 }
 
 void SensorService::sendNightData()
@@ -151,20 +177,166 @@ void SensorService::sendNightData()
         indication.add_night_mode()->set_is_night(false);
     }
 
-    auto promise = aasdk::channel::SendPromise::defer(strand_);
-    promise->then([]() {}, std::bind(&SensorService::onChannelError, this->shared_from_this(), std::placeholders::_1));
-    channel_->sendSensorEventIndication(indication, std::move(promise));
+    this->queueSensorEvent(indication, false);
     if (this->firstRun) {
         this->firstRun = false;
         this->previous = this->isNight;
     }
 }
 
+void SensorService::sendVehicleData()
+{
+    aasdk::proto::messages::SensorEventIndication indication;
+    this->fillVehicleData(indication, vehicleData_);
+
+    if(indication.ByteSize() > 0)
+    {
+        this->queueSensorEvent(indication, false);
+    }
+}
+
+void SensorService::fillVehicleData(aasdk::proto::messages::SensorEventIndication& indication, const projection::VehicleData& data)
+{
+    if(data.speed)
+    {
+        indication.add_speed()->set_speed(*data.speed);
+    }
+
+    if(data.gear)
+    {
+        indication.add_gear()->set_gear(*data.gear);
+    }
+
+    if(data.parkingBrake)
+    {
+        indication.add_parking_brake()->set_parking_brake(*data.parkingBrake);
+    }
+}
+
+aasdk::proto::enums::DrivingStatus::Enum SensorService::deriveDrivingStatus() const
+{
+    const bool parked = (vehicleData_.parkingBrake && *vehicleData_.parkingBrake) ||
+                        (vehicleData_.gear && *vehicleData_.gear == aasdk::proto::enums::Gear::PARK);
+
+    if(vehicleData_.speed)
+    {
+        return *vehicleData_.speed > cDrivingSpeedThreshold && !parked ? aasdk::proto::enums::DrivingStatus::FULLY_RESTRICTED
+                                                                        : aasdk::proto::enums::DrivingStatus::UNRESTRICTED;
+    }
+
+    return (vehicleData_.parkingBrake || vehicleData_.gear) && !parked ? aasdk::proto::enums::DrivingStatus::FULLY_RESTRICTED
+                                                                        : aasdk::proto::enums::DrivingStatus::UNRESTRICTED;
+}
+
+void SensorService::onVehicleDataUpdate(const projection::VehicleData& data)
+{
+    strand_.dispatch([this, self = this->shared_from_this(), data]() {
+        aasdk::proto::messages::SensorEventIndication indication;
+        this->fillVehicleData(indication, data);
+
+        if(data.speed)
+        {
+            vehicleData_.speed = data.speed;
+        }
+
+        if(data.gear)
+        {
+            vehicleData_.gear = data.gear;
+        }
+
+        if(data.parkingBrake)
+        {
+            vehicleData_.parkingBrake = data.parkingBrake;
+        }
+
+        const auto drivingStatus = this->deriveDrivingStatus();
+        if(drivingStatus != drivingStatus_)
+        {
+            OPENAUTO_LOG(info) << "[SensorService] driving status: " << drivingStatus;
+            drivingStatus_ = drivingStatus;
+            indication.add_driving_status()->set_status(drivingStatus_);
+        }
+
+        if(data.headlights)
+        {
+            vehicleData_.headlights = data.headlights;
+            this->isNight = *data.headlights;
+            if(this->previous != this->isNight && !this->firstRun)
+            {
+                this->previous = this->isNight;
+                indication.add_night_mode()->set_is_night(this->isNight);
+            }
+        }
+
+        if(indication.ByteSize() > 0)
+        {
+            this->queueSensorEvent(indication, indication.driving_status_size() > 0);
+        }
+    });
+}
+
+void SensorService::queueSensorEvent(const aasdk::proto::messages::SensorEventIndication& indication, bool urgent)
+{
+    std::vector<const google::protobuf::FieldDescriptor*> fields;
+    indication.GetReflection()->ListFields(indication, &fields);
+
+    for(const auto* field : fields)
+    {
+        batchIndication_.GetReflection()->ClearField(&batchIndication_, field);
+    }
+
+    batchIndication_.MergeFrom(indication);
+    ++updatesCount_;
+
+    if(urgent || batchWindow_.total_milliseconds() == 0)
+    {
+        this->flushSensorEvents();
+    }
+    else if(!batchPending_)
+    {
+        batchPending_ = true;
+        batchTimer_.expires_from_now(batchWindow_);
+        batchTimer_.async_wait(strand_.wrap(std::bind(&SensorService::onBatchTimeout, this->shared_from_this(), std::placeholders::_1, ++batchGeneration_)));
+    }
+}
+
+void SensorService::onBatchTimeout(const boost::system::error_code& error, size_t generation)
+{
+    if(error != boost::asio::error::operation_aborted && batchPending_ && generation == batchGeneration_)
+    {
+        this->flushSensorEvents();
+    }
+}
+
+void SensorService::flushSensorEvents()
+{
+    if(batchPending_)
+    {
+        batchPending_ = false;
+        ++batchGeneration_;
+        batchTimer_.cancel();
+    }
+
+    if(batchIndication_.ByteSize() == 0)
+    {
+        return;
+    }
+
+    ++messagesCount_;
+
+    auto promise = aasdk::channel::SendPromise::defer(strand_);
+    promise->then([]() {}, std::bind(&SensorService::onChannelError, this->shared_from_this(), std::placeholders::_1));
+    channel_->sendSensorEventIndication(batchIndication_, std::move(promise));
+    batchIndication_.Clear();
+}
+
 void SensorService::nightSensorPolling()
 {
     if (!this->stopPolling) {
         strand_.dispatch([this, self = this->shared_from_this()]() {
-            this->isNight = is_file_exist("/tmp/night_mode_enabled");
+            if (!vehicleData_.headlights) {
+                this->isNight = is_file_exist("/tmp/night_mode_enabled");
+            }
             if (this->previous != this->isNight && !this->firstRun) {
                 this->previous = this->isNight;
                 this->sendNightData();
@@ -16,6 +16,7 @@
 *  along with openauto. If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <chrono>
 #include <QApplication>
 #include <QScreen>
 #include <f1x/aasdk/Channel/AV/MediaAudioServiceChannel.hpp>
@@ -39,6 +40,9 @@
 #include <f1x/openauto/autoapp/Projection/LocalBluetoothDevice.hpp>
 #include <f1x/openauto/autoapp/Projection/RemoteBluetoothDevice.hpp>
 #include <f1x/openauto/autoapp/Projection/DummyBluetoothDevice.hpp>
+#include <f1x/openauto/autoapp/Projection/CANVehicleDataSource.hpp>
+#include <f1x/openauto/autoapp/Projection/DummyVehicleDataSource.hpp>
+#include <f1x/openauto/Common/Log.hpp>
 
 namespace f1x
 {
@@ -49,36 +53,144 @@ namespace autoapp
 namespace service
 {
 
-ServiceFactory::ServiceFactory(boost::asio::io_service& ioService, configuration::IConfiguration::Pointer configuration)
+ServiceFactory::ServiceFactory(boost::asio::io_service& ioService,
+                               boost::asio::io_service& mediaIoService,
+                               boost::asio::io_service& housekeepingIoService,
+                               configuration::IConfiguration::Pointer configuration)
     : ioService_(ioService)
+    , mediaIoService_(mediaIoService)
+    , housekeepingIoService_(housekeepingIoService)
     , configuration_(std::move(configuration))
+    , audioOutputBackendType_(configuration_->getAudioOutputBackendType())
+    , prewarmGuard_(std::make_shared<PrewarmGuard>())
 {
+    prewarmGuard_->factory = this;
+    housekeepingIoService_.post([guard = prewarmGuard_]() {
+        std::lock_guard<std::mutex> lock(guard->mutex);
+        if(guard->factory != nullptr)
+        {
+            guard->factory->prewarm();
+        }
+    });
+}
 
+ServiceFactory::~ServiceFactory()
+{
+    std::lock_guard<std::mutex> lock(prewarmGuard_->mutex);
+    prewarmGuard_->factory = nullptr;
 }
 
-ServiceList ServiceFactory::create(aasdk::messenger::IMessenger::Pointer messenger)
+ServiceList ServiceFactory::create(aasdk::messenger::IMessenger::Pointer messenger, SessionTimeline::Pointer sessionTimeline)
 {
+    const auto createStart = std::chrono::steady_clock::now();
     ServiceList serviceList;
 
-    projection::IAudioInput::Pointer audioInput(new projection::QtAudioInput(1, 16, 16000), std::bind(&QObject::deleteLater, std::placeholders::_1));
-    serviceList.emplace_back(std::make_shared<AudioInputService>(ioService_, messenger, std::move(audioInput)));
+    serviceList.emplace_back(std::make_shared<AudioInputService>(mediaIoService_, messenger, this->getAudioInput()));
     this->createAudioServices(serviceList, messenger);
-    serviceList.emplace_back(std::make_shared<SensorService>(ioService_, messenger));
-    serviceList.emplace_back(this->createVideoService(messenger));
+    serviceList.emplace_back(this->createSensorService(messenger));
+    serviceList.emplace_back(this->createVideoService(messenger, std::move(sessionTimeline)));
     serviceList.emplace_back(this->createBluetoothService(messenger));
     serviceList.emplace_back(this->createInputService(messenger));
 
+    const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - createStart);
+    OPENAUTO_LOG(info) << "[ServiceFactory] services created in " << duration.count() << " us.";
+
     return serviceList;
 }
 
-IService::Pointer ServiceFactory::createVideoService(aasdk::messenger::IMessenger::Pointer messenger)
+void ServiceFactory::prewarm()
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    this->getAudioInput();
+    this->getVideoOutput();
+
+    if(configuration_->musicAudioChannelEnabled())
+    {
+        this->getAudioOutput(mediaAudioOutput_, 2, 16, 48000);
+    }
+
+    if(configuration_->speechAudioChannelEnabled())
+    {
+        this->getAudioOutput(speechAudioOutput_, 1, 16, 16000);
+    }
+
+    this->getAudioOutput(systemAudioOutput_, 1, 16, 16000);
+
+    const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    OPENAUTO_LOG(info) << "[ServiceFactory] backends prewarmed in " << duration.count() << " ms.";
+}
+
+projection::IAudioInput::Pointer ServiceFactory::getAudioInput()
 {
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    if(audioInput_ == nullptr)
+    {
+        audioInput_ = projection::IAudioInput::Pointer(new projection::QtAudioInput(1, 16, 16000), std::bind(&QObject::deleteLater, std::placeholders::_1));
+    }
+
+    return audioInput_;
+}
+
+projection::IVideoOutput::Pointer ServiceFactory::getVideoOutput()
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    if(videoOutput_ == nullptr)
+    {
 #ifdef USE_OMX
-    auto videoOutput(std::make_shared<projection::OMXVideoOutput>(configuration_));
+        videoOutput_ = std::make_shared<projection::OMXVideoOutput>(configuration_);
 #else
-    projection::IVideoOutput::Pointer videoOutput(new projection::QtVideoOutput(configuration_), std::bind(&QObject::deleteLater, std::placeholders::_1));
+        videoOutput_ = projection::IVideoOutput::Pointer(new projection::QtVideoOutput(configuration_), std::bind(&QObject::deleteLater, std::placeholders::_1));
 #endif
-    return std::make_shared<VideoService>(ioService_, messenger, std::move(videoOutput));
+    }
+
+    return videoOutput_;
+}
+
+projection::IAudioOutput::Pointer ServiceFactory::getAudioOutput(projection::IAudioOutput::Pointer& audioOutput, uint32_t channelCount, uint32_t sampleSize, uint32_t sampleRate)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    if(audioOutputBackendType_ != configuration_->getAudioOutputBackendType())
+    {
+        audioOutputBackendType_ = configuration_->getAudioOutputBackendType();
+        mediaAudioOutput_.reset();
+        speechAudioOutput_.reset();
+        systemAudioOutput_.reset();
+    }
+
+    if(audioOutput == nullptr)
+    {
+        audioOutput = audioOutputBackendType_ == configuration::AudioOutputBackendType::RTAUDIO ?
+                    std::make_shared<projection::RtAudioOutput>(channelCount, sampleSize, sampleRate) :
+                    projection::IAudioOutput::Pointer(new projection::QtAudioOutput(channelCount, sampleSize, sampleRate), std::bind(&QObject::deleteLater, std::placeholders::_1));
+    }
+
+    return audioOutput;
+}
+
+IService::Pointer ServiceFactory::createVideoService(aasdk::messenger::IMessenger::Pointer messenger, SessionTimeline::Pointer sessionTimeline)
+{
+    return std::make_shared<VideoService>(mediaIoService_, messenger, this->getVideoOutput(), std::move(sessionTimeline));
+}
+
+IService::Pointer ServiceFactory::createSensorService(aasdk::messenger::IMessenger::Pointer messenger)
+{
+    projection::IVehicleDataSource::Pointer vehicleDataSource;
+    if(!configuration_->getCANInterface().empty())
+    {
+        vehicleDataSource = std::make_shared<projection::CANVehicleDataSource>(configuration_->getCANInterface(),
+                                                                              configuration_->getCANDecodingTable(),
+                                                                              std::chrono::milliseconds(configuration_->getCANPublishInterval()));
+    }
+    else
+    {
+        vehicleDataSource = std::make_shared<projection::DummyVehicleDataSource>();
+    }
+
+    return std::make_shared<SensorService>(ioService_, messenger, configuration_, std::move(vehicleDataSource));
 }
 
 IService::Pointer ServiceFactory::createBluetoothService(aasdk::messenger::IMessenger::Pointer messenger)
@@ -131,27 +243,15 @@ void ServiceFactory::createAudioServices(ServiceList& serviceList, aasdk::messen
 {
     if(configuration_->musicAudioChannelEnabled())
     {
-        auto mediaAudioOutput = configuration_->getAudioOutputBackendType() == configuration::AudioOutputBackendType::RTAUDIO ?
-                    std::make_shared<projection::RtAudioOutput>(2, 16, 48000) :
-                    projection::IAudioOutput::Pointer(new projection::QtAudioOutput(2, 16, 48000), std::bind(&QObject::deleteLater, std::placeholders::_1));
-
-        serviceList.emplace_back(std::make_shared<MediaAudioService>(ioService_, messenger, std::move(mediaAudioOutput)));
+        serviceList.emplace_back(std::make_shared<MediaAudioService>(mediaIoService_, messenger, this->getAudioOutput(mediaAudioOutput_, 2, 16, 48000)));
     }
 
     if(configuration_->speechAudioChannelEnabled())
     {
-        auto speechAudioOutput = configuration_->getAudioOutputBackendType() == configuration::AudioOutputBackendType::RTAUDIO ?
-                    std::make_shared<projection::RtAudioOutput>(1, 16, 16000) :
-                    projection::IAudioOutput::Pointer(new projection::QtAudioOutput(1, 16, 16000), std::bind(&QObject::deleteLater, std::placeholders::_1));
-
-        serviceList.emplace_back(std::make_shared<SpeechAudioService>(ioService_, messenger, std::move(speechAudioOutput)));
+        serviceList.emplace_back(std::make_shared<SpeechAudioService>(mediaIoService_, messenger, this->getAudioOutput(speechAudioOutput_, 1, 16, 16000)));
     }
 
-    auto systemAudioOutput = configuration_->getAudioOutputBackendType() == configuration::AudioOutputBackendType::RTAUDIO ?
-                std::make_shared<projection::RtAudioOutput>(1, 16, 16000) :
-                projection::IAudioOutput::Pointer(new projection::QtAudioOutput(1, 16, 16000), std::bind(&QObject::deleteLater, std::placeholders::_1));
-
-    serviceList.emplace_back(std::make_shared<SystemAudioService>(ioService_, messenger, std::move(systemAudioOutput)));
+    serviceList.emplace_back(std::make_shared<SystemAudioService>(mediaIoService_, messenger, this->getAudioOutput(systemAudioOutput_, 1, 16, 16000)));
 }
 
 }
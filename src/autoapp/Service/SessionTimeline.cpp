@@ -0,0 +1,140 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <sstream>
+#include <f1x/openauto/autoapp/Service/SessionTimeline.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace service
+{
+
+const std::string SessionTimeline::cHistoryFileName = "openauto_sessions.log";
+
+SessionTimeline::SessionTimeline(std::string transportName)
+    : transportName_(std::move(transportName))
+    , startTime_(std::time(nullptr))
+    , startTimestamp_(std::chrono::steady_clock::now())
+    , reported_(false)
+{
+    milestones_.reserve(32);
+    milestones_.emplace_back("attach", startTimestamp_);
+}
+
+void SessionTimeline::mark(const std::string& milestone)
+{
+    const auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    auto it = std::find_if(milestones_.begin(), milestones_.end(), [&milestone](const Milestone& m) { return m.first == milestone; });
+    if(it == milestones_.end())
+    {
+        milestones_.emplace_back(milestone, now);
+    }
+}
+
+std::chrono::steady_clock::time_point SessionTimeline::getStartTimestamp() const
+{
+    return startTimestamp_;
+}
+
+void SessionTimeline::report(size_t historySize)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    if(reported_)
+    {
+        return;
+    }
+
+    reported_ = true;
+
+    char startTime[32];
+    std::strftime(startTime, sizeof(startTime), "%Y-%m-%d %H:%M:%S", std::localtime(&startTime_));
+
+    std::ostringstream history;
+    history << startTime << " " << transportName_;
+
+    OPENAUTO_LOG(info) << "[SessionTimeline] " << transportName_ << " session started at " << startTime << ":";
+
+    auto previous = startTimestamp_;
+    for(const auto& milestone : milestones_)
+    {
+        const auto total = std::chrono::duration_cast<std::chrono::milliseconds>(milestone.second - startTimestamp_).count();
+        const auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(milestone.second - previous).count();
+        previous = milestone.second;
+
+        OPENAUTO_LOG(info) << "[SessionTimeline]   " << milestone.first << ": +" << delta << " ms (" << total << " ms)";
+
+        std::string key(milestone.first);
+        std::replace(key.begin(), key.end(), ' ', '_');
+        history << " " << key << "=" << total;
+    }
+
+    if(historySize > 0)
+    {
+        this->appendHistory(history.str(), historySize);
+    }
+}
+
+void SessionTimeline::appendHistory(const std::string& line, size_t historySize)
+{
+    std::deque<std::string> lines;
+
+    std::ifstream input(cHistoryFileName);
+    std::string current;
+    while(std::getline(input, current))
+    {
+        lines.push_back(current);
+    }
+    input.close();
+
+    lines.push_back(line);
+    while(lines.size() > historySize)
+    {
+        lines.pop_front();
+    }
+
+    const std::string tempFileName = cHistoryFileName + ".tmp";
+    std::ofstream output(tempFileName, std::ios::trunc);
+    for(const auto& entry : lines)
+    {
+        output << entry << "\n";
+    }
+    output.close();
+
+    if(!output || std::rename(tempFileName.c_str(), cHistoryFileName.c_str()) != 0)
+    {
+        OPENAUTO_LOG(error) << "[SessionTimeline] Failed to write session history: " << cHistoryFileName;
+    }
+}
+
+}
+}
+}
+}
@@ -0,0 +1,108 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <aasdk_proto/ControlMessageIdsEnum.pb.h>
+#include <aasdk_proto/AVChannelMessageIdsEnum.pb.h>
+#include <f1x/openauto/autoapp/Service/TimelineMessenger.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace service
+{
+
+TimelineMessenger::TimelineMessenger(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger, SessionTimeline::Pointer sessionTimeline)
+    : ioService_(ioService)
+    , messenger_(std::move(messenger))
+    , sessionTimeline_(std::move(sessionTimeline))
+{
+    for(auto& completed : completedChannels_)
+    {
+        completed = false;
+    }
+
+    completedChannels_[static_cast<size_t>(aasdk::messenger::ChannelId::CONTROL)] = true;
+}
+
+void TimelineMessenger::enqueueReceive(aasdk::messenger::ChannelId channelId, aasdk::messenger::ReceivePromise::Pointer promise)
+{
+    if(completedChannels_[static_cast<uint8_t>(channelId)])
+    {
+        messenger_->enqueueReceive(channelId, std::move(promise));
+        return;
+    }
+
+    auto inspectPromise = aasdk::messenger::ReceivePromise::defer(ioService_);
+    inspectPromise->then([this, self = this->shared_from_this(), promise](aasdk::messenger::Message::Pointer message) {
+                             this->inspect(*message);
+                             promise->resolve(std::move(message));
+                         },
+                         [promise](const aasdk::error::Error& e) {
+                             promise->reject(e);
+                         });
+
+    messenger_->enqueueReceive(channelId, std::move(inspectPromise));
+}
+
+void TimelineMessenger::enqueueSend(aasdk::messenger::Message::Pointer message, aasdk::messenger::SendPromise::Pointer promise)
+{
+    messenger_->enqueueSend(std::move(message), std::move(promise));
+}
+
+void TimelineMessenger::stop()
+{
+    messenger_->stop();
+}
+
+void TimelineMessenger::inspect(const aasdk::messenger::Message& message)
+{
+    const auto& payload = message.getPayload();
+    if(payload.size() < 2)
+    {
+        return;
+    }
+
+    const uint16_t messageId = (payload[0] << 8) | payload[1];
+    const auto channelName = aasdk::messenger::channelIdToString(message.getChannelId());
+
+    if(message.getType() == aasdk::messenger::MessageType::CONTROL)
+    {
+        if(messageId == aasdk::proto::ids::ControlMessage::CHANNEL_OPEN_REQUEST)
+        {
+            sessionTimeline_->mark("channel open " + channelName);
+        }
+    }
+    else if(messageId == aasdk::proto::ids::AVChannelMessage::SETUP_REQUEST)
+    {
+        sessionTimeline_->mark("channel setup " + channelName);
+    }
+    else if(messageId == aasdk::proto::ids::AVChannelMessage::AV_MEDIA_WITH_TIMESTAMP_INDICATION ||
+            messageId == aasdk::proto::ids::AVChannelMessage::AV_MEDIA_INDICATION)
+    {
+        sessionTimeline_->mark("first media " + channelName);
+        completedChannels_[static_cast<uint8_t>(message.getChannelId())] = true;
+    }
+}
+
+}
+}
+}
+}
@@ -29,11 +29,13 @@ namespace autoapp
 namespace service
 {
 
-VideoService::VideoService(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger, projection::IVideoOutput::Pointer videoOutput)
+VideoService::VideoService(boost::asio::io_service& ioService, aasdk::messenger::IMessenger::Pointer messenger, projection::IVideoOutput::Pointer videoOutput, SessionTimeline::Pointer sessionTimeline)
     : strand_(ioService)
     , channel_(std::make_shared<aasdk::channel::av::VideoServiceChannel>(strand_, std::move(messenger)))
     , videoOutput_(std::move(videoOutput))
     , session_(-1)
+    , sessionTimeline_(std::move(sessionTimeline))
+    , firstFrameReceived_(false)
 {
 
 }
@@ -120,6 +122,7 @@ void VideoService::onAVChannelStopIndication(const aasdk::proto::messages::AVCha
 void VideoService::onAVMediaWithTimestampIndication(aasdk::messenger::Timestamp::ValueType timestamp, const aasdk::common::DataConstBuffer& buffer)
 {
     videoOutput_->write(timestamp, buffer);
+    this->onFirstFrame();
 
     aasdk::proto::messages::AVMediaAckIndication indication;
     indication.set_session(session_);
@@ -135,6 +138,7 @@ void VideoService::onAVMediaWithTimestampIndication(aasdk::messenger::Timestamp:
 void VideoService::onAVMediaIndication(const aasdk::common::DataConstBuffer& buffer)
 {
     videoOutput_->write(0, buffer);
+    this->onFirstFrame();
 
     aasdk::proto::messages::AVMediaAckIndication indication;
     indication.set_session(session_);
@@ -208,6 +212,15 @@ void VideoService::sendVideoFocusIndication()
     channel_->sendVideoFocusIndication(videoFocusIndication, std::move(promise));
 }
 
+void VideoService::onFirstFrame()
+{
+    if(!firstFrameReceived_)
+    {
+        firstFrameReceived_ = true;
+        sessionTimeline_->mark("video frame written");
+    }
+}
+
 }
 }
 }
@@ -0,0 +1,197 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <fstream>
+#include <f1x/openauto/autoapp/StateFileMonitor.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+const std::string StateFileMonitor::cDirectory = "/tmp";
+const char* StateFileMonitor::cFileNames[] = {
+    "entityexit",
+    "blankscreen",
+    "screensaver",
+    "blackscreen",
+    "android_device",
+    "bluetooth_pairable",
+    "config_in_progress",
+    "debug_in_progress",
+    "enable_pairing",
+    "night_mode_enabled",
+    "dashcam_is_recording",
+    "external_exit",
+    "hotspot_active",
+    "mobile_hotspot_detected",
+    "temp_recent_list",
+    "daynight_gpio",
+    "tsl2561",
+    "csmt_update_available",
+    "udev_update_available",
+    "openauto_update_available",
+    "system_update_available",
+    "btdevice",
+    "media_playing",
+    "dev_mode_enabled",
+    "wifi_ssid",
+    "gateway_wlan0"
+};
+
+StateFileMonitor::StateFileMonitor(QObject* parent)
+    : QObject(parent)
+    , inotifyFd_(-1)
+{
+    static_assert(sizeof(cFileNames) / sizeof(cFileNames[0]) == static_cast<size_t>(StateFile::COUNT), "state file names out of sync");
+    qRegisterMetaType<StateFile>("f1x::openauto::autoapp::StateFile");
+
+    for(size_t i = 0; i < static_cast<size_t>(StateFile::COUNT); ++i)
+    {
+        names_[cFileNames[i]] = static_cast<StateFile>(i);
+    }
+
+    contentTracked_.set(static_cast<size_t>(StateFile::ANDROID_DEVICE));
+    contentTracked_.set(static_cast<size_t>(StateFile::TSL2561));
+    contentTracked_.set(static_cast<size_t>(StateFile::BTDEVICE));
+    contentTracked_.set(static_cast<size_t>(StateFile::WIFI_SSID));
+    contentTracked_.set(static_cast<size_t>(StateFile::GATEWAY_WLAN0));
+}
+
+StateFileMonitor::~StateFileMonitor()
+{
+    notifier_.reset();
+
+    if(inotifyFd_ >= 0)
+    {
+        close(inotifyFd_);
+    }
+}
+
+bool StateFileMonitor::start()
+{
+    inotifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if(inotifyFd_ < 0 || inotify_add_watch(inotifyFd_, cDirectory.c_str(), IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE) < 0)
+    {
+        OPENAUTO_LOG(error) << "[StateFileMonitor] cannot watch " << cDirectory << ", errno: " << errno;
+        return false;
+    }
+
+    notifier_ = std::make_unique<QSocketNotifier>(inotifyFd_, QSocketNotifier::Read, this);
+    connect(notifier_.get(), &QSocketNotifier::activated, this, &StateFileMonitor::onInotifyEvent);
+
+    this->refresh();
+    return true;
+}
+
+bool StateFileMonitor::exists(StateFile file) const
+{
+    return state_.test(static_cast<size_t>(file));
+}
+
+std::string StateFileMonitor::getPath(StateFile file)
+{
+    return cDirectory + "/" + cFileNames[static_cast<size_t>(file)];
+}
+
+QString StateFileMonitor::readContent(StateFile file)
+{
+    std::ifstream inFile(getPath(file));
+    std::string line;
+    std::string result;
+
+    while(std::getline(inFile, line))
+    {
+        result.append(line);
+    }
+
+    return QString::fromStdString(result);
+}
+
+void StateFileMonitor::refresh()
+{
+    struct stat fileStat;
+
+    for(size_t i = 0; i < static_cast<size_t>(StateFile::COUNT); ++i)
+    {
+        state_.set(i, stat(getPath(static_cast<StateFile>(i)).c_str(), &fileStat) == 0);
+    }
+}
+
+void StateFileMonitor::onInotifyEvent()
+{
+    alignas(struct inotify_event) char buffer[4096];
+    std::bitset<static_cast<size_t>(StateFile::COUNT)> changed;
+
+    ssize_t size;
+    while((size = read(inotifyFd_, buffer, sizeof(buffer))) > 0)
+    {
+        for(char* ptr = buffer; ptr < buffer + size; ptr += sizeof(struct inotify_event) + reinterpret_cast<struct inotify_event*>(ptr)->len)
+        {
+            const auto* event = reinterpret_cast<struct inotify_event*>(ptr);
+
+            if((event->mask & IN_Q_OVERFLOW) != 0)
+            {
+                OPENAUTO_LOG(warning) << "[StateFileMonitor] event queue overflow, rescanning.";
+                const auto previous = state_;
+                this->refresh();
+                changed |= previous ^ state_;
+                continue;
+            }
+
+            if(event->len == 0)
+            {
+                continue;
+            }
+
+            const auto it = names_.find(event->name);
+            if(it == names_.end())
+            {
+                continue;
+            }
+
+            const auto index = static_cast<size_t>(it->second);
+            const bool exists = (event->mask & (IN_DELETE | IN_MOVED_FROM)) == 0;
+
+            if(state_.test(index) != exists || (exists && contentTracked_.test(index) && (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) != 0))
+            {
+                changed.set(index);
+            }
+
+            state_.set(index, exists);
+        }
+    }
+
+    for(size_t i = 0; i < static_cast<size_t>(StateFile::COUNT); ++i)
+    {
+        if(changed.test(i))
+        {
+            emit stateFileChanged(static_cast<StateFile>(i), state_.test(i));
+        }
+    }
+}
+
+}
+}
+}
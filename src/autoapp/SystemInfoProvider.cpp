@@ -0,0 +1,198 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdint.h>
+#include <time.h>
+#include <sys/sysinfo.h>
+#include <chrono>
+#include <fstream>
+#include <QDBusArgument>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusObjectPath>
+#include <QDBusVariant>
+#include <QStringList>
+#include <f1x/openauto/autoapp/SystemInfoProvider.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+const char* const SystemInfoProvider::cCpuFrequencyPath = "/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_cur_freq";
+const char* const SystemInfoProvider::cCpuTemperaturePath = "/sys/class/thermal/thermal_zone0/temp";
+
+SystemInfoProvider::SystemInfoProvider(QObject* parent)
+    : QObject(parent)
+    , refreshRequested_(false)
+    , stopping_(false)
+    , thread_(&SystemInfoProvider::run, this)
+{
+    qRegisterMetaType<SystemInfo>("f1x::openauto::autoapp::SystemInfo");
+}
+
+SystemInfoProvider::~SystemInfoProvider()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+
+    condition_.notify_all();
+    thread_.join();
+}
+
+void SystemInfoProvider::refresh()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        refreshRequested_ = true;
+    }
+
+    condition_.notify_all();
+}
+
+void SystemInfoProvider::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while(true)
+    {
+        condition_.wait(lock, [this]() { return stopping_ || refreshRequested_; });
+        if(stopping_)
+        {
+            break;
+        }
+
+        refreshRequested_ = false;
+        lock.unlock();
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto info = this->collect();
+        OPENAUTO_LOG(debug) << "[SystemInfoProvider] Collected in "
+                            << std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count() << " us.";
+        emit systemInfoUpdated(info);
+
+        lock.lock();
+    }
+}
+
+SystemInfo SystemInfoProvider::collect() const
+{
+    SystemInfo info;
+
+    struct sysinfo memory;
+    info.freeMemory = sysinfo(&memory) == 0 ? static_cast<unsigned long>(static_cast<uint64_t>(memory.freeram) * memory.mem_unit / 1024 / 1024) : 0;
+    info.cpuFrequency = static_cast<int>(readValue(cCpuFrequencyPath) / 1000);
+    info.cpuTemperature = static_cast<int>(readValue(cCpuTemperaturePath) / 1000);
+    info.disconnectTimer = this->getTimerLeft("*disconnect*.timer");
+    info.shutdownTimer = this->getTimerLeft("*shutdown*.timer");
+
+    return info;
+}
+
+QString SystemInfoProvider::getTimerLeft(const QString& pattern) const
+{
+    QDBusConnection connection = QDBusConnection::systemBus();
+
+    auto listUnits = QDBusMessage::createMethodCall("org.freedesktop.systemd1", "/org/freedesktop/systemd1", "org.freedesktop.systemd1.Manager", "ListUnitsByPatterns");
+    listUnits << QStringList() << QStringList(pattern);
+
+    const auto reply = connection.call(listUnits);
+    if(reply.type() != QDBusMessage::ReplyMessage || reply.arguments().isEmpty())
+    {
+        OPENAUTO_LOG(warning) << "[SystemInfoProvider] Cannot list " << pattern.toStdString() << ": " << reply.errorMessage().toStdString();
+        return "Stopped";
+    }
+
+    QStringList timerPaths;
+    const auto units = reply.arguments().at(0).value<QDBusArgument>();
+    units.beginArray();
+    while(!units.atEnd())
+    {
+        QString name, description, loadState, activeState, subState, following, jobType;
+        QDBusObjectPath path, jobPath;
+        uint jobId = 0;
+
+        units.beginStructure();
+        units >> name >> description >> loadState >> activeState >> subState >> following >> path >> jobId >> jobType >> jobPath;
+        units.endStructure();
+        timerPaths << path.path();
+    }
+    units.endArray();
+
+    const auto getProperty = [&connection](const QString& path, const QString& property) -> unsigned long long {
+        auto get = QDBusMessage::createMethodCall("org.freedesktop.systemd1", path, "org.freedesktop.DBus.Properties", "Get");
+        get << QString("org.freedesktop.systemd1.Timer") << property;
+
+        const auto value = connection.call(get);
+        return value.type() == QDBusMessage::ReplyMessage && !value.arguments().isEmpty()
+                ? value.arguments().at(0).value<QDBusVariant>().variant().toULongLong() : 0;
+    };
+
+    for(const auto& path : timerPaths)
+    {
+        const auto realtime = getProperty(path, "NextElapseUSecRealtime");
+        if(realtime != 0)
+        {
+            const auto now = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            return formatTimespan(realtime > static_cast<unsigned long long>(now) ? realtime - now : 0);
+        }
+
+        const auto monotonic = getProperty(path, "NextElapseUSecMonotonic");
+        if(monotonic != 0)
+        {
+            timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            const auto nowUsec = static_cast<unsigned long long>(now.tv_sec) * 1000000 + now.tv_nsec / 1000;
+            return formatTimespan(monotonic > nowUsec ? monotonic - nowUsec : 0);
+        }
+    }
+
+    return "Stopped";
+}
+
+long SystemInfoProvider::readValue(const char* path)
+{
+    long value = 0;
+    std::ifstream file(path);
+    file >> value;
+    return value;
+}
+
+QString SystemInfoProvider::formatTimespan(unsigned long long usec)
+{
+    const auto seconds = usec / 1000000;
+    if(seconds >= 3600)
+    {
+        return QString("%1h %2min").arg(seconds / 3600).arg(seconds % 3600 / 60);
+    }
+    else if(seconds >= 60)
+    {
+        return QString("%1min %2s").arg(seconds / 60).arg(seconds % 60);
+    }
+
+    return QString("%1s").arg(seconds);
+}
+
+}
+}
+}
@@ -0,0 +1,207 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QImageReader>
+#include <f1x/openauto/autoapp/ThumbnailCache.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+const QString ThumbnailCache::cDiskCacheDirectory = "/media/USBDRIVES/CSSTORAGE/COVERCACHE/.thumbnails";
+const int ThumbnailCache::cThumbnailSize = 270;
+const int ThumbnailCache::cMemoryCacheSize = 16 * 1024;
+
+ThumbnailCache::ThumbnailCache(QObject* parent)
+    : QObject(parent)
+    , memory_(cMemoryCacheSize)
+    , stopping_(false)
+    , thread_(&ThumbnailCache::run, this)
+{
+    connect(this, &ThumbnailCache::thumbnailDecoded, this, &ThumbnailCache::onThumbnailDecoded, Qt::QueuedConnection);
+}
+
+ThumbnailCache::~ThumbnailCache()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        jobs_.clear();
+    }
+
+    condition_.notify_all();
+    thread_.join();
+}
+
+bool ThumbnailCache::find(const QString& key, QPixmap& pixmap) const
+{
+    const QPixmap* cached = memory_.object(key);
+    if(cached == nullptr)
+    {
+        return false;
+    }
+
+    pixmap = cached->isNull() ? getPlaceholder() : *cached;
+    return true;
+}
+
+void ThumbnailCache::request(const QString& key, const QStringList& candidates, bool urgent)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(pending_.contains(key))
+        {
+            if(!urgent)
+            {
+                return;
+            }
+
+            for(auto it = jobs_.begin(); it != jobs_.end(); ++it)
+            {
+                if(it->key == key)
+                {
+                    jobs_.erase(it);
+                    break;
+                }
+            }
+        }
+
+        pending_.insert(key);
+        if(urgent)
+        {
+            jobs_.push_front(Job{key, candidates});
+        }
+        else
+        {
+            jobs_.push_back(Job{key, candidates});
+        }
+    }
+
+    condition_.notify_one();
+}
+
+void ThumbnailCache::clear()
+{
+    memory_.clear();
+}
+
+const QPixmap& ThumbnailCache::getPlaceholder()
+{
+    static const QPixmap placeholder("://coverlogo.png");
+    return placeholder;
+}
+
+void ThumbnailCache::onThumbnailDecoded(const QString& key, const QImage& image)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.remove(key);
+    }
+
+    QPixmap* pixmap = new QPixmap(QPixmap::fromImage(image));
+    memory_.insert(key, pixmap, std::max(1, pixmap->width() * pixmap->height() * 4 / 1024));
+    emit thumbnailReady(key, pixmap->isNull() ? getPlaceholder() : *pixmap);
+}
+
+void ThumbnailCache::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while(!stopping_)
+    {
+        if(jobs_.empty())
+        {
+            condition_.wait(lock);
+            continue;
+        }
+
+        Job job = std::move(jobs_.front());
+        jobs_.pop_front();
+        lock.unlock();
+
+        const auto start = std::chrono::steady_clock::now();
+        QImage image = this->load(job.candidates);
+        const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        OPENAUTO_LOG(debug) << "[ThumbnailCache] " << job.key.toStdString() << " loaded in " << duration.count() << " ms.";
+
+        emit thumbnailDecoded(job.key, image);
+        lock.lock();
+    }
+}
+
+QImage ThumbnailCache::load(const QStringList& candidates) const
+{
+    for(const auto& candidate : candidates)
+    {
+        QFileInfo source(candidate);
+        if(!source.isFile())
+        {
+            continue;
+        }
+
+        const QByteArray id = (source.absoluteFilePath() + ":" + QString::number(source.size()) + ":"
+                               + QString::number(source.lastModified().toMSecsSinceEpoch())).toUtf8();
+        const QString diskPath = cDiskCacheDirectory + "/" + QCryptographicHash::hash(id, QCryptographicHash::Md5).toHex() + ".png";
+
+        QImage image;
+        if(image.load(diskPath))
+        {
+            return image;
+        }
+
+        QImageReader reader(candidate);
+        if(reader.size().isValid())
+        {
+            reader.setScaledSize(reader.size().scaled(cThumbnailSize, cThumbnailSize, Qt::KeepAspectRatio));
+        }
+
+        if(!reader.read(&image))
+        {
+            OPENAUTO_LOG(warning) << "[ThumbnailCache] Cannot decode " << candidate.toStdString() << ": " << reader.errorString().toStdString();
+            continue;
+        }
+
+        if(image.width() > cThumbnailSize || image.height() > cThumbnailSize)
+        {
+            image = image.scaled(cThumbnailSize, cThumbnailSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        }
+
+        if(QDir().mkpath(cDiskCacheDirectory) && !image.save(diskPath, "PNG"))
+        {
+            OPENAUTO_LOG(warning) << "[ThumbnailCache] Cannot store thumbnail " << diskPath.toStdString() << ".";
+        }
+
+        return image;
+    }
+
+    return QImage();
+}
+
+}
+}
+}
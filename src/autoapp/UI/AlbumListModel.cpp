@@ -0,0 +1,122 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QIcon>
+#include <f1x/openauto/autoapp/UI/AlbumListModel.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace ui
+{
+
+AlbumListModel::AlbumListModel(ThumbnailCache* thumbnailCache, QObject* parent)
+    : QAbstractListModel(parent)
+    , thumbnailCache_(thumbnailCache)
+{
+    connect(thumbnailCache_, &ThumbnailCache::thumbnailReady, this, &AlbumListModel::onThumbnailReady);
+}
+
+int AlbumListModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : albums_.size();
+}
+
+QVariant AlbumListModel::data(const QModelIndex& index, int role) const
+{
+    if(!index.isValid() || index.row() >= albums_.size())
+    {
+        return QVariant();
+    }
+
+    const QString& album = albums_[index.row()];
+
+    switch(role)
+    {
+    case Qt::DisplayRole:
+        return album;
+
+    case Qt::DecorationRole:
+    {
+        const QString key = this->getCoverKey(album);
+        QPixmap pixmap;
+        if(!thumbnailCache_->find(key, pixmap))
+        {
+            pixmap = ThumbnailCache::getPlaceholder();
+            thumbnailCache_->request(key, this->getCovers(album), true);
+        }
+
+        return QIcon(pixmap);
+    }
+
+    case Qt::UserRole:
+        return this->getCoverKey(album);
+
+    default:
+        return QVariant();
+    }
+}
+
+void AlbumListModel::setAlbums(const QString& rootPath, const QStringList& albums)
+{
+    this->beginResetModel();
+    rootPath_ = rootPath;
+    albums_ = albums;
+    rows_.clear();
+    for(int row = 0; row < albums_.size(); ++row)
+    {
+        rows_.insert(this->getCoverKey(albums_[row]), row);
+    }
+    this->endResetModel();
+}
+
+const QStringList& AlbumListModel::getAlbums() const
+{
+    return albums_;
+}
+
+QString AlbumListModel::getCoverKey(const QString& album) const
+{
+    return rootPath_ + "/" + album;
+}
+
+QStringList AlbumListModel::getCovers(const QString& album) const
+{
+    return QStringList() << rootPath_ + "/" + album + "/folder.png"
+                         << rootPath_ + "/" + album + "/folder.jpg"
+                         << "/media/USBDRIVES/CSSTORAGE/COVERCACHE/" + album + ".png"
+                         << "/media/USBDRIVES/CSSTORAGE/COVERCACHE/" + album + ".jpg";
+}
+
+void AlbumListModel::onThumbnailReady(const QString& key)
+{
+    auto it = rows_.find(key);
+    if(it != rows_.end())
+    {
+        const QModelIndex modelIndex = this->index(it.value());
+        emit dataChanged(modelIndex, modelIndex, QVector<int>() << Qt::DecorationRole);
+    }
+}
+
+}
+}
+}
+}
@@ -4,7 +4,7 @@
 #include <QFileInfo>
 #include <QTextStream>
 #include <fstream>
-#include <QNetworkInterface>
+#include <algorithm>
 
 namespace f1x
 {
@@ -15,13 +15,18 @@ namespace autoapp
 namespace ui
 {
 
-ConnectDialog::ConnectDialog(boost::asio::io_service& ioService, aasdk::tcp::ITCPWrapper& tcpWrapper, openauto::autoapp::configuration::IRecentAddressesList& recentAddressesList, QWidget *parent)
+ConnectDialog::ConnectDialog(boost::asio::io_service& ioService, aasdk::tcp::ITCPWrapper& tcpWrapper, openauto::autoapp::configuration::IRecentAddressesList& recentAddressesList, HelperClient& helperClient, NetworkMonitor& networkMonitor, common::TCPTuning tcpTuning, QWidget *parent)
     : QDialog(parent)
     , ioService_(ioService)
     , tcpWrapper_(tcpWrapper)
     , recentAddressesList_(recentAddressesList)
+    , helperClient_(helperClient)
+    , networkMonitor_(networkMonitor)
+    , tcpTuning_(std::move(tcpTuning))
     , ui_(new Ui::ConnectDialog)
+    , handlerGuard_(std::make_shared<HandlerGuard>())
 {
+    handlerGuard_->dialog = this;
     qRegisterMetaType<aasdk::tcp::ITCPEndpoint::SocketPointer>("aasdk::tcp::ITCPEndpoint::SocketPointer");
     qRegisterMetaType<std::string>("std::string");
 
@@ -31,6 +36,8 @@ ConnectDialog::ConnectDialog(boost::asio::io_service& ioService, aasdk::tcp::ITC
     connect(this, &ConnectDialog::connectionSucceed, this, &ConnectDialog::onConnectionSucceed);
     connect(this, &ConnectDialog::connectionFailed, this, &ConnectDialog::onConnectionFailed);
     connect(ui_->pushButtonUpdate, &QPushButton::clicked, this, &ConnectDialog::onUpdateButtonClicked);
+    connect(this, &ConnectDialog::clientListUpdated, this, &ConnectDialog::loadClientList);
+    connect(&networkMonitor_, &NetworkMonitor::hotspotClientAppeared, this, &ConnectDialog::onHotspotClientAppeared);
 
     this->loadRecentList();
 
@@ -40,6 +47,16 @@ ConnectDialog::ConnectDialog(boost::asio::io_service& ioService, aasdk::tcp::ITC
 
 ConnectDialog::~ConnectDialog()
 {
+    {
+        std::lock_guard<std::mutex> lock(handlerGuard_->mutex);
+        handlerGuard_->dialog = nullptr;
+    }
+
+    if(connector_ != nullptr)
+    {
+        connector_->cancel();
+    }
+
     delete ui_;
 }
 
@@ -48,22 +65,38 @@ void ConnectDialog::onConnectButtonClicked()
     this->setControlsEnabledStatus(false);
 
     const auto& ipAddress = ui_->lineEditIPAddress->text().toStdString();
-    auto socket = std::make_shared<boost::asio::ip::tcp::socket>(ioService_);
-    ui_->progressBarConnect->show();
-    try
-    {
-        tcpWrapper_.asyncConnect(*socket, ipAddress, 5277, std::bind(&ConnectDialog::connectHandler, this, std::placeholders::_1, ipAddress, socket));
-    }
-    catch(const boost::system::system_error& se)
-    {
-        emit connectionFailed(QString(se.what()));
-    }
+    this->connectToCandidates({ipAddress});
 }
 
 void ConnectDialog::onUpdateButtonClicked()
 {
-    system("/usr/local/bin/autoapp_helper updaterecent");
-    loadClientList();
+    helperClient_.execute("/usr/local/bin/autoapp_helper updaterecent", [guard = handlerGuard_](int) {
+        std::lock_guard<std::mutex> lock(guard->mutex);
+        if(guard->dialog != nullptr)
+        {
+            emit guard->dialog->clientListUpdated();
+        }
+    });
+}
+
+void ConnectDialog::onHotspotClientAppeared(const QString& address)
+{
+    if (!this->isVisible() || !ui_->listWidgetClients->findItems(address, Qt::MatchExactly).isEmpty()) {
+        return;
+    }
+
+    ui_->listWidgetClients->addItem(address);
+    ui_->lineEditIPAddress->setText(address);
+
+    std::vector<std::string> candidates{address.toStdString()};
+    const auto& others = ui_->progressBarConnect->isVisible() ? candidates_ : recentAddressesList_.getList();
+    for (const auto& other : others) {
+        if (std::find(candidates.begin(), candidates.end(), other) == candidates.end()) {
+            candidates.push_back(other);
+        }
+    }
+
+    this->connectToCandidates(candidates);
 }
 
 void ConnectDialog::connectHandler(const boost::system::error_code& ec, const std::string& ipAddress, aasdk::tcp::ITCPEndpoint::SocketPointer socket)
@@ -71,7 +104,6 @@ void ConnectDialog::connectHandler(const boost::system::error_code& ec, const st
     if(!ec)
     {
         emit connectionSucceed(std::move(socket), ipAddress);
-        this->close();
     }
     else
     {
@@ -82,8 +114,9 @@ void ConnectDialog::connectHandler(const boost::system::error_code& ec, const st
 void ConnectDialog::onConnectionSucceed(aasdk::tcp::ITCPEndpoint::SocketPointer, const std::string& ipAddress)
 {
     ui_->progressBarConnect->hide();
-    //this->insertIpAddress(ipAddress);
+    this->insertIpAddress(ipAddress);
     this->setControlsEnabledStatus(true);
+    this->close();
 }
 
 void ConnectDialog::onConnectionFailed(const QString& message)
@@ -129,7 +162,10 @@ void ConnectDialog::loadClientList()
         cleaner--;
     }
 
-    if (std::ifstream("/tmp/hotspot_active")) {
+    std::vector<std::string> candidates;
+    const NetworkSnapshot snapshot = networkMonitor_.getSnapshot();
+
+    if (snapshot.hotspotActive) {
         ui_->listWidgetClients->show();
         ui_->pushButtonUpdate->show();
         if (std::ifstream("/tmp/temp_recent_list")) {
@@ -142,58 +178,63 @@ void ConnectDialog::loadClientList()
                 if (ip != "") {
                     ui_->listWidgetClients->addItem(ip);
                     ui_->lineEditIPAddress->setText(ip);
-                    //ConnectDialog::insertIpAddress(ip.toStdString());
+                    candidates.push_back(ip.toStdString());
                 }
             }
             versionFile.close();
-            if (ui_->listWidgetClients->count() == 1) {
-                this->setControlsEnabledStatus(false);
-                const auto& ipAddress = ui_->lineEditIPAddress->text().toStdString();
-                auto socket = std::make_shared<boost::asio::ip::tcp::socket>(ioService_);
-                ui_->progressBarConnect->show();
-                try
-                {
-                    tcpWrapper_.asyncConnect(*socket, ipAddress, 5277, std::bind(&ConnectDialog::connectHandler, this, std::placeholders::_1, ipAddress, socket));
-                }
-                catch(const boost::system::system_error& se)
-                {
-                    emit connectionFailed(QString(se.what()));
-                }
-            }
         } else {
             ui_->lineEditIPAddress->setText("");
         }
+        for (const auto& client : snapshot.hotspotClients) {
+            if (std::find(candidates.begin(), candidates.end(), client.toStdString()) == candidates.end()) {
+                ui_->listWidgetClients->addItem(client);
+                ui_->lineEditIPAddress->setText(client);
+                candidates.push_back(client.toStdString());
+            }
+        }
     } else {
         ui_->listWidgetClients->hide();
-        if (std::ifstream("/tmp/gateway_wlan0")) {
+        const QString gateway = snapshot.interfaces.value(NetworkMonitor::cWirelessInterface).gateway;
+        if (gateway != "") {
             ui_->pushButtonUpdate->hide();
-            QFile gatewayData(QString("/tmp/gateway_wlan0"));
-            gatewayData.open(QIODevice::ReadOnly);
-            QTextStream gateway_date(&gatewayData);
-            QString linedate = gateway_date.readAll();
-            gatewayData.close();
-            if (linedate != "") {
-                ui_->lineEditIPAddress->setText(linedate.simplified());
-                ui_->listWidgetClients->addItem(linedate.simplified());
-                if (ui_->listWidgetClients->count() == 1) {
-                    this->setControlsEnabledStatus(false);
-                    const auto& ipAddress = ui_->lineEditIPAddress->text().toStdString();
-                    auto socket = std::make_shared<boost::asio::ip::tcp::socket>(ioService_);
-                    ui_->progressBarConnect->show();
-                    try
-                    {
-                        tcpWrapper_.asyncConnect(*socket, ipAddress, 5277, std::bind(&ConnectDialog::connectHandler, this, std::placeholders::_1, ipAddress, socket));
-                    }
-                    catch(const boost::system::system_error& se)
-                    {
-                        emit connectionFailed(QString(se.what()));
-                    }
-                }
-            }
+            ui_->lineEditIPAddress->setText(gateway);
+            ui_->listWidgetClients->addItem(gateway);
+            candidates.push_back(gateway.toStdString());
         } else {
             ui_->lineEditIPAddress->setText("");
         }
     }
+
+    for (const auto& address : recentAddressesList_.getList()) {
+        if (std::find(candidates.begin(), candidates.end(), address) == candidates.end()) {
+            candidates.push_back(address);
+        }
+    }
+
+    if (!candidates.empty()) {
+        this->connectToCandidates(candidates);
+    }
+}
+
+void ConnectDialog::connectToCandidates(const std::vector<std::string>& candidates)
+{
+    if(connector_ != nullptr)
+    {
+        connector_->cancel();
+    }
+
+    candidates_ = candidates;
+    this->setControlsEnabledStatus(false);
+    ui_->progressBarConnect->show();
+
+    connector_ = std::make_shared<ParallelConnector>(ioService_, tcpWrapper_, tcpTuning_, 5277, 250, 3000);
+    connector_->connect(candidates, [guard = handlerGuard_](const boost::system::error_code& ec, const std::string& ipAddress, aasdk::tcp::ITCPEndpoint::SocketPointer socket) {
+        std::lock_guard<std::mutex> lock(guard->mutex);
+        if(guard->dialog != nullptr)
+        {
+            guard->dialog->connectHandler(ec, ipAddress, std::move(socket));
+        }
+    });
 }
 
 void ConnectDialog::insertIpAddress(const std::string& ipAddress)
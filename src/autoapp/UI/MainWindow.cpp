@@ -22,6 +22,7 @@
 #include <QFile>
 #include "ui_mainwindow.h"
 #include <QTimer>
+#include <QElapsedTimer>
 #include <QDateTime>
 #include <QMessageBox>
 #include <QTextStream>
@@ -30,8 +31,7 @@
 #include <QScreen>
 #include <QRect>
 #include <QVideoWidget>
-#include <QNetworkInterface>
-#include <QStandardItemModel>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <cstdio>
@@ -47,9 +47,15 @@ namespace autoapp
 namespace ui
 {
 
-MainWindow::MainWindow(configuration::IConfiguration::Pointer configuration, QWidget *parent)
+const std::chrono::milliseconds MainWindow::cDayNightRampDuration(1000);
+const std::chrono::milliseconds MainWindow::cLuxRampDuration(2000);
+
+MainWindow::MainWindow(configuration::IConfiguration::Pointer configuration, HelperClient& helperClient, VolumeController& volumeController, NetworkMonitor& networkMonitor, QWidget *parent)
     : QMainWindow(parent)
     , ui_(new Ui::MainWindow)
+    , helperClient_(helperClient)
+    , volumeController_(volumeController)
+    , networkMonitor_(networkMonitor)
     , localDevice(new QBluetoothLocalDevice)
 {
     // set default bg color to black
@@ -206,17 +212,9 @@ MainWindow::MainWindow(configuration::IConfiguration::Pointer configuration, QWi
 
     ui_->btDevice->hide();
 
-    // check if a device is connected via bluetooth
+    // cache name of device connected via bluetooth
     if (std::ifstream("/tmp/btdevice")) {
-        if (ui_->btDevice->isVisible() == false || ui_->btDevice->text().simplified() == "") {
-            QString btdevicename = configuration_->readFileContent("/tmp/btdevice");
-            ui_->btDevice->setText(btdevicename);
-            ui_->btDevice->show();
-        }
-    } else {
-        if (ui_->btDevice->isVisible() == true) {
-            ui_->btDevice->hide();
-        }
+        bluetoothDeviceName = configuration_->readFileContent("/tmp/btdevice");
     }
 
     // hide brightness slider of control file is not existing
@@ -396,6 +394,8 @@ MainWindow::MainWindow(configuration::IConfiguration::Pointer configuration, QWi
         ui_->devlabel_right->hide();
     }
 
+    backlightController_ = new BacklightController(this);
+
     // set brightness slider attribs from cs config
     ui_->horizontalSliderBrightness->setMinimum(configuration->getCSValue("BR_MIN").toInt());
     ui_->horizontalSliderBrightness->setMaximum(configuration->getCSValue("BR_MAX").toInt());
@@ -411,12 +411,21 @@ MainWindow::MainWindow(configuration::IConfiguration::Pointer configuration, QWi
         this->customBrightnessControl = true;
     }
 
-    // read param file
-    if (std::ifstream("/boot/crankshaft/volume")) {
-        // init volume
-        QString vol=QString::number(configuration_->readFileContent("/boot/crankshaft/volume").toInt());
-        ui_->volumeValueLabel->setText(vol+"%");
-        ui_->horizontalSliderVolume->setValue(vol.toInt());
+    connect(backlightController_, &BacklightController::brightnessChanged, this, &MainWindow::onBrightnessChanged);
+    if (!backlightController_->start((this->customBrightnessControl ? brightnessFilenameAlt : brightnessFilename).toStdString())) {
+        OPENAUTO_LOG(warning) << "[OpenAuto] Backlight control unavailable.";
+    }
+
+    // init volume from mixer or param file
+    volumeSaveTimer_ = new QTimer(this);
+    volumeSaveTimer_->setSingleShot(true);
+    volumeSaveTimer_->setInterval(1000);
+    connect(volumeSaveTimer_, &QTimer::timeout, this, &MainWindow::saveVolume);
+    connect(&volumeController_, &VolumeController::playbackVolumeChanged, this, &MainWindow::onPlaybackVolumeChanged);
+    if (volumeController_.getPlaybackVolume() >= 0) {
+        onPlaybackVolumeChanged(volumeController_.getPlaybackVolume());
+    } else if (std::ifstream("/boot/crankshaft/volume")) {
+        onPlaybackVolumeChanged(configuration_->readFileContent("/boot/crankshaft/volume").toInt());
     }
 
     // switch to old menu if set in settings
@@ -530,38 +539,62 @@ MainWindow::MainWindow(configuration::IConfiguration::Pointer configuration, QWi
     ui_->comboBoxAlbum->hide();
     ui_->pushButtonAlbum->hide();
 
+    stateFileMonitor_ = new StateFileMonitor(this);
+    connect(stateFileMonitor_, &StateFileMonitor::stateFileChanged, this, &MainWindow::onStateFileChanged);
+    if (!stateFileMonitor_->start()) {
+        OPENAUTO_LOG(error) << "[OpenAuto] State file monitor start failed.";
+    }
+
+    thumbnailCache_ = new ThumbnailCache(this);
+    connect(thumbnailCache_, &ThumbnailCache::thumbnailReady, this, &MainWindow::onThumbnailReady);
+
+    albumModel_ = new AlbumListModel(thumbnailCache_, this);
+    ui_->AlbumCoverListView->setModel(albumModel_);
+    ui_->comboBoxAlbum->setModel(albumModel_);
+    trackModel_ = new TrackListModel(this);
+    ui_->mp3List->setModel(trackModel_);
+    connect(ui_->mp3List->selectionModel(), &QItemSelectionModel::currentChanged, this, &MainWindow::onTrackSelected);
+
+    musicLibrary_ = new MusicLibrary(this);
+    connect(musicLibrary_, &MusicLibrary::albumsChanged, this, &MainWindow::updateAlbums);
+    connect(musicLibrary_, &MusicLibrary::albumChanged, this, &MainWindow::onAlbumChanged);
+    connect(musicLibrary_, &MusicLibrary::scanFinished, this, &MainWindow::onLibraryScanFinished);
+    const bool cacheLoaded = musicLibrary_->load(this->musicfolder);
+    MainWindow::updateAlbums(musicLibrary_->getAlbums());
+
     MainWindow::scanFolders();
-    ui_->comboBoxAlbum->setCurrentText(QString::fromStdString(configuration->getMp3SubFolder()));
-    MainWindow::scanFiles();
     player->setPlaylist(this->playlist);
-    ui_->mp3List->setCurrentRow(configuration->getMp3Track());
-    this->currentPlaylistIndex = configuration->getMp3Track();
 
-    if (configuration->mp3AutoPlay()) {
-        MainWindow::playerShow();
-        MainWindow::playerHide();
-        MainWindow::on_pushButtonPlayerPlayList_clicked();
-        if (configuration->showAutoPlay()) {
-            MainWindow::playerShow();
-        }
+    // without the saved track in the cache, wait for the first scan before restoring playback
+    const auto cachedTracks = musicLibrary_->getTracks(QString::fromStdString(configuration->getMp3SubFolder()));
+    this->restorePending = !cacheLoaded || configuration->getMp3Track() < 0 || static_cast<size_t>(configuration->getMp3Track()) >= cachedTracks.size();
+    if (!this->restorePending) {
+        MainWindow::restorePlayback();
     }
 
     watcher = new QFileSystemWatcher(this);
     watcher->addPath("/media/USBDRIVES");
     connect(watcher, &QFileSystemWatcher::directoryChanged, this, &MainWindow::setTrigger);
 
-    watcher_tmp = new QFileSystemWatcher(this);
-    watcher_tmp->addPath("/tmp");
-    connect(watcher_tmp, &QFileSystemWatcher::directoryChanged, this, &MainWindow::tmpChanged);
-
     // Experimental test code
     localDevice = new QBluetoothLocalDevice(this);
 
     connect(localDevice, SIGNAL(hostModeStateChanged(QBluetoothLocalDevice::HostMode)),
             this, SLOT(hostModeStateChanged(QBluetoothLocalDevice::HostMode)));
 
+    connect(localDevice, &QBluetoothLocalDevice::deviceConnected, this, &MainWindow::onBluetoothDeviceConnected);
+    connect(localDevice, &QBluetoothLocalDevice::deviceDisconnected, this, &MainWindow::onBluetoothDeviceDisconnected);
+
     hostModeStateChanged(localDevice->hostMode());
-    updateNetworkInfo();
+    if (localDevice->isValid()) {
+        for (const QBluetoothAddress& address : localDevice->connectedDevices()) {
+            bluetoothDevices.insert(address.toUInt64());
+        }
+    }
+    updateBluetoothDevice();
+
+    connect(&networkMonitor_, &NetworkMonitor::snapshotChanged, this, &MainWindow::onNetworkSnapshotChanged);
+    onNetworkSnapshotChanged(networkMonitor_.getSnapshot());
 }
 
 MainWindow::~MainWindow()
@@ -589,25 +622,50 @@ void f1x::openauto::autoapp::ui::MainWindow::hostModeStateChanged(QBluetoothLoca
         this->bluetoothEnabled = false;
         ui_->pushButtonBluetooth->hide();
         ui_->labelBluetoothPairable->hide();
+        bluetoothDevices.clear();
+        updateBluetoothDevice();
     }
 }
 
-void f1x::openauto::autoapp::ui::MainWindow::updateNetworkInfo()
+void f1x::openauto::autoapp::ui::MainWindow::onBluetoothDeviceConnected(const QBluetoothAddress& address)
 {
-    QNetworkInterface wlan0if = QNetworkInterface::interfaceFromName("wlan0");
-    if (wlan0if.flags().testFlag(QNetworkInterface::IsUp)) {
-        QList<QNetworkAddressEntry> entrieswlan0 = wlan0if.addressEntries();
-        if (!entrieswlan0.isEmpty()) {
-            QNetworkAddressEntry wlan0 = entrieswlan0.first();
-            //qDebug() << "wlan0: " << wlan0.ip();
-            ui_->value_ip->setText(wlan0.ip().toString().simplified());
-            ui_->value_mask->setText(wlan0.netmask().toString().simplified());
-            if (std::ifstream("/tmp/hotspot_active")) {
-                ui_->value_ssid->setText(configuration_->getParamFromFile("/etc/hostapd/hostapd.conf","ssid"));
-            } else {
-                ui_->value_ssid->setText(configuration_->readFileContent("/tmp/wifi_ssid"));
-            }
-            ui_->value_gw->setText(configuration_->readFileContent("/tmp/gateway_wlan0"));
+    bluetoothDevices.insert(address.toUInt64());
+    updateBluetoothDevice();
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::onBluetoothDeviceDisconnected(const QBluetoothAddress& address)
+{
+    bluetoothDevices.remove(address.toUInt64());
+    updateBluetoothDevice();
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::updateBluetoothDevice()
+{
+    // show connected bluetooth device with name cached from /tmp/btdevice
+    if (!bluetoothDevices.isEmpty()) {
+        if (!bluetoothDeviceName.isEmpty()) {
+            ui_->btDevice->setText(bluetoothDeviceName);
+        }
+        if (ui_->btDevice->isVisible() == false) {
+            ui_->btDevice->show();
+        }
+    } else {
+        if (ui_->btDevice->isVisible() == true) {
+            ui_->btDevice->hide();
+            ui_->btDevice->setText("BT-Device");
+        }
+    }
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::onNetworkSnapshotChanged(const NetworkSnapshot& snapshot)
+{
+    const NetworkInterfaceState wlan0 = snapshot.interfaces.value(NetworkMonitor::cWirelessInterface);
+    if (wlan0.up) {
+        if (!wlan0.address.isEmpty()) {
+            ui_->value_ip->setText(wlan0.address);
+            ui_->value_mask->setText(wlan0.netmask);
+            ui_->value_ssid->setText(snapshot.ssid);
+            ui_->value_gw->setText(wlan0.gateway);
         }
     } else {
         //qDebug() << "wlan0: down";
@@ -620,93 +678,49 @@ void f1x::openauto::autoapp::ui::MainWindow::updateNetworkInfo()
 
 void f1x::openauto::autoapp::ui::MainWindow::customButtonPressed1()
 {
-    system(qPrintable(this->custom_button_command_c1 + " &"));
+    helperClient_.execute(this->custom_button_command_c1.toStdString());
 }
 
 void f1x::openauto::autoapp::ui::MainWindow::customButtonPressed2()
 {
-    system(qPrintable(this->custom_button_command_c2 + " &"));
+    helperClient_.execute(this->custom_button_command_c2.toStdString());
 }
 
 void f1x::openauto::autoapp::ui::MainWindow::customButtonPressed3()
 {
-    system(qPrintable(this->custom_button_command_c3 + " &"));
+    helperClient_.execute(this->custom_button_command_c3.toStdString());
 }
 
 void f1x::openauto::autoapp::ui::MainWindow::customButtonPressed4()
 {
-    system(qPrintable(this->custom_button_command_c4 + " &"));
+    helperClient_.execute(this->custom_button_command_c4.toStdString());
 }
 
 void f1x::openauto::autoapp::ui::MainWindow::customButtonPressed5()
 {
-    system(qPrintable(this->custom_button_command_c5 + " &"));
+    helperClient_.execute(this->custom_button_command_c5.toStdString());
 }
 
 void f1x::openauto::autoapp::ui::MainWindow::customButtonPressed6()
 {
-    system(qPrintable(this->custom_button_command_c6 + " &"));
+    helperClient_.execute(this->custom_button_command_c6.toStdString());
 }
 
 
 void f1x::openauto::autoapp::ui::MainWindow::on_pushButtonBrightness_clicked()
 {
-    this->brightnessFile = new QFile(this->brightnessFilename);
-    this->brightnessFileAlt = new QFile(this->brightnessFilenameAlt);
-
     // Get the current brightness value
-    if (!this->customBrightnessControl) {
-        if (this->brightnessFile->open(QIODevice::ReadOnly)) {
-            QByteArray data = this->brightnessFile->readAll();
-            std::string::size_type sz;
-            int brightness_val = std::stoi(data.toStdString(), &sz);
-            ui_->horizontalSliderBrightness->setValue(brightness_val);
-            QString bri=QString::number(brightness_val);
-            ui_->brightnessValueLabel->setText(bri);
-            this->brightnessFile->close();
-        }
-    } else {
-        if (this->brightnessFileAlt->open(QIODevice::ReadOnly)) {
-            QByteArray data = this->brightnessFileAlt->readAll();
-            std::string::size_type sz;
-            int brightness_val = std::stoi(data.toStdString(), &sz);
-            ui_->horizontalSliderBrightness->setValue(brightness_val);
-            QString bri=QString::number(brightness_val);
-            ui_->brightnessValueLabel->setText(bri);
-            this->brightnessFileAlt->close();
-        }
-    }
+    onBrightnessChanged(backlightController_->getBrightness());
+    backlightController_->refresh();
     ui_->BrightnessSliderControl->show();
     ui_->VolumeSliderControl->hide();
 }
 
 void f1x::openauto::autoapp::ui::MainWindow::on_pushButtonBrightness2_clicked()
 {
-    this->brightnessFile = new QFile(this->brightnessFilename);
-    this->brightnessFileAlt = new QFile(this->brightnessFilenameAlt);
-
     // Get the current brightness value
-    if (!this->customBrightnessControl) {
-        if (this->brightnessFile->open(QIODevice::ReadOnly)) {
-            QByteArray data = this->brightnessFile->readAll();
-            std::string::size_type sz;
-            int brightness_val = std::stoi(data.toStdString(), &sz);
-            ui_->horizontalSliderBrightness->setValue(brightness_val);
-            QString bri=QString::number(brightness_val);
-            ui_->brightnessValueLabel->setText(bri);
-            this->brightnessFile->close();
-        }
-    } else {
-        if (this->brightnessFileAlt->open(QIODevice::ReadOnly)) {
-            QByteArray data = this->brightnessFileAlt->readAll();
-            std::string::size_type sz;
-            int brightness_val = std::stoi(data.toStdString(), &sz);
-            ui_->horizontalSliderBrightness->setValue(brightness_val);
-            QString bri=QString::number(brightness_val);
-            ui_->brightnessValueLabel->setText(bri);
-            this->brightnessFileAlt->close();
-        }
-    }
+    onBrightnessChanged(backlightController_->getBrightness());
+    backlightController_->refresh();
     ui_->BrightnessSliderControl->show();
     ui_->VolumeSliderControl->hide();
 }
@@ -739,35 +753,49 @@ void f1x::openauto::autoapp::ui::MainWindow::on_pushButtonVolume2_clicked()
 
 void f1x::openauto::autoapp::ui::MainWindow::on_horizontalSliderBrightness_valueChanged(int value)
 {
-    int n = snprintf(this->brightness_str, 5, "%d", value);
-    this->brightnessFile = new QFile(this->brightnessFilename);
-    this->brightnessFileAlt = new QFile(this->brightnessFilenameAlt);
-
-    if (!this->customBrightnessControl) {
-        if (this->brightnessFile->open(QIODevice::WriteOnly)) {
-            this->brightness_str[n] = '\n';
-            this->brightness_str[n+1] = '\0';
-            this->brightnessFile->write(this->brightness_str);
-            this->brightnessFile->close();
-        }
-    } else {
-        if (this->brightnessFileAlt->open(QIODevice::WriteOnly)) {
-            this->brightness_str[n] = '\n';
-            this->brightness_str[n+1] = '\0';
-            this->brightnessFileAlt->write(this->brightness_str);
-            this->brightnessFileAlt->close();
-        }
-    }
+    backlightController_->setBrightness(value);
     QString bri=QString::number(value);
     ui_->brightnessValueLabel->setText(bri);
 }
 
+void f1x::openauto::autoapp::ui::MainWindow::onBrightnessChanged(int value)
+{
+    if (value < 0 || ui_->horizontalSliderBrightness->isSliderDown()) {
+        return;
+    }
+
+    QSignalBlocker blocker(ui_->horizontalSliderBrightness);
+    ui_->horizontalSliderBrightness->setValue(value);
+    ui_->brightnessValueLabel->setText(QString::number(value));
+}
+
 void f1x::openauto::autoapp::ui::MainWindow::on_horizontalSliderVolume_valueChanged(int value)
 {
     int n = snprintf(this->volume_str, 5, "%d", value);
     QString vol=QString::number(value);
     ui_->volumeValueLabel->setText(vol+"%");
-    system(("/usr/local/bin/autoapp_helper setvolume " + std::to_string(value) + "&").c_str());
+    if (volumeController_.isAvailable()) {
+        volumeController_.setPlaybackVolume(value);
+        volumeSaveTimer_->start();
+    } else {
+        helperClient_.coalesce("setvolume", "/usr/local/bin/autoapp_helper setvolume " + std::to_string(value));
+    }
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::onPlaybackVolumeChanged(int value)
+{
+    if (ui_->horizontalSliderVolume->isSliderDown()) {
+        return;
+    }
+
+    QSignalBlocker blocker(ui_->horizontalSliderVolume);
+    ui_->horizontalSliderVolume->setValue(value);
+    ui_->volumeValueLabel->setText(QString::number(value)+"%");
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::saveVolume()
+{
+    helperClient_.coalesce("setvolume", "/usr/local/bin/autoapp_helper setvolume " + std::to_string(ui_->horizontalSliderVolume->value()));
 }
 
 void f1x::openauto::autoapp::ui::MainWindow::updateAlpha()
@@ -1065,26 +1093,29 @@ void f1x::openauto::autoapp::ui::MainWindow::updateBG()
 
 void f1x::openauto::autoapp::ui::MainWindow::createDebuglog()
 {
-    system("/usr/local/bin/crankshaft debuglog &");
+    helperClient_.execute("/usr/local/bin/crankshaft debuglog");
 }
 
 void f1x::openauto::autoapp::ui::MainWindow::setPairable()
 {
-    system("/usr/local/bin/crankshaft bluetooth pairable &");
+    helperClient_.execute("/usr/local/bin/crankshaft bluetooth pairable");
 }
 
 void f1x::openauto::autoapp::ui::MainWindow::setMute()
 {
-    system("/usr/local/bin/autoapp_helper setmute &");
+    helperClient_.coalesce("mute", "/usr/local/bin/autoapp_helper setmute");
 }
 
 void f1x::openauto::autoapp::ui::MainWindow::setUnMute()
 {
-    system("/usr/local/bin/autoapp_helper setunmute &");
+    helperClient_.coalesce("mute", "/usr/local/bin/autoapp_helper setunmute");
 }
 
 void f1x::openauto::autoapp::ui::MainWindow::showTime()
 {
+    QElapsedTimer tickTimer;
+    tickTimer.start();
+
     QTime time=QTime::currentTime();
     QDate date=QDate::currentDate();
     QString time_text=time.toString("hh : mm : ss");
@@ -1108,30 +1139,14 @@ void f1x::openauto::autoapp::ui::MainWindow::showTime()
         }
     }
 
-    // check connected devices
-    if (localDevice->isValid()) {
-        QString localDeviceName = localDevice->name();
-        QString localDeviceAddress = localDevice->address().toString();
-        QList<QBluetoothAddress> btdevices;
-        btdevices = localDevice->connectedDevices();
-
-        int count = btdevices.count();
-        if (count > 0) {
-            //QBluetoothAddress btdevice = btdevices[0];
-            //QString btmac = btdevice.toString();
-            //ui_->btDeviceCount->setText(QString::number(count));
-            if (ui_->btDevice->isVisible() == false) {
-                ui_->btDevice->show();
-            }
-            if (std::ifstream("/tmp/btdevice")) {
-                ui_->btDevice->setText(configuration_->readFileContent("/tmp/btdevice"));
-            }
-        } else {
-            if (ui_->btDevice->isVisible() == true) {
-                ui_->btDevice->hide();
-                ui_->btDevice->setText("BT-Device");
-            }
-        }
+    const qint64 elapsed = tickTimer.nsecsElapsed();
+    clockTickTotal += elapsed;
+    clockTickMax = std::max(clockTickMax, elapsed);
+    if (++clockTicks == 60) {
+        OPENAUTO_LOG(debug) << "[MainWindow] Clock tick avg: " << clockTickTotal / clockTicks / 1000 << " us, max: " << clockTickMax / 1000 << " us.";
+        clockTickTotal = 0;
+        clockTickMax = 0;
+        clockTicks = 0;
     }
 }
 
@@ -1169,7 +1184,7 @@ void f1x::openauto::autoapp::ui::MainWindow::on_pushButtonList_clicked()
 
 void f1x::openauto::autoapp::ui::MainWindow::on_pushButtonPlayerStop_clicked()
 {
-    ui_->mp3List->setCurrentRow(playlist->currentIndex());
+    ui_->mp3List->setCurrentIndex(trackModel_->index(playlist->currentIndex()));
     player->stop();
     ui_->pushButtonBack->setIcon(QPixmap("://coverlogo.png"));
     ui_->pushButtonPlayerPause->setStyleSheet( "background-color: rgb(233, 185, 110); border-radius: 4px; border: 2px solid rgba(255,255,255,0.5); color: rgb(0,0,0);");
@@ -1251,9 +1266,9 @@ void f1x::openauto::autoapp::ui::MainWindow::on_durationChanged(qint64 position)
     ui_->horizontalSliderProgressPlayer->setMaximum(position);
 }
 
-void f1x::openauto::autoapp::ui::MainWindow::on_mp3List_itemClicked(QListWidgetItem *item)
+void f1x::openauto::autoapp::ui::MainWindow::on_mp3List_clicked(const QModelIndex &index)
 {
-    this->selectedMp3file = item->text();
+    this->selectedMp3file = index.data(Qt::DisplayRole).toString();
 }
 
 void f1x::openauto::autoapp::ui::MainWindow::metaDataChanged()
@@ -1264,26 +1279,23 @@ void f1x::openauto::autoapp::ui::MainWindow::metaDataChanged()
     QImage img = player->metaData(QMediaMetaData::CoverArtImage).value<QImage>();
     QImage imgscaled = img.scaled(270,270,Qt::IgnoreAspectRatio);
     if (!imgscaled.isNull()) {
+        this->currentCoverKey = "";
         ui_->pushButtonBack->setIcon(QPixmap::fromImage(imgscaled));
     } else {
         if (playlist->currentIndex() != -1 && fullpathplaying != "") {
-            QString filename = ui_->mp3List->item(playlist->currentIndex())->text();
+            QString filename = trackModel_->getTitle(playlist->currentIndex());
             QString cover = this->musicfolder + "/" + this->albumfolder + "/" + filename + ".png";
-            if (check_file_exist(cover.toStdString().c_str())) {
-                QPixmap img = cover;
-                ui_->pushButtonBack->setIcon(img.scaled(270,270,Qt::KeepAspectRatio));
-            } else {
-                ui_->pushButtonBack->setIcon(QPixmap("://coverlogo.png"));
-            }
+            MainWindow::showCover(cover, QStringList() << cover);
         } else {
-            ui_->pushButtonBack->setIcon(QPixmap("://coverlogo.png"));
+            this->currentCoverKey = "";
+            ui_->pushButtonBack->setIcon(ThumbnailCache::getPlaceholder());
         }
     }
 
     try {
         // use metadata from mp3list widget (prescanned id3 by taglib)
         if (playlist->currentIndex() != -1 && fullpathplaying != "") {
-            QString currentsong = ui_->mp3List->item(playlist->currentIndex())->text();
+            QString currentsong = trackModel_->getTitle(playlist->currentIndex());
             ui_->labelCurrentPlaying->setText(currentsong);
             if (currentsong.length() > 48) {
                 int id = QFontDatabase::addApplicationFont(":/Roboto-Regular.ttf");
@@ -1325,26 +1337,7 @@ void f1x::openauto::autoapp::ui::MainWindow::metaDataChanged()
 
     if (playlist->currentIndex() == -1) {
         // check for folder icon
-        QString coverpng = this->musicfolder + "/" + this->albumfolder + "/folder.png";
-        QString coverjpg = this->musicfolder + "/" + this->albumfolder + "/folder.jpg";
-        QString coverpngcs = "/media/USBDRIVES/CSSTORAGE/COVERCACHE/" + this->albumfolder + ".png";
-        QString coverjpgcs = "/media/USBDRIVES/CSSTORAGE/COVERCACHE/" + this->albumfolder + ".jpg";
-
-        if (check_file_exist(coverpng.toStdString().c_str())) {
-            QPixmap img = coverpng;
-            ui_->pushButtonBack->setIcon(img.scaled(270,270,Qt::KeepAspectRatio));
-        } else if (check_file_exist(coverjpg.toStdString().c_str())) {
-            QPixmap img = coverjpg;
-            ui_->pushButtonBack->setIcon(img.scaled(270,270,Qt::KeepAspectRatio));
-        } else if (check_file_exist(coverpngcs.toStdString().c_str())) {
-            QPixmap img = coverpngcs;
-            ui_->pushButtonBack->setIcon(img.scaled(270,270,Qt::KeepAspectRatio));
-        } else if (check_file_exist(coverjpgcs.toStdString().c_str())) {
-            QPixmap img = coverjpgcs;
-            ui_->pushButtonBack->setIcon(img.scaled(270,270,Qt::KeepAspectRatio));
-        } else {
-            ui_->pushButtonBack->setIcon(QPixmap("://coverlogo.png"));
-        }
+        MainWindow::showCover(albumModel_->getCoverKey(this->albumfolder), albumModel_->getCovers(this->albumfolder));
         ui_->labelCurrentPlaying->setText(ui_->comboBoxAlbum->currentText());
         ui_->pushButtonPlayerStop->hide();
         ui_->pushButtonPlayerPause->hide();
@@ -1433,110 +1426,144 @@ void f1x::openauto::autoapp::ui::MainWindow::resetRetryUSBMessage()
 
 void f1x::openauto::autoapp::ui::MainWindow::scanFolders()
 {
-    try {
-        if (this->mediacontentchanged == true) {
-            this->mediacontentchanged = false;
-            int cleaner = ui_->comboBoxAlbum->count();
-            while (cleaner > -1) {
-                ui_->comboBoxAlbum->removeItem(cleaner);
-                cleaner--;
-            }
-            QDir directory(this->musicfolder);
-            QStringList folders = directory.entryList(QStringList() << "*", QDir::AllDirs, QDir::Name);
-            QStandardItemModel *model = new QStandardItemModel(this);
-            foreach (QString foldername, folders) {
-                if (foldername != ".." and foldername != ".") {
-                    ui_->comboBoxAlbum->addItem(foldername);
-                    ui_->labelAlbumCount->setText(QString::number(ui_->comboBoxAlbum->count()));                 
-
-                    QString coverpng = this->musicfolder + "/" + foldername + "/folder.png";
-                    QString coverjpg = this->musicfolder + "/" + foldername + "/folder.jpg";
-                    QString coverpngcs = "/media/USBDRIVES/CSSTORAGE/COVERCACHE/" + foldername + ".png";
-                    QString coverjpgcs = "/media/USBDRIVES/CSSTORAGE/COVERCACHE/" + foldername + ".jpg";
-
-                    if (check_file_exist(coverpng.toStdString().c_str())) {
-                        QPixmap img = coverpng;
-                        QStandardItem *item = new QStandardItem(QIcon(img.scaled(270,270,Qt::KeepAspectRatio)),foldername);
-                        model->setItem(ui_->comboBoxAlbum->count(),0,item);
-                    } else if (check_file_exist(coverjpg.toStdString().c_str())) {
-                        QPixmap img = coverjpg;
-                        QStandardItem *item = new QStandardItem(QIcon(img.scaled(270,270,Qt::KeepAspectRatio)),foldername);
-                        model->setItem(ui_->comboBoxAlbum->count(),0,item);
-                    } else if (check_file_exist(coverpngcs.toStdString().c_str())) {
-                        QPixmap img = coverpngcs;
-                        QStandardItem *item = new QStandardItem(QIcon(img.scaled(270,270,Qt::KeepAspectRatio)),foldername);
-                        model->setItem(ui_->comboBoxAlbum->count(),0,item);
-                    } else if (check_file_exist(coverjpgcs.toStdString().c_str())) {
-                        QPixmap img = coverjpgcs;
-                        QStandardItem *item = new QStandardItem(QIcon(img.scaled(270,270,Qt::KeepAspectRatio)),foldername);
-                        model->setItem(ui_->comboBoxAlbum->count(),0,item);
-                    } else {
-                        QStandardItem *item = new QStandardItem(QIcon(":/coverlogo.png"),foldername);
-                        model->setItem(ui_->comboBoxAlbum->count(),0,item);
-                    }
-                }
-            }
-            ui_->AlbumCoverListView->setModel(model);
-            this->currentPlaylistIndex = 0;
-            ui_->SysinfoTopLeft->hide();
+    this->mediacontentchanged = false;
+    thumbnailCache_->clear();
+    musicLibrary_->scan(this->musicfolder);
+    ui_->mp3List->hide();
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::updateAlbums(const QStringList& albums)
+{
+    if (albumModel_->getAlbums() == albums) {
+        return;
+    }
+
+    QString previousalbum = this->albumfolder;
+    {
+        // keep the current album (and its playlist) while the model is reset
+        QSignalBlocker blocker(ui_->comboBoxAlbum);
+        albumModel_->setAlbums(this->musicfolder, albums);
+        if (albums.contains(previousalbum)) {
+            ui_->comboBoxAlbum->setCurrentText(previousalbum);
         }
     }
-    catch(...) {
-        ui_->SysinfoTopLeft->hide();
+    ui_->labelAlbumCount->setText(QString::number(albums.size()));
+    if (!albums.contains(previousalbum)) {
+        this->currentPlaylistIndex = 0;
+        MainWindow::on_comboBoxAlbum_currentIndexChanged(ui_->comboBoxAlbum->currentText());
+    }
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::onAlbumChanged(const QString& album)
+{
+    if (album != this->albumfolder || this->mediacontentchanged) {
+        return;
+    }
+
+    if (player->state() == QMediaPlayer::StoppedState) {
+        MainWindow::scanFiles();
+        return;
+    }
+
+    // playing: refresh known rows and append new tracks, never rebuild the playlist
+    MusicLibrary::Tracks tracks = trackModel_->getTracks();
+    QList<QMediaContent> content;
+    for (const auto& track : musicLibrary_->getTracks(album)) {
+        auto it = std::find_if(tracks.begin(), tracks.end(), [&track](const MusicTrack& known) { return known.fileName == track.fileName; });
+        if (it != tracks.end()) {
+            *it = track;
+        } else {
+            tracks.push_back(track);
+            content.push_back(MainWindow::getMediaContent(track));
+        }
+    }
+
+    const int currentRow = ui_->mp3List->currentIndex().row();
+    trackModel_->setTracks(std::move(tracks));
+    this->playlist->addMedia(content);
+    if (currentRow >= 0) {
+        QSignalBlocker blocker(ui_->mp3List->selectionModel());
+        ui_->mp3List->setCurrentIndex(trackModel_->index(currentRow));
+    }
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::onLibraryScanFinished()
+{
+    ui_->SysinfoTopLeft->hide();
+
+    if (this->restorePending) {
+        this->restorePending = false;
+        if (player->state() == QMediaPlayer::StoppedState) {
+            MainWindow::restorePlayback();
+        }
+    }
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::restorePlayback()
+{
+    ui_->comboBoxAlbum->setCurrentText(QString::fromStdString(configuration_->getMp3SubFolder()));
+    MainWindow::scanFiles();
+    ui_->mp3List->setCurrentIndex(trackModel_->index(configuration_->getMp3Track()));
+    this->currentPlaylistIndex = configuration_->getMp3Track();
+
+    if (configuration_->mp3AutoPlay()) {
+        MainWindow::playerShow();
+        MainWindow::playerHide();
+        MainWindow::on_pushButtonPlayerPlayList_clicked();
+        if (configuration_->showAutoPlay()) {
+            MainWindow::playerShow();
+        }
+    }
+}
+
+QMediaContent f1x::openauto::autoapp::ui::MainWindow::getMediaContent(const MusicTrack& track) const
+{
+    if (track.fileName.endsWith(".strm")) {
+        return QMediaContent(QUrl(track.streamUrl));
+    }
+
+    return QMediaContent(QUrl::fromLocalFile(this->musicfolder + "/" + this->albumfolder + "/" + track.fileName));
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::onThumbnailReady(const QString& key, const QPixmap& pixmap)
+{
+    if (key == this->currentCoverKey) {
+        ui_->pushButtonBack->setIcon(pixmap);
+    }
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::showCover(const QString& key, const QStringList& candidates)
+{
+    this->currentCoverKey = key;
+    QPixmap img;
+    if (thumbnailCache_->find(key, img)) {
+        ui_->pushButtonBack->setIcon(img);
+    } else {
+        ui_->pushButtonBack->setIcon(ThumbnailCache::getPlaceholder());
+        thumbnailCache_->request(key, candidates, true);
     }
-    ui_->mp3List->hide();
 }
 
 void f1x::openauto::autoapp::ui::MainWindow::scanFiles()
 {
     if (this->mediacontentchanged == false) {
-        int cleaner = ui_->mp3List->count();
-        while (cleaner > -1) {
-            ui_->mp3List->takeItem(cleaner);
-            cleaner--;
-        }
         this->playlist->clear();
 
+        MusicLibrary::Tracks tracks = musicLibrary_->getTracks(this->albumfolder);
         QList<QMediaContent> content;
-        QDir directory(this->musicfolder + "/" + this->albumfolder);
-        QStringList mp3s = directory.entryList(QStringList() << "*.mp3" << "*.flac" << "*.aac" << "*.ogg" << "*.mp4" << "*.mp4a" << "*.wma" << "*.strm",QDir::Files, QDir::Name);
-        foreach (QString filename, mp3s) {
-            // add to mediacontent
-            if (filename.endsWith(".strm")) {
-                QString url=configuration_->readFileContent(this->musicfolder + "/" + this->albumfolder + "/" + filename);
-                content.push_back(QMediaContent(QUrl(url)));
-                ui_->mp3List->addItem(filename.replace(".strm",""));
-            } else {
-                // add items to gui
-                content.push_back(QMediaContent(QUrl::fromLocalFile(this->musicfolder + "/" + this->albumfolder + "/" + filename)));
-                // read metadata using taglib
-                try {
-                    TagLib::FileRef file((this->musicfolder + "/" + this->albumfolder + "/" + filename).toUtf8(),true);
-                    TagLib::String artist_string = file.tag()->artist();
-                    TagLib::String title_string = file.tag()->title();
-                    TagLib::uint track_string = file.tag()->track();
-                    QString artistid3 = QString::fromStdWString(artist_string.toCWString());
-                    QString titleid3 = QString::fromStdWString(title_string.toCWString());
-                    QString trackid3 = QString::number(track_string);
-                    int tracklength = trackid3.length();
-                    if (tracklength < 2) {
-                        trackid3 = "0" + trackid3;
-                    }
-                    QString ID3Entry = trackid3 + ": " + artistid3 + " - " + titleid3;
-                    ui_->mp3List->addItem(ID3Entry);
-                } catch (...) {
-                    // old way only adding filename to list
-                    ui_->mp3List->addItem(filename);
-                }
-            }
+        for (const auto& track : tracks) {
+            content.push_back(MainWindow::getMediaContent(track));
         }
+        trackModel_->setTracks(std::move(tracks));
+        this->currentPlaylistIndex = -1;
         // set playlist
         this->playlist->addMedia(content);
     }
 }
 
-void f1x::openauto::autoapp::ui::MainWindow::on_mp3List_currentRowChanged(int currentRow)
+void f1x::openauto::autoapp::ui::MainWindow::onTrackSelected(const QModelIndex& current)
 {
+    int currentRow = current.row();
     ui_->labelFolderpath->setText(QString::number(currentRow));
     this->currentPlaylistIndex = currentRow;
 
@@ -1707,18 +1734,116 @@ void f1x::openauto::autoapp::ui::MainWindow::on_AlbumCoverListView_clicked(const
 }
 
 void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
+{
+    handleEntityExit();
+    updateBlankScreen();
+    updateScreensaver();
+    updateBlackScreen();
+    updateAndroidDevice();
+    updateBluetoothPairable();
+    updateProgressInfo();
+    updateDayNightState();
+    updateDashCamState();
+    checkExternalExit();
+    updateWifiButtons();
+    updateMenuSettings();
+    updateLux();
+    MainWindow::updateAlpha();
+    updateUpdateNotify();
+    updateLockLabel();
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::onStateFileChanged(StateFile file, bool exists)
+{
+    switch (file) {
+    case StateFile::ENTITY_EXIT:
+        handleEntityExit();
+        break;
+    case StateFile::BLANK_SCREEN:
+        updateBlankScreen();
+        break;
+    case StateFile::SCREENSAVER:
+        updateScreensaver();
+        break;
+    case StateFile::BLACK_SCREEN:
+        updateBlackScreen();
+        break;
+    case StateFile::ANDROID_DEVICE:
+        updateAndroidDevice();
+        updateLockLabel();
+        break;
+    case StateFile::BLUETOOTH_PAIRABLE:
+        updateBluetoothPairable();
+        break;
+    case StateFile::CONFIG_IN_PROGRESS:
+    case StateFile::DEBUG_IN_PROGRESS:
+    case StateFile::ENABLE_PAIRING:
+        updateProgressInfo();
+        break;
+    case StateFile::NIGHT_MODE_ENABLED:
+        updateDayNightState();
+        break;
+    case StateFile::DASHCAM_IS_RECORDING:
+        updateDashCamState();
+        break;
+    case StateFile::EXTERNAL_EXIT:
+        checkExternalExit();
+        break;
+    case StateFile::HOTSPOT_ACTIVE:
+        updateWifiButtons();
+        networkMonitor_.refresh();
+        break;
+    case StateFile::MOBILE_HOTSPOT_DETECTED:
+    case StateFile::TEMP_RECENT_LIST:
+        updateWifiButtons();
+        break;
+    case StateFile::DAYNIGHT_GPIO:
+        updateMenuSettings();
+        break;
+    case StateFile::TSL2561:
+        updateLux();
+        break;
+    case StateFile::CSMT_UPDATE_AVAILABLE:
+    case StateFile::UDEV_UPDATE_AVAILABLE:
+    case StateFile::OPENAUTO_UPDATE_AVAILABLE:
+    case StateFile::SYSTEM_UPDATE_AVAILABLE:
+        updateUpdateNotify();
+        break;
+    case StateFile::BTDEVICE:
+        bluetoothDeviceName = exists ? StateFileMonitor::readContent(file) : QString();
+        updateBluetoothDevice();
+        updateLockLabel();
+        break;
+    case StateFile::MEDIA_PLAYING:
+    case StateFile::DEV_MODE_ENABLED:
+        updateLockLabel();
+        break;
+    case StateFile::WIFI_SSID:
+    case StateFile::GATEWAY_WLAN0:
+        networkMonitor_.refresh();
+        break;
+    default:
+        break;
+    }
+    MainWindow::updateAlpha();
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::handleEntityExit()
 {
     try {
-        if (std::ifstream("/tmp/entityexit")) {
+        if (stateFileMonitor_->exists(StateFile::ENTITY_EXIT)) {
             MainWindow::TriggerAppStop();
             std::remove("/tmp/entityexit");
         }
     } catch (...) {
         OPENAUTO_LOG(error) << "[OpenAuto] Error in entityexit";
     }
+}
 
+void f1x::openauto::autoapp::ui::MainWindow::updateBlankScreen()
+{
     // check if system is in display off mode (tap2wake)
-    if (std::ifstream("/tmp/blankscreen")) {
+    if (stateFileMonitor_->exists(StateFile::BLANK_SCREEN)) {
         if (ui_->centralWidget->isVisible() == true) {
             CloseAllDialogs();
             ui_->centralWidget->hide();
@@ -1728,9 +1853,12 @@ void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
             ui_->centralWidget->show();
         }
     }
+}
 
+void f1x::openauto::autoapp::ui::MainWindow::updateScreensaver()
+{
     // check if system is in display off mode (tap2wake/screensaver)
-    if (std::ifstream("/tmp/screensaver")) {
+    if (stateFileMonitor_->exists(StateFile::SCREENSAVER)) {
         if (ui_->menuWidget->isVisible() == true) {
             ui_->menuWidget->hide();
         }
@@ -1776,9 +1904,12 @@ void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
             updateBG();
         }
     }
+}
 
+void f1x::openauto::autoapp::ui::MainWindow::updateBlackScreen()
+{
     // check if custom command needs black background
-    if (std::ifstream("/tmp/blackscreen")) {
+    if (stateFileMonitor_->exists(StateFile::BLACK_SCREEN)) {
         if (ui_->centralWidget->isVisible() == true) {
             ui_->centralWidget->hide();
             this->setStyleSheet("QMainWindow {background-color: rgb(0,0,0);}");
@@ -1790,9 +1921,12 @@ void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
             this->background_set = true;
         }
     }
+}
 
+void f1x::openauto::autoapp::ui::MainWindow::updateAndroidDevice()
+{
     // check if phone is conencted to usb
-    if (std::ifstream("/tmp/android_device")) {
+    if (stateFileMonitor_->exists(StateFile::ANDROID_DEVICE)) {
         if (ui_->ButtonAndroidAuto->isVisible() == false) {
             ui_->ButtonAndroidAuto->show();
             ui_->pushButtonNoDevice->hide();
@@ -1822,10 +1956,13 @@ void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
         }
         ui_->labelAndroidAutoBottom->setText("");
     }
+}
 
+void f1x::openauto::autoapp::ui::MainWindow::updateBluetoothPairable()
+{
     // check if bluetooth pairable
     if (this->bluetoothEnabled) {
-        if (std::ifstream("/tmp/bluetooth_pairable")) {
+        if (stateFileMonitor_->exists(StateFile::BLUETOOTH_PAIRABLE)) {
             if (ui_->labelBluetoothPairable->isVisible() == false) {
                 ui_->labelBluetoothPairable->show();
             }
@@ -1848,10 +1985,13 @@ void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
             ui_->pushButtonBluetooth->hide();
         }
     }
+}
 
-    if (std::ifstream("/tmp/config_in_progress") || std::ifstream("/tmp/debug_in_progress") || std::ifstream("/tmp/enable_pairing")) {
+void f1x::openauto::autoapp::ui::MainWindow::updateProgressInfo()
+{
+    if (stateFileMonitor_->exists(StateFile::CONFIG_IN_PROGRESS) || stateFileMonitor_->exists(StateFile::DEBUG_IN_PROGRESS) || stateFileMonitor_->exists(StateFile::ENABLE_PAIRING)) {
         if (ui_->SysinfoTopLeft2->isVisible() == false) {
-            if (std::ifstream("/tmp/config_in_progress")) {
+            if (stateFileMonitor_->exists(StateFile::CONFIG_IN_PROGRESS)) {
                 ui_->pushButtonSettings->hide();
                 ui_->pushButtonSettings2->hide();
                 ui_->pushButtonLock->show();
@@ -1859,7 +1999,7 @@ void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
                 ui_->SysinfoTopLeft2->setText("Config in progress ...");
                 ui_->SysinfoTopLeft2->show();
             }
-            if (std::ifstream("/tmp/debug_in_progress")) {
+            if (stateFileMonitor_->exists(StateFile::DEBUG_IN_PROGRESS)) {
                 ui_->pushButtonSettings->hide();
                 ui_->pushButtonSettings2->hide();
                 ui_->pushButtonDebug->hide();
@@ -1869,7 +2009,7 @@ void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
                 ui_->SysinfoTopLeft2->setText("Creating debug.zip ...");
                 ui_->SysinfoTopLeft2->show();
             }
-            if (std::ifstream("/tmp/enable_pairing")) {
+            if (stateFileMonitor_->exists(StateFile::ENABLE_PAIRING)) {
                 ui_->pushButtonDebug->hide();
                 ui_->pushButtonDebug2->hide();
                 ui_->SysinfoTopLeft2->setText("Pairing enabled for 120 seconds!");
@@ -1890,27 +2030,35 @@ void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
             }
         }
     }
+}
 
+void f1x::openauto::autoapp::ui::MainWindow::updateDayNightState()
+{
     // update day/night state
-    this->nightModeEnabled = check_file_exist("/tmp/night_mode_enabled");
+    this->nightModeEnabled = stateFileMonitor_->exists(StateFile::NIGHT_MODE_ENABLED);
 
     if (this->nightModeEnabled) {
         if (!this->DayNightModeState) {
             this->DayNightModeState = true;
             f1x::openauto::autoapp::ui::MainWindow::switchGuiToNight();
+            rampBrightness("BR_NIGHT");
         }
     } else {
         if (this->DayNightModeState) {
             this->DayNightModeState = false;
             f1x::openauto::autoapp::ui::MainWindow::switchGuiToDay();
+            rampBrightness("BR_DAY");
         }
     }
+}
 
+void f1x::openauto::autoapp::ui::MainWindow::updateDashCamState()
+{
     // camera stuff
     if (this->cameraButtonForce) {
 
         // check if dashcam is recording
-        this->dashCamRecording = check_file_exist("/tmp/dashcam_is_recording");
+        this->dashCamRecording = stateFileMonitor_->exists(StateFile::DASHCAM_IS_RECORDING);
 
         if (this->dashCamRecording) {
             if (ui_->dcRecording->isVisible() == false) {
@@ -1937,16 +2085,22 @@ void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
             }
         }
     }
+}
 
+void f1x::openauto::autoapp::ui::MainWindow::checkExternalExit()
+{
     // check if shutdown is external triggered and init clean app exit
-    if (std::ifstream("/tmp/external_exit")) {
+    if (stateFileMonitor_->exists(StateFile::EXTERNAL_EXIT)) {
         f1x::openauto::autoapp::ui::MainWindow::MainWindow::exit();
     }
+}
 
-    this->hotspotActive = check_file_exist("/tmp/hotspot_active");
+void f1x::openauto::autoapp::ui::MainWindow::updateWifiButtons()
+{
+    this->hotspotActive = stateFileMonitor_->exists(StateFile::HOTSPOT_ACTIVE);
 
     // hide wifi if hotspot disabled and force wifi unselected
-    if (!this->hotspotActive && !std::ifstream("/tmp/mobile_hotspot_detected")) {
+    if (!this->hotspotActive && !stateFileMonitor_->exists(StateFile::MOBILE_HOTSPOT_DETECTED)) {
         if ((ui_->AAWIFIWidget->isVisible() == true) || (ui_->AAWIFIWidget2->isVisible() == true)){
             ui_->AAWIFIWidget->hide();
             ui_->AAWIFIWidget2->hide();
@@ -1962,7 +2116,7 @@ void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
         }
     }
 
-    if (std::ifstream("/tmp/temp_recent_list") || std::ifstream("/tmp/mobile_hotspot_detected")) {
+    if (stateFileMonitor_->exists(StateFile::TEMP_RECENT_LIST) || stateFileMonitor_->exists(StateFile::MOBILE_HOTSPOT_DETECTED)) {
         if (ui_->pushButtonWifi->isVisible() == false) {
             ui_->pushButtonWifi->show();
         }
@@ -1989,7 +2143,10 @@ void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
             ui_->pushButtonNoWiFiDevice2->show();
         }
     }
+}
 
+void f1x::openauto::autoapp::ui::MainWindow::updateMenuSettings()
+{
     // handle dummys in classic menu
     int button_count = 0;
     if (ui_->pushButtonCameraShow2->isVisible() == true) {
@@ -2006,7 +2163,7 @@ void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
     }
 
     // Hide auto day/night if needed
-    if (this->lightsensor || std::ifstream("/tmp/daynight_gpio")) {
+    if (this->lightsensor || stateFileMonitor_->exists(StateFile::DAYNIGHT_GPIO)) {
         ui_->pushButtonDay->hide();
         ui_->pushButtonNight->hide();
         ui_->pushButtonDay2->hide();
@@ -2089,14 +2246,23 @@ void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
             }
         }
     }
+}
 
+void f1x::openauto::autoapp::ui::MainWindow::updateLux()
+{
     // read value from tsl2561
-    if (std::ifstream("/tmp/tsl2561") && this->configuration_->showLux()) {
+    const bool luxAvailable = stateFileMonitor_->exists(StateFile::TSL2561);
+    const QString lux = luxAvailable ? StateFileMonitor::readContent(StateFile::TSL2561) : QString();
+    if (luxAvailable) {
+        updateLuxBrightness(lux.toInt());
+    }
+
+    if (luxAvailable && this->configuration_->showLux()) {
         if (ui_->label_left->isVisible() == false) {
             ui_->label_left->show();
             ui_->label_right->show();
         }
-        ui_->label_left->setText("Lux: " + configuration_->readFileContent("/tmp/tsl2561"));
+        ui_->label_left->setText("Lux: " + lux);
     } else {
         if (ui_->label_left->isVisible() == true) {
             ui_->label_left->hide();
@@ -2105,13 +2271,40 @@ void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
             ui_->label_right->setText("");
         }
     }
-    MainWindow::updateAlpha();
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::updateLuxBrightness(int lux)
+{
+    // pick the brightness of the highest configured lux level reached
+    int brightness = -1;
+    for (int level = 1; level <= 5; ++level) {
+        const QString luxLevel = configuration_->getCSValue("LUX_LEVEL_" + QString::number(level));
+        if (!luxLevel.isEmpty() && lux >= luxLevel.toInt()) {
+            brightness = configuration_->getCSValue("DISP_BRIGHTNESS_" + QString::number(level)).toInt();
+        }
+    }
+
+    if (brightness >= 0 && brightness != this->luxBrightness) {
+        this->luxBrightness = brightness;
+        backlightController_->rampTo(brightness, cLuxRampDuration);
+    }
+}
+
+void f1x::openauto::autoapp::ui::MainWindow::rampBrightness(const QString& key)
+{
+    const QString brightness = configuration_->getCSValue(key);
+    if (!brightness.isEmpty()) {
+        backlightController_->rampTo(brightness.toInt(), cDayNightRampDuration);
+    }
+}
 
+void f1x::openauto::autoapp::ui::MainWindow::updateUpdateNotify()
+{
     // update notify
-    this->csmtupdate = check_file_exist("/tmp/csmt_update_available");
-    this->udevupdate = check_file_exist("/tmp/udev_update_available");
-    this->openautoupdate = check_file_exist("/tmp/openauto_update_available");
-    this->systemupdate = check_file_exist("/tmp/system_update_available");
+    this->csmtupdate = stateFileMonitor_->exists(StateFile::CSMT_UPDATE_AVAILABLE);
+    this->udevupdate = stateFileMonitor_->exists(StateFile::UDEV_UPDATE_AVAILABLE);
+    this->openautoupdate = stateFileMonitor_->exists(StateFile::OPENAUTO_UPDATE_AVAILABLE);
+    this->systemupdate = stateFileMonitor_->exists(StateFile::SYSTEM_UPDATE_AVAILABLE);
 
     if (this->csmtupdate || this->udevupdate || this->openautoupdate || this->systemupdate) {
         if (ui_->pushButtonUpdate->isVisible() == false) {
@@ -2135,8 +2328,11 @@ void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
             }
         }
     }
+}
 
-    if (std::ifstream("/tmp/btdevice") || std::ifstream("/tmp/media_playing") || std::ifstream("/tmp/dev_mode_enabled") || std::ifstream("/tmp/android_device")) {
+void f1x::openauto::autoapp::ui::MainWindow::updateLockLabel()
+{
+    if (stateFileMonitor_->exists(StateFile::BTDEVICE) || stateFileMonitor_->exists(StateFile::MEDIA_PLAYING) || stateFileMonitor_->exists(StateFile::DEV_MODE_ENABLED) || stateFileMonitor_->exists(StateFile::ANDROID_DEVICE)) {
         if (ui_->labelLock->isVisible() == false) {
             ui_->labelLock->show();
             ui_->labelLockDummy->show();
@@ -2147,6 +2343,5 @@ void f1x::openauto::autoapp::ui::MainWindow::tmpChanged()
             ui_->labelLockDummy->hide();
         }
     }
-    updateNetworkInfo();
 }
 
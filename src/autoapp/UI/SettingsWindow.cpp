@@ -18,6 +18,7 @@
 
 #include <QMessageBox>
 #include <f1x/openauto/autoapp/UI/SettingsWindow.hpp>
+#include <f1x/openauto/Common/Log.hpp>
 #include "ui_settingswindow.h"
 #include <QFile>
 #include <QFileInfo>
@@ -25,10 +26,9 @@
 #include <string>
 #include <QTimer>
 #include <QDateTime>
-#include <QNetworkInterface>
 #include <fstream>
 #include <QStorageInfo>
-#include <QProcess>
+#include <chrono>
 
 namespace f1x
 {
@@ -39,10 +39,13 @@ namespace autoapp
 namespace ui
 {
 
-SettingsWindow::SettingsWindow(configuration::IConfiguration::Pointer configuration, QWidget *parent)
+SettingsWindow::SettingsWindow(configuration::IConfiguration::Pointer configuration, HelperClient& helperClient, VolumeController& volumeController, NetworkMonitor& networkMonitor, QWidget *parent)
     : QWidget(parent)
     , ui_(new Ui::SettingsWindow)
     , configuration_(std::move(configuration))
+    , helperClient_(helperClient)
+    , volumeController_(volumeController)
+    , networkMonitor_(networkMonitor)
 {
     ui_->setupUi(this);
     connect(ui_->pushButtonCancel, &QPushButton::clicked, this, &SettingsWindow::close);
@@ -71,20 +74,31 @@ SettingsWindow::SettingsWindow(configuration::IConfiguration::Pointer configurat
     connect(ui_->pushButtonResetToDefaults, &QPushButton::clicked, this, &SettingsWindow::onResetToDefaults);
     connect(ui_->horizontalSliderSystemVolume, &QSlider::valueChanged, this, &SettingsWindow::onUpdateSystemVolume);
     connect(ui_->horizontalSliderSystemCapture, &QSlider::valueChanged, this, &SettingsWindow::onUpdateSystemCapture);
+    connect(&volumeController_, &VolumeController::playbackVolumeChanged, this, &SettingsWindow::onPlaybackVolumeChanged);
+    connect(&volumeController_, &VolumeController::captureVolumeChanged, this, &SettingsWindow::onCaptureVolumeChanged);
+    connect(&networkMonitor_, &NetworkMonitor::snapshotChanged, this, &SettingsWindow::onNetworkSnapshotChanged);
     connect(ui_->radioButtonHotspot, &QPushButton::clicked, this, &SettingsWindow::onStartHotspot);
     connect(ui_->radioButtonClient, &QPushButton::clicked, this, &SettingsWindow::onStopHotspot);
     connect(ui_->pushButtonSetTime, &QPushButton::clicked, this, &SettingsWindow::setTime);
     connect(ui_->pushButtonSetTime, &QPushButton::clicked, this, &SettingsWindow::close);
-    connect(ui_->pushButtonNTP, &QPushButton::clicked, [&]() { system("/usr/local/bin/crankshaft rtc sync &"); });
+    connect(ui_->pushButtonNTP, &QPushButton::clicked, [&]() { helperClient_.execute("/usr/local/bin/crankshaft rtc sync"); });
     connect(ui_->pushButtonNTP, &QPushButton::clicked, this, &SettingsWindow::close);
-    connect(ui_->pushButtonCheckNow, &QPushButton::clicked, [&]() { system("/usr/local/bin/crankshaft update check &"); });
+    connect(ui_->pushButtonCheckNow, &QPushButton::clicked, [&]() { helperClient_.execute("/usr/local/bin/crankshaft update check"); });
     connect(ui_->pushButtonDebuglog, &QPushButton::clicked, this, &SettingsWindow::close);
-    connect(ui_->pushButtonDebuglog, &QPushButton::clicked, [&]() { system("/usr/local/bin/crankshaft debuglog &");});
-    connect(ui_->pushButtonNetworkAuto, &QPushButton::clicked, [&]() { system("/usr/local/bin/crankshaft network auto &");});
+    connect(ui_->pushButtonDebuglog, &QPushButton::clicked, [&]() { helperClient_.execute("/usr/local/bin/crankshaft debuglog");});
+    connect(ui_->pushButtonNetworkAuto, &QPushButton::clicked, [&]() { helperClient_.execute("/usr/local/bin/crankshaft network auto");});
     connect(ui_->pushButtonNetwork0, &QPushButton::clicked, this, &SettingsWindow::on_pushButtonNetwork0_clicked);
     connect(ui_->pushButtonNetwork1, &QPushButton::clicked, this, &SettingsWindow::on_pushButtonNetwork1_clicked);
-    connect(ui_->pushButtonSambaStart, &QPushButton::clicked, [&]() { system("/usr/local/bin/crankshaft samba start &");});
-    connect(ui_->pushButtonSambaStop, &QPushButton::clicked, [&]() { system("/usr/local/bin/crankshaft samba stop &");});
+    connect(ui_->pushButtonSambaStart, &QPushButton::clicked, [&]() {
+        helperClient_.execute("/usr/local/bin/crankshaft samba start", [this](int) {
+            QMetaObject::invokeMethod(this, "updateNetworkInfo", Qt::QueuedConnection);
+        });
+    });
+    connect(ui_->pushButtonSambaStop, &QPushButton::clicked, [&]() {
+        helperClient_.execute("/usr/local/bin/crankshaft samba stop", [this](int) {
+            QMetaObject::invokeMethod(this, "updateNetworkInfo", Qt::QueuedConnection);
+        });
+    });
 
     // menu
     ui_->tab1->show();
@@ -173,9 +187,19 @@ SettingsWindow::SettingsWindow(configuration::IConfiguration::Pointer configurat
         ui_->pushButtonSambaStart->show();
     }
 
+    systemInfoProvider_ = new SystemInfoProvider(this);
+    connect(systemInfoProvider_, &SystemInfoProvider::systemInfoUpdated, this, &SettingsWindow::onSystemInfoUpdated);
+
     QTimer *refresh=new QTimer(this);
     connect(refresh, SIGNAL(timeout()),this,SLOT(updateInfo()));
     refresh->start(5000);
+
+    configuration_->subscribeCSValues([this](const QStringList& keys) {
+        OPENAUTO_LOG(info) << "[SettingsWindow] cs params changed: " << keys.join(", ").toStdString();
+        if (this->isVisible()) {
+            this->loadSystemValues();
+        }
+    });
 }
 
 SettingsWindow::~SettingsWindow()
@@ -188,9 +212,6 @@ void SettingsWindow::updateInfo()
     if (ui_->tab6->isVisible() == true) {
         updateSystemInfo();
     }
-    if (ui_->tab5->isVisible() == true) {
-        updateNetworkInfo();
-    }
 }
 
 void SettingsWindow::onSave()
@@ -461,7 +482,7 @@ void SettingsWindow::onSave()
     params.append("#");
     params.append( std::string(ui_->comboBoxUSBRotation->currentText().replace("180","1").toStdString()) );
     params.append("#");
-    system((std::string("/usr/local/bin/autoapp_helper setparams#") + std::string(params) + std::string(" &") ).c_str());
+    helperClient_.coalesce("setparams", std::string("/usr/local/bin/autoapp_helper setparams#") + std::string(params));
 
     this->close();
 }
@@ -641,11 +662,35 @@ void SettingsWindow::onUpdateBrightnessNight(int value)
 void SettingsWindow::onUpdateSystemVolume(int value)
 {
     ui_->labelSystemVolumeValue->setText(QString::number(value));
+    volumeController_.setPlaybackVolume(value);
 }
 
 void SettingsWindow::onUpdateSystemCapture(int value)
 {
     ui_->labelSystemCaptureValue->setText(QString::number(value));
+    volumeController_.setCaptureVolume(value);
+}
+
+void SettingsWindow::onPlaybackVolumeChanged(int value)
+{
+    if (ui_->horizontalSliderSystemVolume->isSliderDown()) {
+        return;
+    }
+
+    QSignalBlocker blocker(ui_->horizontalSliderSystemVolume);
+    ui_->horizontalSliderSystemVolume->setValue(value);
+    ui_->labelSystemVolumeValue->setText(QString::number(value));
+}
+
+void SettingsWindow::onCaptureVolumeChanged(int value)
+{
+    if (ui_->horizontalSliderSystemCapture->isSliderDown()) {
+        return;
+    }
+
+    QSignalBlocker blocker(ui_->horizontalSliderSystemCapture);
+    ui_->horizontalSliderSystemCapture->setValue(value);
+    ui_->labelSystemCaptureValue->setText(QString::number(value));
 }
 
 void SettingsWindow::onUpdateLux1(int value)
@@ -700,7 +745,7 @@ void SettingsWindow::onUpdateBrightness5(int value)
 
 void SettingsWindow::unpairAll()
 {
-    system("/usr/local/bin/crankshaft bluetooth unpair &");
+    helperClient_.execute("/usr/local/bin/crankshaft bluetooth unpair");
 }
 
 void SettingsWindow::setTime()
@@ -711,16 +756,18 @@ void SettingsWindow::setTime()
     params.append("#");
     params.append( std::to_string(ui_->spinBoxMinute->value()) );
     params.append("#");
-    system((std::string("/usr/local/bin/autoapp_helper settime#") + std::string(params) + std::string(" &") ).c_str());
+    helperClient_.execute(std::string("/usr/local/bin/autoapp_helper settime#") + std::string(params));
 }
 
 void SettingsWindow::syncNTPTime()
 {
-    system("/usr/local/bin/crankshaft rtc sync &");
+    helperClient_.execute("/usr/local/bin/crankshaft rtc sync");
 }
 
 void SettingsWindow::loadSystemValues()
 {
+    const auto loadStart = std::chrono::steady_clock::now();
+
     // set brightness slider attribs
     ui_->horizontalSliderDay->setMinimum(configuration_->getCSValue("BR_MIN").toInt());
     ui_->horizontalSliderDay->setMaximum(configuration_->getCSValue("BR_MAX").toInt());
@@ -782,11 +829,9 @@ void SettingsWindow::loadSystemValues()
         // date string
         ui_->valueSystemBuildDate->setText(configuration_->readFileContent("/etc/crankshaft.date"));
         // set volume
-        ui_->labelSystemVolumeValue->setText(configuration_->readFileContent("/boot/crankshaft/volume"));
-        ui_->horizontalSliderSystemVolume->setValue(configuration_->readFileContent("/boot/crankshaft/volume").toInt());
+        onPlaybackVolumeChanged(volumeController_.getPlaybackVolume() >= 0 ? volumeController_.getPlaybackVolume() : configuration_->readFileContent("/boot/crankshaft/volume").toInt());
         // set cap volume
-        ui_->labelSystemCaptureValue->setText(configuration_->readFileContent("/boot/crankshaft/capvolume"));
-        ui_->horizontalSliderSystemCapture->setValue(configuration_->readFileContent("/boot/crankshaft/capvolume").toInt());
+        onCaptureVolumeChanged(volumeController_.getCaptureVolume() >= 0 ? volumeController_.getCaptureVolume() : configuration_->readFileContent("/boot/crankshaft/capvolume").toInt());
         // set shutdown
         ui_->valueShutdownTimer->setText("- - -");
         ui_->spinBoxShutdown->setValue(configuration_->getCSValue("DISCONNECTION_POWEROFF_MINS").toInt());
@@ -1094,6 +1139,9 @@ void SettingsWindow::loadSystemValues()
     }
     // update network info
     updateNetworkInfo();
+
+    OPENAUTO_LOG(info) << "[SettingsWindow] system values loaded in "
+                       << std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - loadStart).count() << " us.";
 }
 
 void SettingsWindow::onStartHotspot()
@@ -1109,7 +1157,9 @@ void SettingsWindow::onStartHotspot()
     qApp->processEvents();
     std::remove("/tmp/manual_hotspot_control");
     std::ofstream("/tmp/manual_hotspot_control");
-    system("/opt/crankshaft/service_hotspot.sh start &");
+    helperClient_.execute("/opt/crankshaft/service_hotspot.sh start", [this](int) {
+        QMetaObject::invokeMethod(this, "updateNetworkInfo", Qt::QueuedConnection);
+    });
 }
 
 void SettingsWindow::onStopHotspot()
@@ -1124,55 +1174,23 @@ void SettingsWindow::onStopHotspot()
     ui_->lineEditPassword->setText("");
     ui_->pushButtonNetworkAuto->hide();
     qApp->processEvents();
-    system("/opt/crankshaft/service_hotspot.sh stop &");
+    helperClient_.execute("/opt/crankshaft/service_hotspot.sh stop", [this](int) {
+        QMetaObject::invokeMethod(this, "updateNetworkInfo", Qt::QueuedConnection);
+    });
 }
 
 void SettingsWindow::updateSystemInfo()
 {
-    // free ram
-    struct sysinfo info;
-    sysinfo(&info);
-    ui_->valueSystemFreeMem->setText(QString::number(info.freeram/1024/1024) + " MB");
-    // current cpu speed
-    QString freq = configuration_->readFileContent("/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_cur_freq");
-    int currentfreq = freq.toInt()/1000;
-    ui_->valueSystemCPUFreq->setText(QString::number(currentfreq) + "MHz");
-    // current cpu temp
-    QString temp = configuration_->readFileContent("/sys/class/thermal/thermal_zone0/temp");
-    int currenttemp = temp.toInt()/1000;
-    ui_->valueSystemCPUTemp->setText(QString::number(currenttemp) + "°C");
-    // get remaining times
-    QProcess process;
-    process.start("/bin/bash", QStringList() << "-c" << "systemctl list-timers -all | grep disconnect | awk {'print $1'}");
-    process.waitForFinished(-1);
-    QString stdout = process.readAllStandardOutput();
-    if (stdout.simplified() != "n/a") {
-        process.start("/bin/bash", QStringList() << "-c" << "systemctl list-timers -all | grep disconnect | awk {'print $5\" \"$6'}");
-        process.waitForFinished(-1);
-        QString stdout = process.readAllStandardOutput();
-        if (stdout.simplified() != "") {
-            ui_->valueDisconnectTimer->setText(stdout.simplified());
-        } else {
-            ui_->valueDisconnectTimer->setText("Stopped");
-        }
-    } else {
-        ui_->valueDisconnectTimer->setText("Stopped");
-    }
-    process.start("/bin/bash", QStringList() << "-c" << "systemctl list-timers -all | grep shutdown | awk {'print $1'}");
-    process.waitForFinished(-1);
-    stdout = process.readAllStandardOutput();
-    if (stdout.simplified() != "n/a") {
-        process.start("/bin/bash", QStringList() << "-c" << "systemctl list-timers -all | grep shutdown | awk {'print $5\" \"$6'}");
-        process.waitForFinished(-1);
-        QString stdout = process.readAllStandardOutput();
-        if (stdout.simplified() != "") {
-            ui_->valueShutdownTimer->setText(stdout.simplified());
-        } else {
-            ui_->valueShutdownTimer->setText("Stopped");
-        }
-    } else {
-        ui_->valueShutdownTimer->setText("Stopped");
-    }
+    systemInfoProvider_->refresh();
+}
+
+void SettingsWindow::onSystemInfoUpdated(const SystemInfo& info)
+{
+    ui_->valueSystemFreeMem->setText(QString::number(info.freeMemory) + " MB");
+    ui_->valueSystemCPUFreq->setText(QString::number(info.cpuFrequency) + "MHz");
+    ui_->valueSystemCPUTemp->setText(QString::number(info.cpuTemperature) + "°C");
+    ui_->valueDisconnectTimer->setText(info.disconnectTimer);
+    ui_->valueShutdownTimer->setText(info.shutdownTimer);
 }
 
 void SettingsWindow::show_tab1()
@@ -1302,13 +1320,28 @@ void f1x::openauto::autoapp::ui::SettingsWindow::on_pushButtonAudioTest_clicked(
     ui_->labelTestInProgress->show();
     ui_->pushButtonAudioTest->hide();
     qApp->processEvents();
-    system("/usr/local/bin/crankshaft audio test");
+    helperClient_.execute("/usr/local/bin/crankshaft audio test", [this](int) {
+        QMetaObject::invokeMethod(this, "onAudioTestFinished", Qt::QueuedConnection);
+    });
+}
+
+void f1x::openauto::autoapp::ui::SettingsWindow::onAudioTestFinished()
+{
     ui_->pushButtonAudioTest->show();
     ui_->labelTestInProgress->hide();
 }
 
+void f1x::openauto::autoapp::ui::SettingsWindow::onNetworkSnapshotChanged(const NetworkSnapshot&)
+{
+    if (ui_->tab5->isVisible() == true) {
+        updateNetworkInfo();
+    }
+}
+
 void f1x::openauto::autoapp::ui::SettingsWindow::updateNetworkInfo()
 {
+    const NetworkSnapshot snapshot = networkMonitor_.getSnapshot();
+
     if (std::ifstream("/tmp/samba_running")) {
         ui_->labelSambaStatus->setText("running");
         if (ui_->pushButtonSambaStart->isVisible() == true) {
@@ -1324,39 +1357,33 @@ void f1x::openauto::autoapp::ui::SettingsWindow::updateNetworkInfo()
     }
 
     if (!std::ifstream("/tmp/mode_change_progress")) {
-        QNetworkInterface eth0if = QNetworkInterface::interfaceFromName("eth0");
-        if (eth0if.flags().testFlag(QNetworkInterface::IsUp)) {
-            QList<QNetworkAddressEntry> entrieseth0 = eth0if.addressEntries();
-            if (!entrieseth0.isEmpty()) {
-                QNetworkAddressEntry eth0 = entrieseth0.first();
-                //qDebug() << "eth0: " << eth0.ip();
-                ui_->lineEdit_eth0->setText(eth0.ip().toString());
+        const NetworkInterfaceState eth0 = snapshot.interfaces.value("eth0");
+        if (eth0.up) {
+            if (!eth0.address.isEmpty()) {
+                ui_->lineEdit_eth0->setText(eth0.address);
             }
         } else {
             //qDebug() << "eth0: down";
             ui_->lineEdit_eth0->setText("interface down");
         }
 
-        QNetworkInterface wlan0if = QNetworkInterface::interfaceFromName("wlan0");
-        if (wlan0if.flags().testFlag(QNetworkInterface::IsUp)) {
-            QList<QNetworkAddressEntry> entrieswlan0 = wlan0if.addressEntries();
-            if (!entrieswlan0.isEmpty()) {
-                QNetworkAddressEntry wlan0 = entrieswlan0.first();
-                //qDebug() << "wlan0: " << wlan0.ip();
-                ui_->lineEdit_wlan0->setText(wlan0.ip().toString());
+        const NetworkInterfaceState wlan0 = snapshot.interfaces.value(NetworkMonitor::cWirelessInterface);
+        if (wlan0.up) {
+            if (!wlan0.address.isEmpty()) {
+                ui_->lineEdit_wlan0->setText(wlan0.address);
             }
         } else {
             //qDebug() << "wlan0: down";
             ui_->lineEdit_wlan0->setText("interface down");
         }
 
-        if (std::ifstream("/tmp/hotspot_active")) {
+        if (snapshot.hotspotActive) {
             ui_->radioButtonClient->setEnabled(1);
             ui_->radioButtonHotspot->setEnabled(1);
             ui_->radioButtonHotspot->setChecked(1);
             ui_->radioButtonClient->setChecked(0);
             ui_->label_modeswitchprogress->setText("Ok");
-            ui_->lineEditWifiSSID->setText(configuration_->getParamFromFile("/etc/hostapd/hostapd.conf","ssid"));
+            ui_->lineEditWifiSSID->setText(snapshot.ssid);
             ui_->lineEditPassword->show();
             ui_->label_password->show();
             ui_->lineEditPassword->setText("1234567890");
@@ -1369,7 +1396,7 @@ void f1x::openauto::autoapp::ui::SettingsWindow::updateNetworkInfo()
             ui_->radioButtonHotspot->setChecked(0);
             ui_->radioButtonClient->setChecked(1);
             ui_->label_modeswitchprogress->setText("Ok");
-            ui_->lineEditWifiSSID->setText(configuration_->readFileContent("/tmp/wifi_ssid"));
+            ui_->lineEditWifiSSID->setText(snapshot.ssid);
             ui_->lineEditPassword->hide();
             ui_->label_password->hide();
             ui_->lineEditPassword->setText("");
@@ -1401,7 +1428,7 @@ void f1x::openauto::autoapp::ui::SettingsWindow::on_pushButtonNetwork0_clicked()
     ui_->lineEditWifiSSID->setText("");
     ui_->lineEditPassword->setText("");
     qApp->processEvents();
-    system("/usr/local/bin/crankshaft network 0 >/dev/null 2>&1 &");
+    helperClient_.execute("/usr/local/bin/crankshaft network 0");
 
 }
 
@@ -1411,5 +1438,5 @@ void f1x::openauto::autoapp::ui::SettingsWindow::on_pushButtonNetwork1_clicked()
     ui_->lineEditWifiSSID->setText("");
     ui_->lineEditPassword->setText("");
     qApp->processEvents();
-    system("/usr/local/bin/crankshaft network 1 >/dev/null 2>&1 &");
+    helperClient_.execute("/usr/local/bin/crankshaft network 1");
 }
@@ -0,0 +1,87 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <f1x/openauto/autoapp/UI/TrackListModel.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+namespace ui
+{
+
+TrackListModel::TrackListModel(QObject* parent)
+    : QAbstractListModel(parent)
+{
+
+}
+
+int TrackListModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : static_cast<int>(tracks_.size());
+}
+
+QVariant TrackListModel::data(const QModelIndex& index, int role) const
+{
+    if(!index.isValid() || role != Qt::DisplayRole)
+    {
+        return QVariant();
+    }
+
+    return this->getTitle(index.row());
+}
+
+void TrackListModel::setTracks(MusicLibrary::Tracks tracks)
+{
+    this->beginResetModel();
+    tracks_ = std::move(tracks);
+    this->endResetModel();
+}
+
+const MusicLibrary::Tracks& TrackListModel::getTracks() const
+{
+    return tracks_;
+}
+
+QString TrackListModel::getTitle(int row) const
+{
+    if(row < 0 || row >= static_cast<int>(tracks_.size()))
+    {
+        return QString();
+    }
+
+    const auto& track = tracks_[row];
+    if(!track.streamUrl.isEmpty() || track.fileName.endsWith(".strm"))
+    {
+        return QString(track.fileName).replace(".strm", "");
+    }
+
+    if(!track.hasTags)
+    {
+        return track.fileName;
+    }
+
+    return QString("%1: %2 - %3").arg(track.track, 2, 10, QChar('0')).arg(track.artist, track.title);
+}
+
+}
+}
+}
+}
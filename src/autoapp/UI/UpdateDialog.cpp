@@ -15,9 +15,10 @@ namespace autoapp
 namespace ui
 {
 
-UpdateDialog::UpdateDialog(QWidget *parent)
+UpdateDialog::UpdateDialog(HelperClient& helperClient, QWidget *parent)
     : QDialog(parent)
     , ui_(new Ui::UpdateDialog)
+    , helperClient_(helperClient)
 {
     ui_->setupUi(this);
     connect(ui_->pushButtonUpdateCsmt, &QPushButton::clicked, this, &UpdateDialog::on_pushButtonUpdateCsmt_clicked);
@@ -66,7 +67,7 @@ void f1x::openauto::autoapp::ui::UpdateDialog::on_pushButtonUpdateCsmt_clicked()
     ui_->pushButtonUpdateCsmt->hide();
     ui_->progressBarCsmt->show();
     qApp->processEvents();
-    system("crankshaft update csmt &");
+    helperClient_.execute("crankshaft update csmt");
 }
 
 void f1x::openauto::autoapp::ui::UpdateDialog::on_pushButtonUpdateUdev_clicked()
@@ -74,7 +75,7 @@ void f1x::openauto::autoapp::ui::UpdateDialog::on_pushButtonUpdateUdev_clicked()
     ui_->pushButtonUpdateUdev->hide();
     ui_->progressBarUdev->show();
     qApp->processEvents();
-    system("crankshaft update udev &");
+    helperClient_.execute("crankshaft update udev");
 }
 
 void f1x::openauto::autoapp::ui::UpdateDialog::on_pushButtonUpdateOpenauto_clicked()
@@ -82,7 +83,7 @@ void f1x::openauto::autoapp::ui::UpdateDialog::on_pushButtonUpdateOpenauto_click
     ui_->pushButtonUpdateOpenauto->hide();
     ui_->progressBarOpenauto->show();
     qApp->processEvents();
-    system("crankshaft update openauto &");
+    helperClient_.execute("crankshaft update openauto");
 }
 
 void f1x::openauto::autoapp::ui::UpdateDialog::on_pushButtonUpdateSystem_clicked()
@@ -91,7 +92,7 @@ void f1x::openauto::autoapp::ui::UpdateDialog::on_pushButtonUpdateSystem_clicked
     ui_->progressBarSystem->show();
     ui_->progressBarSystem->setValue(0);
     qApp->processEvents();
-    system("crankshaft update system &");
+    helperClient_.execute("crankshaft update system");
 }
 
 void f1x::openauto::autoapp::ui::UpdateDialog::on_pushButtonUpdateCheck_clicked()
@@ -99,7 +100,13 @@ void f1x::openauto::autoapp::ui::UpdateDialog::on_pushButtonUpdateCheck_clicked(
     ui_->pushButtonUpdateCheck->hide();
     ui_->labelUpdateChecking->show();
     qApp->processEvents();
-    system("/usr/local/bin/crankshaft update check");
+    helperClient_.execute("/usr/local/bin/crankshaft update check", [this](int) {
+        QMetaObject::invokeMethod(this, "onUpdateCheckFinished", Qt::QueuedConnection);
+    });
+}
+
+void f1x::openauto::autoapp::ui::UpdateDialog::onUpdateCheckFinished()
+{
     updateCheck();
     ui_->labelUpdateChecking->hide();
     ui_->pushButtonUpdateCheck->show();
@@ -108,7 +115,7 @@ void f1x::openauto::autoapp::ui::UpdateDialog::on_pushButtonUpdateCheck_clicked(
 void f1x::openauto::autoapp::ui::UpdateDialog::on_pushButtonUpdateCancel_clicked()
 {
     ui_->pushButtonUpdateCancel->hide();
-    system("crankshaft update cancel &");
+    helperClient_.execute("crankshaft update cancel");
 }
 
 void f1x::openauto::autoapp::ui::UpdateDialog::downloadCheck()
@@ -0,0 +1,93 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <pthread.h>
+#include <f1x/openauto/autoapp/USBEventLoop.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+USBEventLoop::USBEventLoop(libusb_context* usbContext)
+    : usbContext_(usbContext)
+    , stopped_(false)
+{
+
+}
+
+void USBEventLoop::start()
+{
+    std::promise<void> finished;
+    finished_ = finished.get_future();
+    thread_ = std::thread(&USBEventLoop::run, this, std::move(finished));
+}
+
+void USBEventLoop::stop()
+{
+    stopped_ = true;
+#if defined(LIBUSB_API_VERSION) && LIBUSB_API_VERSION >= 0x01000105
+    libusb_interrupt_event_handler(usbContext_);
+#endif
+}
+
+bool USBEventLoop::join(std::chrono::steady_clock::time_point deadline)
+{
+    if(!thread_.joinable())
+    {
+        return true;
+    }
+
+    if(finished_.wait_until(deadline) != std::future_status::ready)
+    {
+        OPENAUTO_LOG(error) << "[USBEventLoop] event thread did not exit before deadline.";
+        thread_.detach();
+        return false;
+    }
+
+    thread_.join();
+    return true;
+}
+
+void USBEventLoop::run(std::promise<void> finished)
+{
+    pthread_setname_np(pthread_self(), "oa-usb");
+
+#if defined(LIBUSB_API_VERSION) && LIBUSB_API_VERSION >= 0x01000105
+    timeval eventTimeout{60, 0};
+#else
+    timeval eventTimeout{1, 0};
+#endif
+
+    OPENAUTO_LOG(info) << "[USBEventLoop] started.";
+
+    while(!stopped_)
+    {
+        libusb_handle_events_timeout_completed(usbContext_, &eventTimeout, nullptr);
+    }
+
+    OPENAUTO_LOG(info) << "[USBEventLoop] stopped.";
+    finished.set_value();
+}
+
+}
+}
+}
@@ -0,0 +1,316 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <algorithm>
+#include <cerrno>
+#include <vector>
+#include <alsa/asoundlib.h>
+#include <f1x/openauto/autoapp/VolumeController.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+const char* const VolumeController::cCardName = "default";
+const char* const VolumeController::cPlaybackElements[] = {"Master", "PCM", "Speaker", "Headphone", nullptr};
+const char* const VolumeController::cCaptureElements[] = {"Capture", "Mic", nullptr};
+
+VolumeController::VolumeController(QObject* parent)
+    : QObject(parent)
+    , mixer_(nullptr)
+    , playbackElement_(nullptr)
+    , captureElement_(nullptr)
+    , eventFd_(-1)
+    , pendingPlayback_(-1)
+    , pendingCapture_(-1)
+    , playbackVolume_(-1)
+    , captureVolume_(-1)
+    , coalescedUpdates_(0)
+    , stopping_(false)
+    , playbackRaw_(-1)
+    , captureRaw_(-1)
+{
+
+}
+
+VolumeController::~VolumeController()
+{
+    this->stop();
+}
+
+bool VolumeController::start()
+{
+    int result = snd_mixer_open(&mixer_, 0);
+    if(result >= 0)
+    {
+        result = snd_mixer_attach(mixer_, cCardName);
+    }
+
+    if(result >= 0)
+    {
+        result = snd_mixer_selem_register(mixer_, nullptr, nullptr);
+    }
+
+    if(result >= 0)
+    {
+        result = snd_mixer_load(mixer_);
+    }
+
+    if(result < 0)
+    {
+        OPENAUTO_LOG(error) << "[VolumeController] Cannot open mixer " << cCardName << ": " << snd_strerror(result);
+        this->stop();
+        return false;
+    }
+
+    playbackElement_ = this->findElement(cPlaybackElements, true);
+    captureElement_ = this->findElement(cCaptureElements, false);
+    OPENAUTO_LOG(info) << "[VolumeController] Playback: " << (playbackElement_ != nullptr ? snd_mixer_selem_get_name(playbackElement_) : "none")
+                       << ", capture: " << (captureElement_ != nullptr ? snd_mixer_selem_get_name(captureElement_) : "none") << ".";
+
+    eventFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if(eventFd_ < 0)
+    {
+        OPENAUTO_LOG(error) << "[VolumeController] Cannot create eventfd, errno: " << errno;
+        this->stop();
+        return false;
+    }
+
+    this->readVolumes();
+    thread_ = std::thread(&VolumeController::run, this);
+    return true;
+}
+
+void VolumeController::stop()
+{
+    if(thread_.joinable())
+    {
+        stopping_ = true;
+        this->wake();
+        thread_.join();
+        OPENAUTO_LOG(info) << "[VolumeController] Stopped, coalesced updates: " << coalescedUpdates_ << ".";
+    }
+
+    if(eventFd_ >= 0)
+    {
+        close(eventFd_);
+        eventFd_ = -1;
+    }
+
+    if(mixer_ != nullptr)
+    {
+        snd_mixer_close(mixer_);
+        mixer_ = nullptr;
+        playbackElement_ = nullptr;
+        captureElement_ = nullptr;
+    }
+}
+
+bool VolumeController::isAvailable() const
+{
+    return eventFd_ >= 0;
+}
+
+int VolumeController::getPlaybackVolume() const
+{
+    return playbackVolume_;
+}
+
+int VolumeController::getCaptureVolume() const
+{
+    return captureVolume_;
+}
+
+void VolumeController::setPlaybackVolume(int percent)
+{
+    if(pendingPlayback_.exchange(std::max(0, std::min(100, percent))) >= 0)
+    {
+        ++coalescedUpdates_;
+    }
+
+    this->wake();
+}
+
+void VolumeController::setCaptureVolume(int percent)
+{
+    if(pendingCapture_.exchange(std::max(0, std::min(100, percent))) >= 0)
+    {
+        ++coalescedUpdates_;
+    }
+
+    this->wake();
+}
+
+void VolumeController::wake()
+{
+    if(eventFd_ >= 0)
+    {
+        const uint64_t value = 1;
+        if(write(eventFd_, &value, sizeof(value)) < 0 && errno != EAGAIN)
+        {
+            OPENAUTO_LOG(error) << "[VolumeController] Cannot wake worker, errno: " << errno;
+        }
+    }
+}
+
+void VolumeController::run()
+{
+    std::vector<pollfd> descriptors;
+
+    while(!stopping_)
+    {
+        const int count = std::max(0, snd_mixer_poll_descriptors_count(mixer_));
+        descriptors.resize(count + 1);
+        descriptors[0].fd = eventFd_;
+        descriptors[0].events = POLLIN;
+        descriptors[0].revents = 0;
+        snd_mixer_poll_descriptors(mixer_, descriptors.data() + 1, count);
+
+        if(poll(descriptors.data(), descriptors.size(), -1) < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+
+            OPENAUTO_LOG(error) << "[VolumeController] poll failed, errno: " << errno;
+            break;
+        }
+
+        if(descriptors[0].revents & POLLIN)
+        {
+            uint64_t value = 0;
+            if(read(eventFd_, &value, sizeof(value)) == sizeof(value) && !stopping_)
+            {
+                this->apply();
+            }
+        }
+
+        unsigned short revents = 0;
+        if(count > 0 && snd_mixer_poll_descriptors_revents(mixer_, descriptors.data() + 1, count, &revents) >= 0 && (revents & POLLIN))
+        {
+            snd_mixer_handle_events(mixer_);
+            this->readVolumes();
+        }
+    }
+}
+
+void VolumeController::apply()
+{
+    const int playback = pendingPlayback_.exchange(-1);
+    if(playback >= 0 && playbackElement_ != nullptr)
+    {
+        playbackRaw_ = toRaw(playbackElement_, true, playback);
+        snd_mixer_selem_set_playback_volume_all(playbackElement_, playbackRaw_);
+        playbackVolume_ = playback;
+        emit playbackVolumeChanged(playback);
+    }
+
+    const int capture = pendingCapture_.exchange(-1);
+    if(capture >= 0 && captureElement_ != nullptr)
+    {
+        captureRaw_ = toRaw(captureElement_, false, capture);
+        snd_mixer_selem_set_capture_volume_all(captureElement_, captureRaw_);
+        captureVolume_ = capture;
+        emit captureVolumeChanged(capture);
+    }
+}
+
+void VolumeController::readVolumes()
+{
+    long raw = 0;
+    if(playbackElement_ != nullptr && snd_mixer_selem_get_playback_volume(playbackElement_, SND_MIXER_SCHN_FRONT_LEFT, &raw) == 0 && raw != playbackRaw_)
+    {
+        playbackRaw_ = raw;
+        playbackVolume_ = toPercent(playbackElement_, true, raw);
+        emit playbackVolumeChanged(playbackVolume_);
+    }
+
+    if(captureElement_ != nullptr && snd_mixer_selem_get_capture_volume(captureElement_, SND_MIXER_SCHN_FRONT_LEFT, &raw) == 0 && raw != captureRaw_)
+    {
+        captureRaw_ = raw;
+        captureVolume_ = toPercent(captureElement_, false, raw);
+        emit captureVolumeChanged(captureVolume_);
+    }
+}
+
+snd_mixer_elem_t* VolumeController::findElement(const char* const names[], bool playback) const
+{
+    const auto hasVolume = [playback](snd_mixer_elem_t* element) {
+        return snd_mixer_selem_is_active(element) && (playback ? snd_mixer_selem_has_playback_volume(element) : snd_mixer_selem_has_capture_volume(element));
+    };
+
+    snd_mixer_selem_id_t* id = nullptr;
+    snd_mixer_selem_id_alloca(&id);
+
+    for(size_t i = 0; names[i] != nullptr; ++i)
+    {
+        snd_mixer_selem_id_set_index(id, 0);
+        snd_mixer_selem_id_set_name(id, names[i]);
+
+        snd_mixer_elem_t* element = snd_mixer_find_selem(mixer_, id);
+        if(element != nullptr && hasVolume(element))
+        {
+            return element;
+        }
+    }
+
+    for(snd_mixer_elem_t* element = snd_mixer_first_elem(mixer_); element != nullptr; element = snd_mixer_elem_next(element))
+    {
+        if(hasVolume(element))
+        {
+            return element;
+        }
+    }
+
+    return nullptr;
+}
+
+long VolumeController::toRaw(snd_mixer_elem_t* element, bool playback, int percent)
+{
+    long min = 0;
+    long max = 0;
+    playback ? snd_mixer_selem_get_playback_volume_range(element, &min, &max) : snd_mixer_selem_get_capture_volume_range(element, &min, &max);
+
+    return min + ((max - min) * percent + 50) / 100;
+}
+
+int VolumeController::toPercent(snd_mixer_elem_t* element, bool playback, long raw)
+{
+    long min = 0;
+    long max = 0;
+    playback ? snd_mixer_selem_get_playback_volume_range(element, &min, &max) : snd_mixer_selem_get_capture_volume_range(element, &min, &max);
+
+    if(max <= min)
+    {
+        return 0;
+    }
+
+    return static_cast<int>(((raw - min) * 100 + (max - min) / 2) / (max - min));
+}
+
+}
+}
+}
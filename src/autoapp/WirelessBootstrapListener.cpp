@@ -0,0 +1,169 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <f1x/openauto/autoapp/WirelessBootstrapListener.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace autoapp
+{
+
+WirelessBootstrapListener::WirelessBootstrapListener(boost::asio::io_service& ioService, common::TCPTuning tcpTuning, QObject* parent)
+    : QObject(parent)
+    , ioService_(ioService)
+    , strand_(ioService_)
+    , acceptor_(ioService_)
+    , tcpTuning_(std::move(tcpTuning))
+    , localServer_(std::make_unique<QLocalServer>(this))
+{
+    qRegisterMetaType<aasdk::tcp::ITCPEndpoint::SocketPointer>("aasdk::tcp::ITCPEndpoint::SocketPointer");
+    connect(localServer_.get(), &QLocalServer::newConnection, this, &WirelessBootstrapListener::onClientConnected);
+    connect(this, &WirelessBootstrapListener::listenFinished, this, &WirelessBootstrapListener::onListenFinished, Qt::QueuedConnection);
+}
+
+bool WirelessBootstrapListener::start(const QString& serverName)
+{
+    QLocalServer::removeServer(serverName);
+    return localServer_->listen(serverName);
+}
+
+void WirelessBootstrapListener::stop()
+{
+    localServer_->close();
+
+    strand_.dispatch([this]() {
+        boost::system::error_code ec;
+        acceptor_.close(ec);
+    });
+}
+
+void WirelessBootstrapListener::onClientConnected()
+{
+    auto socket = localServer_->nextPendingConnection();
+    if(socket == nullptr)
+    {
+        return;
+    }
+
+    connect(socket, &QLocalSocket::disconnected, socket, &QLocalSocket::deleteLater);
+    connect(socket, &QLocalSocket::readyRead, this, [this, socket]() {
+        while(socket->canReadLine())
+        {
+            this->handleMessage(socket, QString::fromUtf8(socket->readLine()).trimmed());
+        }
+    });
+}
+
+void WirelessBootstrapListener::onListenFinished(bool success)
+{
+    for(const auto& socket : pendingReplies_)
+    {
+        if(socket != nullptr)
+        {
+            socket->write(success ? "listening\n" : "error\n");
+        }
+    }
+
+    pendingReplies_.clear();
+}
+
+void WirelessBootstrapListener::handleMessage(QLocalSocket* socket, const QString& message)
+{
+    const auto parts = message.split(' ', QString::SkipEmptyParts);
+    if(parts.isEmpty())
+    {
+        return;
+    }
+
+    if(parts[0] == "listen" && parts.size() > 1)
+    {
+        pendingReplies_.append(socket);
+        this->listen(parts[1].toUShort());
+    }
+    else if(parts[0] == "done" || parts[0] == "failed")
+    {
+        OPENAUTO_LOG(info) << "[WirelessBootstrapListener] wireless bootstrap " << parts[0].toStdString()
+                           << " after " << (parts.size() > 1 ? parts[1].toStdString() : "?") << " ms.";
+    }
+    else
+    {
+        OPENAUTO_LOG(error) << "[WirelessBootstrapListener] unknown message: " << message.toStdString();
+    }
+}
+
+void WirelessBootstrapListener::listen(uint16_t port)
+{
+    strand_.dispatch([this, port]() {
+        if(acceptor_.is_open())
+        {
+            emit listenFinished(true);
+            return;
+        }
+
+        try
+        {
+            const boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::tcp::v4(), port);
+            acceptor_.open(endpoint.protocol());
+            acceptor_.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+
+            for(const auto& failure : common::TCPTuner::applyBuffers(acceptor_.native_handle(), tcpTuning_))
+            {
+                OPENAUTO_LOG(warning) << "[WirelessBootstrapListener] failed to set " << failure << ".";
+            }
+
+            acceptor_.bind(endpoint);
+            acceptor_.listen();
+        }
+        catch(const boost::system::system_error& se)
+        {
+            OPENAUTO_LOG(error) << "[WirelessBootstrapListener] cannot listen on port " << port << ": " << se.what();
+            boost::system::error_code ec;
+            acceptor_.close(ec);
+            emit listenFinished(false);
+            return;
+        }
+
+        OPENAUTO_LOG(info) << "[WirelessBootstrapListener] waiting for phone on port " << port << ".";
+
+        auto socket = std::make_shared<boost::asio::ip::tcp::socket>(ioService_);
+        acceptor_.async_accept(*socket, strand_.wrap(std::bind(&WirelessBootstrapListener::onAccepted, this, std::placeholders::_1, socket)));
+        emit listenFinished(true);
+    });
+}
+
+void WirelessBootstrapListener::onAccepted(const boost::system::error_code& error, aasdk::tcp::ITCPEndpoint::SocketPointer socket)
+{
+    boost::system::error_code ec;
+    acceptor_.close(ec);
+
+    if(error)
+    {
+        OPENAUTO_LOG(error) << "[WirelessBootstrapListener] accept failed: " << error.message();
+        return;
+    }
+
+    OPENAUTO_LOG(info) << "[WirelessBootstrapListener] phone connected from " << socket->remote_endpoint(ec).address().to_string() << ".";
+    emit connectionAccepted(std::move(socket));
+}
+
+}
+}
+}
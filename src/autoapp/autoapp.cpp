@@ -16,6 +16,9 @@
 *  along with openauto. If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
 #include <thread>
 #include <QApplication>
 #include <QDesktopWidget>
@@ -26,6 +29,12 @@
 #include <f1x/aasdk/USB/AccessoryModeQueryFactory.hpp>
 #include <f1x/aasdk/TCP/TCPWrapper.hpp>
 #include <f1x/openauto/autoapp/App.hpp>
+#include <f1x/openauto/autoapp/Executor.hpp>
+#include <f1x/openauto/autoapp/HelperClient.hpp>
+#include <f1x/openauto/autoapp/NetworkMonitor.hpp>
+#include <f1x/openauto/autoapp/USBEventLoop.hpp>
+#include <f1x/openauto/autoapp/VolumeController.hpp>
+#include <f1x/openauto/autoapp/WirelessBootstrapListener.hpp>
 #include <f1x/openauto/autoapp/Configuration/IConfiguration.hpp>
 #include <f1x/openauto/autoapp/Configuration/RecentAddressesList.hpp>
 #include <f1x/openauto/autoapp/Service/AndroidAutoEntityFactory.hpp>
@@ -36,40 +45,12 @@
 #include <f1x/openauto/autoapp/UI/ConnectDialog.hpp>
 #include <f1x/openauto/autoapp/UI/WarningDialog.hpp>
 #include <f1x/openauto/autoapp/UI/UpdateDialog.hpp>
+#include <f1x/openauto/Common/HelperProtocol.hpp>
 #include <f1x/openauto/Common/Log.hpp>
 
 namespace aasdk = f1x::aasdk;
 namespace autoapp = f1x::openauto::autoapp;
-using ThreadPool = std::vector<std::thread>;
-
-void startUSBWorkers(boost::asio::io_service& ioService, libusb_context* usbContext, ThreadPool& threadPool)
-{
-    auto usbWorker = [&ioService, usbContext]() {
-        timeval libusbEventTimeout{180, 0};
-
-        while(!ioService.stopped())
-        {
-            libusb_handle_events_timeout_completed(usbContext, &libusbEventTimeout, nullptr);
-        }
-    };
-
-    threadPool.emplace_back(usbWorker);
-    threadPool.emplace_back(usbWorker);
-    threadPool.emplace_back(usbWorker);
-    threadPool.emplace_back(usbWorker);
-}
-
-void startIOServiceWorkers(boost::asio::io_service& ioService, ThreadPool& threadPool)
-{
-    auto ioServiceWorker = [&ioService]() {
-        ioService.run();
-    };
-
-    threadPool.emplace_back(ioServiceWorker);
-    threadPool.emplace_back(ioServiceWorker);
-    threadPool.emplace_back(ioServiceWorker);
-    threadPool.emplace_back(ioServiceWorker);
-}
+namespace common = f1x::openauto::common;
 
 int main(int argc, char* argv[])
 {
@@ -80,12 +61,6 @@ int main(int argc, char* argv[])
         return 1;
     }
 
-    boost::asio::io_service ioService;
-    boost::asio::io_service::work work(ioService);
-    std::vector<std::thread> threadPool;
-    startUSBWorkers(ioService, usbContext, threadPool);
-    startIOServiceWorkers(ioService, threadPool);
-
     QApplication qApplication(argc, argv);
     const int width = QApplication::desktop()->width();
     const int height = QApplication::desktop()->height();
@@ -94,10 +69,38 @@ int main(int argc, char* argv[])
 
     auto configuration = std::make_shared<autoapp::configuration::Configuration>();
 
-    autoapp::ui::MainWindow mainWindow(configuration);
+    OPENAUTO_LOG(info) << "[OpenAuto] CPU cores: " << std::thread::hardware_concurrency();
+    autoapp::Executor mediaExecutor("media", configuration->getExecutorConfig(autoapp::configuration::ExecutorType::MEDIA));
+    autoapp::Executor controlExecutor("control", configuration->getExecutorConfig(autoapp::configuration::ExecutorType::CONTROL));
+    autoapp::Executor transportExecutor("transport", configuration->getExecutorConfig(autoapp::configuration::ExecutorType::TRANSPORT));
+    autoapp::Executor housekeepingExecutor("housekeeping", configuration->getExecutorConfig(autoapp::configuration::ExecutorType::HOUSEKEEPING));
+    mediaExecutor.start();
+    controlExecutor.start();
+    transportExecutor.start();
+    housekeepingExecutor.start();
+
+    boost::asio::io_service& ioService = controlExecutor.getIoService();
+    autoapp::USBEventLoop usbEventLoop(usbContext);
+    usbEventLoop.start();
+
+    autoapp::HelperClient helperClient(housekeepingExecutor.getIoService(), common::cHelperSocketPath, QCoreApplication::applicationDirPath().toStdString() + "/helperd");
+
+    autoapp::VolumeController volumeController;
+    if(!volumeController.start())
+    {
+        OPENAUTO_LOG(warning) << "[OpenAuto] Mixer unavailable, volume changes go through autoapp_helper.";
+    }
+
+    autoapp::NetworkMonitor networkMonitor;
+    if(!networkMonitor.start())
+    {
+        OPENAUTO_LOG(warning) << "[OpenAuto] Network monitor unavailable, network info will not update.";
+    }
+
+    autoapp::ui::MainWindow mainWindow(configuration, helperClient, volumeController, networkMonitor);
     mainWindow.setWindowFlags(Qt::WindowStaysOnTopHint);
 
-    autoapp::ui::SettingsWindow settingsWindow(configuration);
+    autoapp::ui::SettingsWindow settingsWindow(configuration, helperClient, volumeController, networkMonitor);
     settingsWindow.setWindowFlags(Qt::WindowStaysOnTopHint);
 
     settingsWindow.setFixedSize(width, height);
@@ -107,7 +110,7 @@ int main(int argc, char* argv[])
     recentAddressesList.read();
 
     aasdk::tcp::TCPWrapper tcpWrapper;
-    autoapp::ui::ConnectDialog connectdialog(ioService, tcpWrapper, recentAddressesList);
+    autoapp::ui::ConnectDialog connectdialog(ioService, tcpWrapper, recentAddressesList, helperClient, networkMonitor, configuration->getTCPTuning());
     connectdialog.setWindowFlags(Qt::WindowStaysOnTopHint);
     connectdialog.move((width - 500)/2,(height-300)/2);
 
@@ -115,13 +118,13 @@ int main(int argc, char* argv[])
     warningdialog.setWindowFlags(Qt::WindowStaysOnTopHint);
     warningdialog.move((width - 500)/2,(height-300)/2);
 
-    autoapp::ui::UpdateDialog updatedialog;
+    autoapp::ui::UpdateDialog updatedialog(helperClient);
     updatedialog.setWindowFlags(Qt::WindowStaysOnTopHint);
     updatedialog.setFixedSize(500, 260);
     updatedialog.move((width - 500)/2,(height-260)/2);
 
-    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::exit, []() { system("touch /tmp/shutdown"); std::exit(0); });
-    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::reboot, []() { system("touch /tmp/reboot"); std::exit(0); });
+    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::exit, []() { std::ofstream("/tmp/shutdown"); QApplication::quit(); });
+    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::reboot, []() { std::ofstream("/tmp/reboot"); QApplication::quit(); });
     QObject::connect(&mainWindow, &autoapp::ui::MainWindow::openSettings, &settingsWindow, &autoapp::ui::SettingsWindow::showFullScreen);
     QObject::connect(&mainWindow, &autoapp::ui::MainWindow::openSettings, &settingsWindow, &autoapp::ui::SettingsWindow::show_tab1);
     QObject::connect(&mainWindow, &autoapp::ui::MainWindow::openSettings, &settingsWindow, &autoapp::ui::SettingsWindow::loadSystemValues);
@@ -136,58 +139,58 @@ int main(int argc, char* argv[])
         qApplication.setOverrideCursor(Qt::ArrowCursor);
     }
 
-    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::cameraHide, [&qApplication]() {
-        system("/opt/crankshaft/cameracontrol.py Background &");
+    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::cameraHide, [&helperClient]() {
+        helperClient.execute("/opt/crankshaft/cameracontrol.py Background");
         OPENAUTO_LOG(info) << "[Camera] Background.";
     });
 
-    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::cameraShow, [&qApplication]() {
-        system("/opt/crankshaft/cameracontrol.py Foreground &");
+    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::cameraShow, [&helperClient]() {
+        helperClient.execute("/opt/crankshaft/cameracontrol.py Foreground");
         OPENAUTO_LOG(info) << "[Camera] Foreground.";
     });
 
-    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::cameraPosYUp, [&qApplication]() {
-        system("/opt/crankshaft/cameracontrol.py PosYUp &");
+    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::cameraPosYUp, [&helperClient]() {
+        helperClient.execute("/opt/crankshaft/cameracontrol.py PosYUp");
         OPENAUTO_LOG(info) << "[Camera] PosY up.";
     });
 
-    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::cameraPosYDown, [&qApplication]() {
-        system("/opt/crankshaft/cameracontrol.py PosYDown &");
+    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::cameraPosYDown, [&helperClient]() {
+        helperClient.execute("/opt/crankshaft/cameracontrol.py PosYDown");
         OPENAUTO_LOG(info) << "[Camera] PosY down.";
     });
 
-    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::cameraZoomPlus, [&qApplication]() {
-        system("/opt/crankshaft/cameracontrol.py ZoomPlus &");
+    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::cameraZoomPlus, [&helperClient]() {
+        helperClient.execute("/opt/crankshaft/cameracontrol.py ZoomPlus");
         OPENAUTO_LOG(info) << "[Camera] Zoom plus.";
     });
 
-    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::cameraZoomMinus, [&qApplication]() {
-        system("/opt/crankshaft/cameracontrol.py ZoomMinus &");
+    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::cameraZoomMinus, [&helperClient]() {
+        helperClient.execute("/opt/crankshaft/cameracontrol.py ZoomMinus");
         OPENAUTO_LOG(info) << "[Camera] Zoom minus.";
     });
 
-    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::cameraRecord, [&qApplication]() {
-        system("/opt/crankshaft/cameracontrol.py Record &");
+    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::cameraRecord, [&helperClient]() {
+        helperClient.execute("/opt/crankshaft/cameracontrol.py Record");
         OPENAUTO_LOG(info) << "[Camera] Record.";
     });
 
-    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::cameraStop, [&qApplication]() {
-        system("/opt/crankshaft/cameracontrol.py Stop &");
+    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::cameraStop, [&helperClient]() {
+        helperClient.execute("/opt/crankshaft/cameracontrol.py Stop");
         OPENAUTO_LOG(info) << "[Camera] Stop.";
     });
 
-    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::cameraSave, [&qApplication]() {
-        system("/opt/crankshaft/cameracontrol.py Save &");
+    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::cameraSave, [&helperClient]() {
+        helperClient.execute("/opt/crankshaft/cameracontrol.py Save");
         OPENAUTO_LOG(info) << "[Camera] Save.";
     });
 
-    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::TriggerScriptNight, [&qApplication]() {
-        system("/opt/crankshaft/service_daynight.sh app night");
+    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::TriggerScriptNight, [&helperClient]() {
+        helperClient.execute("/opt/crankshaft/service_daynight.sh app night");
         OPENAUTO_LOG(info) << "[MainWindow] Night.";
     });
 
-    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::TriggerScriptDay, [&qApplication]() {
-        system("/opt/crankshaft/service_daynight.sh app day");
+    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::TriggerScriptDay, [&helperClient]() {
+        helperClient.execute("/opt/crankshaft/service_daynight.sh app day");
         OPENAUTO_LOG(info) << "[MainWindow] Day.";
     });
 
@@ -198,17 +201,27 @@ int main(int argc, char* argv[])
     aasdk::usb::USBWrapper usbWrapper(usbContext);
     aasdk::usb::AccessoryModeQueryFactory queryFactory(usbWrapper, ioService);
     aasdk::usb::AccessoryModeQueryChainFactory queryChainFactory(usbWrapper, ioService, queryFactory);
-    autoapp::service::ServiceFactory serviceFactory(ioService, configuration);
-    autoapp::service::AndroidAutoEntityFactory androidAutoEntityFactory(ioService, configuration, serviceFactory);
+    autoapp::service::ServiceFactory serviceFactory(ioService, mediaExecutor.getIoService(), housekeepingExecutor.getIoService(), configuration);
+    autoapp::service::AndroidAutoEntityFactory androidAutoEntityFactory(ioService, transportExecutor.getIoService(), configuration, serviceFactory);
 
     auto usbHub(std::make_shared<aasdk::usb::USBHub>(usbWrapper, ioService, queryChainFactory));
     auto connectedAccessoriesEnumerator(std::make_shared<aasdk::usb::ConnectedAccessoriesEnumerator>(usbWrapper, ioService, queryChainFactory));
-    auto app = std::make_shared<autoapp::App>(ioService, usbWrapper, tcpWrapper, androidAutoEntityFactory, std::move(usbHub), std::move(connectedAccessoriesEnumerator));
+    auto app = std::make_shared<autoapp::App>(ioService, usbWrapper, tcpWrapper, androidAutoEntityFactory, std::move(usbHub), std::move(connectedAccessoriesEnumerator), configuration);
 
     QObject::connect(&connectdialog, &autoapp::ui::ConnectDialog::connectionSucceed, [&app](auto socket) {
         app->start(std::move(socket));
     });
 
+    autoapp::WirelessBootstrapListener wirelessBootstrapListener(ioService, configuration->getTCPTuning());
+    QObject::connect(&wirelessBootstrapListener, &autoapp::WirelessBootstrapListener::connectionAccepted, [&app](auto socket) {
+        app->start(std::move(socket));
+    });
+
+    if(!wirelessBootstrapListener.start("openauto_wireless"))
+    {
+        OPENAUTO_LOG(error) << "[OpenAuto] Wireless bootstrap listener start failed.";
+    }
+
     QObject::connect(&mainWindow, &autoapp::ui::MainWindow::TriggerAppStart, [&app]() {
         OPENAUTO_LOG(info) << "[Autoapp] TriggerAppStart: Manual start android auto.";
         try {
@@ -220,19 +233,21 @@ int main(int argc, char* argv[])
         }
     });
 
-    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::TriggerAppStop, [&app]() {
+    QObject::connect(&mainWindow, &autoapp::ui::MainWindow::TriggerAppStop, [&app, &helperClient, &ioService]() {
         try {
             if (std::ifstream("/tmp/android_device")) {
                 OPENAUTO_LOG(info) << "[Autoapp] TriggerAppStop: Manual stop usb android auto.";
                 app->disableAutostartEntity = true;
-                system("/usr/local/bin/autoapp_helper usbreset");
-                usleep(500000);
-                try {
-                    app->stop();
-                    //app->pause();
-                } catch (...) {
-                    OPENAUTO_LOG(error) << "[Autoapp] TriggerAppStop: stop();";
-                }
+                helperClient.execute("/usr/local/bin/autoapp_helper usbreset", [&app, &ioService](int) {
+                    auto timer = std::make_shared<boost::asio::deadline_timer>(ioService, boost::posix_time::milliseconds(500));
+                    timer->async_wait([&app, timer](const boost::system::error_code&) {
+                        try {
+                            app->stop();
+                        } catch (...) {
+                            OPENAUTO_LOG(error) << "[Autoapp] TriggerAppStop: stop();";
+                        }
+                    });
+                });
 
             } else {
                 OPENAUTO_LOG(info) << "[Autoapp] TriggerAppStop: Manual stop wifi android auto.";
@@ -265,8 +280,44 @@ int main(int argc, char* argv[])
 
     auto result = qApplication.exec();
 
-    std::for_each(threadPool.begin(), threadPool.end(), std::bind(&std::thread::join, std::placeholders::_1));
+    const auto shutdownStart = std::chrono::steady_clock::now();
+    const auto shutdownDeadline = shutdownStart + std::chrono::milliseconds(configuration->getShutdownTimeout());
+    OPENAUTO_LOG(info) << "[OpenAuto] Shutting down, deadline: " << configuration->getShutdownTimeout() << " ms.";
+
+    wirelessBootstrapListener.stop();
+    app->stop();
+    helperClient.stop();
+    volumeController.stop();
+    networkMonitor.stop();
+    configuration->flush();
+    mediaExecutor.stop();
+    controlExecutor.stop();
+    transportExecutor.stop();
+    housekeepingExecutor.stop();
+
+    // Qt backends stop and prewarm through blocking calls into the GUI thread, so keep serving them while the executors drain.
+    while(!(mediaExecutor.isFinished() && controlExecutor.isFinished() && transportExecutor.isFinished() && housekeepingExecutor.isFinished()) && std::chrono::steady_clock::now() < shutdownDeadline)
+    {
+        qApplication.processEvents(QEventLoop::ExcludeUserInputEvents);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    bool joined = mediaExecutor.join(shutdownDeadline);
+    joined = controlExecutor.join(shutdownDeadline) && joined;
+    joined = transportExecutor.join(shutdownDeadline) && joined;
+    joined = housekeepingExecutor.join(shutdownDeadline) && joined;
+
+    usbEventLoop.stop();
+    joined = usbEventLoop.join(shutdownDeadline) && joined;
+
+    const auto shutdownDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - shutdownStart);
+    if(!joined)
+    {
+        OPENAUTO_LOG(error) << "[OpenAuto] Shutdown deadline exceeded after " << shutdownDuration.count() << " ms, forcing exit.";
+        std::_Exit(result);
+    }
 
     libusb_exit(usbContext);
+    OPENAUTO_LOG(info) << "[OpenAuto] Shutdown completed in " << shutdownDuration.count() << " ms.";
     return result;
 }
@@ -0,0 +1,296 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include <QCoreApplication>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <f1x/openauto/Common/Log.hpp>
+
+// message ids of the wireless projection protocol, deliberately not shared with btservice
+const uint16_t cWifiStartRequest = 1;
+const uint16_t cWifiInfoRequest = 2;
+const uint16_t cWifiInfoResponse = 3;
+const uint16_t cWifiConnectStatus = 6;
+const uint16_t cWifiStartResponse = 7;
+
+const int cReplyTimeoutMs = 3000;
+const int cQuietPeriodMs = 500;
+
+void printUsage(const char* name)
+{
+    std::cerr << "Usage: " << name << " --server <name> [--autoapp <name>]" << std::endl
+              << "  --server <name>   local server name passed to 'btservice --local'" << std::endl
+              << "  --autoapp <name>  autoapp control socket name (default openauto_wireless)" << std::endl;
+}
+
+int fail(const std::string& reason)
+{
+    OPENAUTO_LOG(error) << "[bootstrapcheck] FAILED: " << reason;
+    return 1;
+}
+
+void appendVarint(QByteArray& buffer, uint64_t value)
+{
+    do
+    {
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        buffer.append(static_cast<char>(value != 0 ? byte | 0x80 : byte));
+    }
+    while(value != 0);
+}
+
+bool readVarint(const QByteArray& buffer, int& offset, uint64_t& value)
+{
+    value = 0;
+    for(uint32_t shift = 0; shift < 64 && offset < buffer.size(); shift += 7)
+    {
+        const uint8_t byte = static_cast<uint8_t>(buffer[offset++]);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool parseFields(const QByteArray& payload, std::map<uint32_t, std::string>& strings, std::map<uint32_t, uint64_t>& varints)
+{
+    int offset = 0;
+    while(offset < payload.size())
+    {
+        uint64_t key = 0;
+        uint64_t value = 0;
+        if(!readVarint(payload, offset, key) || !readVarint(payload, offset, value))
+        {
+            return false;
+        }
+
+        if((key & 0x07) == 0)
+        {
+            varints[static_cast<uint32_t>(key >> 3)] = value;
+        }
+        else if((key & 0x07) == 2 && value <= static_cast<uint64_t>(payload.size() - offset))
+        {
+            strings[static_cast<uint32_t>(key >> 3)] = payload.mid(offset, static_cast<int>(value)).toStdString();
+            offset += static_cast<int>(value);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void writeFrame(QLocalSocket& socket, uint16_t messageId, const QByteArray& payload)
+{
+    QByteArray frame;
+    frame.append(static_cast<char>((payload.size() >> 8) & 0xFF));
+    frame.append(static_cast<char>(payload.size() & 0xFF));
+    frame.append(static_cast<char>((messageId >> 8) & 0xFF));
+    frame.append(static_cast<char>(messageId & 0xFF));
+    frame.append(payload);
+
+    socket.write(frame);
+    socket.waitForBytesWritten(cReplyTimeoutMs);
+}
+
+bool readFrame(QLocalSocket& socket, uint16_t& messageId, QByteArray& payload)
+{
+    while(socket.bytesAvailable() < 4)
+    {
+        if(!socket.waitForReadyRead(cReplyTimeoutMs))
+        {
+            return false;
+        }
+    }
+
+    const auto header = socket.peek(4);
+    const int size = (static_cast<uint8_t>(header[0]) << 8) | static_cast<uint8_t>(header[1]);
+    messageId = (static_cast<uint8_t>(header[2]) << 8) | static_cast<uint8_t>(header[3]);
+
+    while(socket.bytesAvailable() < size + 4)
+    {
+        if(!socket.waitForReadyRead(cReplyTimeoutMs))
+        {
+            return false;
+        }
+    }
+
+    socket.read(4);
+    payload = socket.read(size);
+    return true;
+}
+
+bool readControlMessage(QLocalServer& server, QLocalSocket*& socket, std::string& message)
+{
+    if(!server.hasPendingConnections() && !server.waitForNewConnection(cReplyTimeoutMs))
+    {
+        return false;
+    }
+
+    socket = server.nextPendingConnection();
+    while(!socket->canReadLine())
+    {
+        if(!socket->waitForReadyRead(cReplyTimeoutMs))
+        {
+            return false;
+        }
+    }
+
+    message = socket->readLine().trimmed().toStdString();
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication application(argc, argv);
+
+    QString serverName;
+    QString autoappName = "openauto_wireless";
+
+    for(int i = 1; i < argc; ++i)
+    {
+        const bool hasValue = i + 1 < argc;
+
+        if(hasValue && std::strcmp(argv[i], "--server") == 0)
+        {
+            serverName = argv[++i];
+        }
+        else if(hasValue && std::strcmp(argv[i], "--autoapp") == 0)
+        {
+            autoappName = argv[++i];
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if(serverName.isEmpty())
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    QLocalServer autoapp;
+    QLocalServer::removeServer(autoappName);
+    if(!autoapp.listen(autoappName))
+    {
+        return fail("cannot serve " + autoappName.toStdString() + ", is autoapp running?");
+    }
+
+    QLocalSocket phone;
+    phone.connectToServer(serverName);
+    if(!phone.waitForConnected(cReplyTimeoutMs))
+    {
+        return fail("cannot connect to " + serverName.toStdString() + ": " + phone.errorString().toStdString());
+    }
+
+    QLocalSocket* control = nullptr;
+    std::string message;
+    if(!readControlMessage(autoapp, control, message) || message.compare(0, 7, "listen ") != 0)
+    {
+        return fail("expected a listen request, got '" + message + "'");
+    }
+
+    const uint64_t port = std::stoul(message.substr(7));
+    if(phone.bytesAvailable() > 0 || phone.waitForReadyRead(cQuietPeriodMs))
+    {
+        return fail("start request sent before autoapp acknowledged the listen request");
+    }
+
+    control->write("listening\n");
+    control->waitForBytesWritten(cReplyTimeoutMs);
+    OPENAUTO_LOG(info) << "[bootstrapcheck] listen request acknowledged, port " << port << ".";
+
+    uint16_t messageId = 0;
+    QByteArray payload;
+    std::map<uint32_t, std::string> strings;
+    std::map<uint32_t, uint64_t> varints;
+
+    if(!readFrame(phone, messageId, payload) || messageId != cWifiStartRequest || !parseFields(payload, strings, varints))
+    {
+        return fail("expected a start request, got message id " + std::to_string(messageId));
+    }
+
+    if(strings[1].empty() || varints[2] != port)
+    {
+        return fail("start request carries '" + strings[1] + "':" + std::to_string(varints[2]));
+    }
+
+    OPENAUTO_LOG(info) << "[bootstrapcheck] start request: " << strings[1] << ":" << varints[2] << ".";
+
+    writeFrame(phone, cWifiInfoRequest, QByteArray());
+    strings.clear();
+    varints.clear();
+
+    if(!readFrame(phone, messageId, payload) || messageId != cWifiInfoResponse || !parseFields(payload, strings, varints))
+    {
+        return fail("expected an info response, got message id " + std::to_string(messageId));
+    }
+
+    if(strings[1].empty() || strings[3].empty())
+    {
+        return fail("info response without ssid or bssid");
+    }
+
+    OPENAUTO_LOG(info) << "[bootstrapcheck] info response: ssid " << strings[1] << ", bssid " << strings[3] << ".";
+
+    QByteArray startResponse;
+    appendVarint(startResponse, (1 << 3) | 2);
+    appendVarint(startResponse, strings[1].size());
+    startResponse.append(strings[1].data(), static_cast<int>(strings[1].size()));
+    appendVarint(startResponse, 2 << 3);
+    appendVarint(startResponse, port);
+    appendVarint(startResponse, 3 << 3);
+    appendVarint(startResponse, 0);
+    writeFrame(phone, cWifiStartResponse, startResponse);
+
+    if(phone.waitForDisconnected(cQuietPeriodMs) || phone.state() != QLocalSocket::ConnectedState || autoapp.waitForNewConnection(0))
+    {
+        return fail("exchange ended on the start response, before the connection status");
+    }
+
+    QByteArray connectStatus;
+    appendVarint(connectStatus, 1 << 3);
+    appendVarint(connectStatus, 0);
+    writeFrame(phone, cWifiConnectStatus, connectStatus);
+
+    if(!readControlMessage(autoapp, control, message) || message.compare(0, 5, "done ") != 0)
+    {
+        return fail("expected done after the connection status, got '" + message + "'");
+    }
+
+    if(phone.state() != QLocalSocket::UnconnectedState && !phone.waitForDisconnected(cReplyTimeoutMs))
+    {
+        return fail("btservice kept the connection open after finishing");
+    }
+
+    OPENAUTO_LOG(info) << "[bootstrapcheck] passed, bootstrap " << message << " ms.";
+    return 0;
+}
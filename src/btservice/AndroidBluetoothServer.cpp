@@ -18,6 +18,7 @@
 
 #include <f1x/openauto/Common/Log.hpp>
 #include <f1x/openauto/btservice/AndroidBluetoothServer.hpp>
+#include <f1x/openauto/btservice/WirelessBootstrap.hpp>
 
 namespace f1x
 {
@@ -26,8 +27,12 @@ namespace openauto
 namespace btservice
 {
 
-AndroidBluetoothServer::AndroidBluetoothServer()
+AndroidBluetoothServer::AndroidBluetoothServer(IAutoappNotifier& notifier, std::string hostapdConfigFile, QString interfaceName, uint16_t wirelessPort)
     : rfcommServer_(std::make_unique<QBluetoothServer>(QBluetoothServiceInfo::RfcommProtocol, this))
+    , notifier_(notifier)
+    , hostapdConfigFile_(std::move(hostapdConfigFile))
+    , interfaceName_(std::move(interfaceName))
+    , wirelessPort_(wirelessPort)
 {
     connect(rfcommServer_.get(), &QBluetoothServer::newConnection, this, &AndroidBluetoothServer::onClientConnected);
 }
@@ -44,6 +49,21 @@ void AndroidBluetoothServer::onClientConnected()
     if(socket != nullptr)
     {
         OPENAUTO_LOG(info) << "[AndroidBluetoothServer] rfcomm client connected, peer name: " << socket->peerName().toStdString();
+
+        WirelessCredentials credentials;
+        if(!WirelessCredentials::read(hostapdConfigFile_, interfaceName_, wirelessPort_, credentials))
+        {
+            socket->close();
+            socket->deleteLater();
+            return;
+        }
+
+        auto bootstrap = new WirelessBootstrap(socket, std::move(credentials), notifier_, socket);
+        connect(bootstrap, &WirelessBootstrap::finished, socket, [socket](bool) {
+            socket->close();
+            socket->deleteLater();
+        });
+        bootstrap->start();
     }
     else
     {
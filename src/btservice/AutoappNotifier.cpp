@@ -0,0 +1,86 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QLocalSocket>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/btservice/AutoappNotifier.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace btservice
+{
+
+const int AutoappNotifier::cConnectTimeoutMs = 250;
+const int AutoappNotifier::cReplyTimeoutMs = 2000;
+
+AutoappNotifier::AutoappNotifier(const QString& serverName)
+    : serverName_(serverName)
+{
+
+}
+
+bool AutoappNotifier::notify(const std::string& message)
+{
+    QLocalSocket socket;
+    socket.connectToServer(serverName_, QIODevice::WriteOnly);
+
+    if(!socket.waitForConnected(cConnectTimeoutMs))
+    {
+        OPENAUTO_LOG(error) << "[AutoappNotifier] autoapp is not listening on " << serverName_.toStdString() << ": " << socket.errorString().toStdString();
+        return false;
+    }
+
+    socket.write(QByteArray::fromStdString(message + "\n"));
+    const bool written = socket.waitForBytesWritten(cConnectTimeoutMs);
+    socket.disconnectFromServer();
+
+    return written;
+}
+
+bool AutoappNotifier::request(const std::string& message, std::string& reply)
+{
+    QLocalSocket socket;
+    socket.connectToServer(serverName_, QIODevice::ReadWrite);
+
+    if(!socket.waitForConnected(cConnectTimeoutMs))
+    {
+        OPENAUTO_LOG(error) << "[AutoappNotifier] autoapp is not listening on " << serverName_.toStdString() << ": " << socket.errorString().toStdString();
+        return false;
+    }
+
+    socket.write(QByteArray::fromStdString(message + "\n"));
+    while(!socket.canReadLine())
+    {
+        if(!socket.waitForReadyRead(cReplyTimeoutMs))
+        {
+            OPENAUTO_LOG(error) << "[AutoappNotifier] no reply from autoapp to: " << message;
+            return false;
+        }
+    }
+
+    reply = socket.readLine().trimmed().toStdString();
+    socket.disconnectFromServer();
+
+    return true;
+}
+
+}
+}
+}
@@ -0,0 +1,78 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QLocalSocket>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/btservice/LocalBootstrapServer.hpp>
+#include <f1x/openauto/btservice/WirelessBootstrap.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace btservice
+{
+
+LocalBootstrapServer::LocalBootstrapServer(IAutoappNotifier& notifier, std::string hostapdConfigFile, QString interfaceName, uint16_t wirelessPort)
+    : localServer_(std::make_unique<QLocalServer>(this))
+    , notifier_(notifier)
+    , hostapdConfigFile_(std::move(hostapdConfigFile))
+    , interfaceName_(std::move(interfaceName))
+    , wirelessPort_(wirelessPort)
+{
+    connect(localServer_.get(), &QLocalServer::newConnection, this, &LocalBootstrapServer::onClientConnected);
+}
+
+bool LocalBootstrapServer::start(const QString& serverName)
+{
+    QLocalServer::removeServer(serverName);
+    return localServer_->listen(serverName);
+}
+
+void LocalBootstrapServer::onClientConnected()
+{
+    auto socket = localServer_->nextPendingConnection();
+
+    if(socket == nullptr)
+    {
+        OPENAUTO_LOG(error) << "[LocalBootstrapServer] received null socket during client connection.";
+        return;
+    }
+
+    OPENAUTO_LOG(info) << "[LocalBootstrapServer] local client connected.";
+
+    WirelessCredentials credentials;
+    if(!WirelessCredentials::read(hostapdConfigFile_, interfaceName_, wirelessPort_, credentials))
+    {
+        socket->close();
+        socket->deleteLater();
+        return;
+    }
+
+    auto bootstrap = new WirelessBootstrap(socket, std::move(credentials), notifier_, socket);
+    connect(bootstrap, &WirelessBootstrap::finished, socket, [socket](bool) {
+        socket->flush();
+        socket->disconnectFromServer();
+        socket->deleteLater();
+    });
+    bootstrap->start();
+}
+
+}
+}
+}
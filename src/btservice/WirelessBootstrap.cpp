@@ -0,0 +1,269 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/btservice/WirelessBootstrap.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace btservice
+{
+
+const int WirelessBootstrap::cTimeoutMs = 15000;
+const uint64_t WirelessBootstrap::cSecurityModeWpa2Personal = 8;
+const uint64_t WirelessBootstrap::cAccessPointTypeStatic = 0;
+
+WirelessBootstrap::WirelessBootstrap(QIODevice* device, WirelessCredentials credentials, IAutoappNotifier& notifier, QObject* parent)
+    : QObject(parent)
+    , device_(device)
+    , credentials_(std::move(credentials))
+    , notifier_(notifier)
+    , finished_(false)
+{
+    timeoutTimer_.setSingleShot(true);
+    connect(&timeoutTimer_, &QTimer::timeout, this, &WirelessBootstrap::onTimeout);
+    connect(device_, &QIODevice::readyRead, this, &WirelessBootstrap::onReadyRead);
+}
+
+void WirelessBootstrap::start()
+{
+    startTimestamp_ = Clock::now();
+    this->mark("rfcomm connected");
+    timeoutTimer_.start(cTimeoutMs);
+
+    std::string reply;
+    if(!notifier_.request("listen " + std::to_string(credentials_.port), reply) || reply != "listening")
+    {
+        this->finish(false, "autoapp is not listening on port " + std::to_string(credentials_.port));
+        return;
+    }
+
+    this->mark("autoapp listening");
+
+    QByteArray payload;
+    appendStringField(payload, 1, credentials_.ipAddress);
+    appendVarintField(payload, 2, credentials_.port);
+    this->sendMessage(WirelessMessageId::START_REQUEST, payload);
+    this->mark("start request sent");
+
+    this->onReadyRead();
+}
+
+void WirelessBootstrap::onReadyRead()
+{
+    buffer_.append(device_->readAll());
+
+    while(!finished_ && buffer_.size() >= 4)
+    {
+        const auto* header = reinterpret_cast<const uint8_t*>(buffer_.constData());
+        const int size = (header[0] << 8) | header[1];
+        const uint16_t messageId = (header[2] << 8) | header[3];
+
+        if(buffer_.size() < size + 4)
+        {
+            break;
+        }
+
+        const auto payload = buffer_.mid(4, size);
+        buffer_.remove(0, size + 4);
+        this->handleMessage(messageId, payload);
+    }
+}
+
+void WirelessBootstrap::onTimeout()
+{
+    this->finish(false, "timeout");
+}
+
+void WirelessBootstrap::sendMessage(WirelessMessageId messageId, const QByteArray& payload)
+{
+    const auto id = static_cast<uint16_t>(messageId);
+    QByteArray message;
+    message.append(static_cast<char>((payload.size() >> 8) & 0xFF));
+    message.append(static_cast<char>(payload.size() & 0xFF));
+    message.append(static_cast<char>((id >> 8) & 0xFF));
+    message.append(static_cast<char>(id & 0xFF));
+    message.append(payload);
+
+    device_->write(message);
+}
+
+void WirelessBootstrap::handleMessage(uint16_t messageId, const QByteArray& payload)
+{
+    switch(static_cast<WirelessMessageId>(messageId))
+    {
+    case WirelessMessageId::INFO_REQUEST:
+    {
+        this->mark("info request received");
+
+        QByteArray response;
+        appendStringField(response, 1, credentials_.ssid);
+        appendStringField(response, 2, credentials_.key);
+        appendStringField(response, 3, credentials_.bssid);
+        appendVarintField(response, 4, cSecurityModeWpa2Personal);
+        appendVarintField(response, 5, cAccessPointTypeStatic);
+        this->sendMessage(WirelessMessageId::INFO_RESPONSE, response);
+        this->mark("info response sent");
+        break;
+    }
+
+    case WirelessMessageId::START_RESPONSE:
+        this->mark("start response received");
+        break;
+
+    case WirelessMessageId::CONNECTION_STATUS:
+    {
+        this->mark("connection status received");
+
+        VarintFields fields;
+        if(!readVarintFields(payload, fields))
+        {
+            this->finish(false, "malformed connection status");
+        }
+        else if(fields[1] != 0)
+        {
+            this->finish(false, "phone reported status " + std::to_string(static_cast<int64_t>(fields[1])));
+        }
+        else
+        {
+            this->finish(true, "connected");
+        }
+        break;
+    }
+
+    default:
+        OPENAUTO_LOG(error) << "[WirelessBootstrap] unknown message id: " << messageId << ", size: " << payload.size();
+        break;
+    }
+}
+
+void WirelessBootstrap::mark(const std::string& step)
+{
+    steps_.emplace_back(step, Clock::now());
+}
+
+void WirelessBootstrap::finish(bool success, const std::string& reason)
+{
+    if(finished_)
+    {
+        return;
+    }
+
+    finished_ = true;
+    timeoutTimer_.stop();
+
+    auto previous = startTimestamp_;
+    for(const auto& step : steps_)
+    {
+        OPENAUTO_LOG(info) << "[WirelessBootstrap] " << step.first
+                           << ": +" << std::chrono::duration_cast<std::chrono::milliseconds>(step.second - previous).count()
+                           << " ms (" << std::chrono::duration_cast<std::chrono::milliseconds>(step.second - startTimestamp_).count() << " ms).";
+        previous = step.second;
+    }
+
+    const auto total = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - startTimestamp_).count();
+    OPENAUTO_LOG(info) << "[WirelessBootstrap] " << (success ? "completed" : "failed") << " (" << reason << ") after " << total << " ms.";
+
+    notifier_.notify((success ? "done " : "failed ") + std::to_string(total));
+    emit finished(success);
+}
+
+void WirelessBootstrap::appendVarint(QByteArray& buffer, uint64_t value)
+{
+    do
+    {
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        buffer.append(static_cast<char>(value != 0 ? byte | 0x80 : byte));
+    }
+    while(value != 0);
+}
+
+void WirelessBootstrap::appendVarintField(QByteArray& buffer, uint32_t field, uint64_t value)
+{
+    appendVarint(buffer, field << 3);
+    appendVarint(buffer, value);
+}
+
+void WirelessBootstrap::appendStringField(QByteArray& buffer, uint32_t field, const std::string& value)
+{
+    appendVarint(buffer, (field << 3) | 2);
+    appendVarint(buffer, value.size());
+    buffer.append(value.data(), static_cast<int>(value.size()));
+}
+
+bool WirelessBootstrap::readVarintFields(const QByteArray& payload, VarintFields& fields)
+{
+    const auto* data = reinterpret_cast<const uint8_t*>(payload.constData());
+    const int size = payload.size();
+    int offset = 0;
+
+    auto readVarint = [&](uint64_t& value) {
+        value = 0;
+        for(uint32_t shift = 0; shift < 64 && offset < size; shift += 7)
+        {
+            const uint8_t byte = data[offset++];
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if((byte & 0x80) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    while(offset < size)
+    {
+        uint64_t key = 0;
+        uint64_t value = 0;
+        if(!readVarint(key))
+        {
+            return false;
+        }
+
+        switch(key & 0x07)
+        {
+        case 0:
+            if(!readVarint(value))
+            {
+                return false;
+            }
+            fields[static_cast<uint32_t>(key >> 3)] = value;
+            break;
+
+        case 2:
+            if(!readVarint(value) || value > static_cast<uint64_t>(size - offset))
+            {
+                return false;
+            }
+            offset += static_cast<int>(value);
+            break;
+
+        default:
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
+}
+}
@@ -0,0 +1,86 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <fstream>
+#include <QNetworkInterface>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/btservice/WirelessCredentials.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace btservice
+{
+
+bool WirelessCredentials::read(const std::string& hostapdConfigFile, const QString& interfaceName, uint16_t port, WirelessCredentials& credentials)
+{
+    credentials = WirelessCredentials();
+    credentials.port = port;
+
+    std::ifstream file(hostapdConfigFile);
+    std::string line;
+    while(std::getline(file, line))
+    {
+        const auto separator = line.find('=');
+        if(separator == std::string::npos || line[0] == '#')
+        {
+            continue;
+        }
+
+        const auto key = line.substr(0, separator);
+        const auto value = line.substr(separator + 1);
+
+        if(key == "ssid")
+        {
+            credentials.ssid = value;
+        }
+        else if(key == "wpa_passphrase")
+        {
+            credentials.key = value;
+        }
+    }
+
+    const auto networkInterface = QNetworkInterface::interfaceFromName(interfaceName);
+    if(networkInterface.isValid())
+    {
+        credentials.bssid = networkInterface.hardwareAddress().toStdString();
+
+        for(const auto& entry : networkInterface.addressEntries())
+        {
+            if(entry.ip().protocol() == QAbstractSocket::IPv4Protocol)
+            {
+                credentials.ipAddress = entry.ip().toString().toStdString();
+                break;
+            }
+        }
+    }
+
+    if(credentials.ssid.empty() || credentials.ipAddress.empty())
+    {
+        OPENAUTO_LOG(error) << "[WirelessCredentials] incomplete credentials, ssid: " << credentials.ssid
+                            << ", ip: " << credentials.ipAddress << ", interface: " << interfaceName.toStdString();
+        return false;
+    }
+
+    return true;
+}
+
+}
+}
+}
@@ -16,10 +16,13 @@
 *  along with openauto. If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <cstring>
 #include <QApplication>
 #include <f1x/openauto/Common/Log.hpp>
 #include <f1x/openauto/btservice/AndroidBluetoothService.hpp>
 #include <f1x/openauto/btservice/AndroidBluetoothServer.hpp>
+#include <f1x/openauto/btservice/AutoappNotifier.hpp>
+#include <f1x/openauto/btservice/LocalBootstrapServer.hpp>
 
 namespace btservice = f1x::openauto::btservice;
 
@@ -29,8 +32,43 @@ int main(int argc, char* argv[])
 
     const QBluetoothAddress address;
     const uint16_t portNumber = 5000;
+    const uint16_t wirelessPort = 5288;
+    std::string hostapdConfigFile = "/etc/hostapd/hostapd.conf";
+    QString interfaceName = "wlan0";
+    QString localServerName;
 
-    btservice::AndroidBluetoothServer androidBluetoothServer;
+    for(int i = 1; i + 1 < argc; ++i)
+    {
+        if(std::strcmp(argv[i], "--local") == 0)
+        {
+            localServerName = argv[++i];
+        }
+        else if(std::strcmp(argv[i], "--interface") == 0)
+        {
+            interfaceName = argv[++i];
+        }
+        else if(std::strcmp(argv[i], "--hostapd") == 0)
+        {
+            hostapdConfigFile = argv[++i];
+        }
+    }
+
+    btservice::AutoappNotifier autoappNotifier("openauto_wireless");
+
+    if(!localServerName.isEmpty())
+    {
+        btservice::LocalBootstrapServer localBootstrapServer(autoappNotifier, hostapdConfigFile, interfaceName, wirelessPort);
+        if(!localBootstrapServer.start(localServerName))
+        {
+            OPENAUTO_LOG(error) << "[btservice] Local server start failed.";
+            return 2;
+        }
+
+        OPENAUTO_LOG(info) << "[btservice] Listening for local connections, name: " << localServerName.toStdString();
+        return qApplication.exec();
+    }
+
+    btservice::AndroidBluetoothServer androidBluetoothServer(autoappNotifier, hostapdConfigFile, interfaceName, wirelessPort);
     if(!androidBluetoothServer.start(address, portNumber))
     {
         OPENAUTO_LOG(error) << "[btservice] Server start failed.";
@@ -0,0 +1,290 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/autoapp/Projection/CANVehicleDataSource.hpp>
+#include <f1x/openauto/autoapp/Projection/IVehicleDataSourceEventHandler.hpp>
+
+namespace projection = f1x::openauto::autoapp::projection;
+
+typedef std::map<std::string, int64_t> Values;
+
+volatile std::sig_atomic_t interrupted = 0;
+
+class Recorder: public projection::IVehicleDataSourceEventHandler
+{
+public:
+    void onVehicleDataUpdate(const projection::VehicleData& data) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if(data.speed)
+        {
+            values_["speed"] = *data.speed;
+        }
+
+        if(data.gear)
+        {
+            values_["gear"] = *data.gear;
+        }
+
+        if(data.parkingBrake)
+        {
+            values_["parkingbrake"] = *data.parkingBrake ? 1 : 0;
+        }
+
+        if(data.headlights)
+        {
+            values_["headlights"] = *data.headlights ? 1 : 0;
+        }
+
+        std::string line;
+        for(const auto& value : values_)
+        {
+            line += " " + value.first + "=" + std::to_string(value.second);
+        }
+
+        OPENAUTO_LOG(info) << "[cancheck] update:" << line;
+        condition_.notify_all();
+    }
+
+    bool waitFor(const Values& expectations, std::chrono::milliseconds timeout, Values& observed)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        const bool matched = condition_.wait_for(lock, timeout, [this, &expectations]() {
+            for(const auto& expectation : expectations)
+            {
+                const auto value = values_.find(expectation.first);
+                if(value == values_.end() || value->second != expectation.second)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        });
+
+        observed = values_;
+        return matched;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    Values values_;
+};
+
+void printUsage(const char* name)
+{
+    std::cerr << "Usage: " << name << " --table <ini> [options]" << std::endl
+              << "  --interface <name>   CAN interface (default vcan0)" << std::endl
+              << "  --table <ini>        decoding table, as Sensor.CANDecodingTable" << std::endl
+              << "  --interval <ms>      publish interval (default 100)" << std::endl
+              << "  --send <id>#<data>   frame to send after start, cansend syntax, repeatable" << std::endl
+              << "  --expect <name>=<n>  expected value of speed, gear, parkingbrake or headlights, repeatable" << std::endl
+              << "  --timeout <ms>       time to wait for the expected values (default 2000)" << std::endl
+              << "Without --expect the decoded updates are printed until interrupted, so frames can come from cansend or cangen." << std::endl;
+}
+
+bool parseFrame(const std::string& text, struct can_frame& frame)
+{
+    const auto separator = text.find('#');
+    if(separator == std::string::npos || separator == 0 || (text.size() - separator - 1) % 2 != 0 || (text.size() - separator - 1) / 2 > CAN_MAX_DLEN)
+    {
+        return false;
+    }
+
+    std::memset(&frame, 0, sizeof(frame));
+    try
+    {
+        frame.can_id = static_cast<canid_t>(std::stoul(text.substr(0, separator), nullptr, 16));
+        if(separator > 3)
+        {
+            frame.can_id |= CAN_EFF_FLAG;
+        }
+
+        for(size_t i = separator + 1; i < text.size(); i += 2)
+        {
+            frame.data[frame.can_dlc++] = static_cast<uint8_t>(std::stoul(text.substr(i, 2), nullptr, 16));
+        }
+    }
+    catch(const std::exception&)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool sendFrames(const std::string& interfaceName, const std::vector<struct can_frame>& frames)
+{
+    const int canSocket = ::socket(PF_CAN, SOCK_RAW | SOCK_CLOEXEC, CAN_RAW);
+
+    struct ifreq ifr = {};
+    std::strncpy(ifr.ifr_name, interfaceName.c_str(), IFNAMSIZ - 1);
+
+    struct sockaddr_can address = {};
+    address.can_family = AF_CAN;
+
+    if(canSocket < 0 || ::ioctl(canSocket, SIOCGIFINDEX, &ifr) < 0)
+    {
+        OPENAUTO_LOG(error) << "[cancheck] cannot open interface " << interfaceName << ", errno: " << errno;
+        return false;
+    }
+
+    address.can_ifindex = ifr.ifr_ifindex;
+    if(::bind(canSocket, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) < 0)
+    {
+        OPENAUTO_LOG(error) << "[cancheck] cannot bind to " << interfaceName << ", errno: " << errno;
+        ::close(canSocket);
+        return false;
+    }
+
+    bool sent = true;
+    for(const auto& frame : frames)
+    {
+        sent = ::write(canSocket, &frame, sizeof(frame)) == sizeof(frame) && sent;
+    }
+
+    ::close(canSocket);
+    return sent;
+}
+
+int main(int argc, char* argv[])
+{
+    std::string interfaceName = "vcan0";
+    std::string decodingTable;
+    size_t interval = 100;
+    size_t timeout = 2000;
+    std::vector<struct can_frame> frames;
+    Values expectations;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        const bool hasValue = i + 1 < argc;
+
+        if(hasValue && std::strcmp(argv[i], "--interface") == 0)
+        {
+            interfaceName = argv[++i];
+        }
+        else if(hasValue && std::strcmp(argv[i], "--table") == 0)
+        {
+            decodingTable = argv[++i];
+        }
+        else if(hasValue && std::strcmp(argv[i], "--interval") == 0)
+        {
+            interval = std::stoul(argv[++i]);
+        }
+        else if(hasValue && std::strcmp(argv[i], "--timeout") == 0)
+        {
+            timeout = std::stoul(argv[++i]);
+        }
+        else if(hasValue && std::strcmp(argv[i], "--send") == 0)
+        {
+            struct can_frame frame;
+            if(!parseFrame(argv[++i], frame))
+            {
+                std::cerr << "Invalid frame: " << argv[i] << std::endl;
+                return 1;
+            }
+            frames.push_back(frame);
+        }
+        else if(hasValue && std::strcmp(argv[i], "--expect") == 0)
+        {
+            const std::string expectation = argv[++i];
+            const auto separator = expectation.find('=');
+            if(separator == std::string::npos)
+            {
+                std::cerr << "Invalid expectation: " << expectation << std::endl;
+                return 1;
+            }
+            expectations[expectation.substr(0, separator)] = std::stoll(expectation.substr(separator + 1));
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if(decodingTable.empty())
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    projection::CANVehicleDataSource source(interfaceName, decodingTable, std::chrono::milliseconds(interval));
+    Recorder recorder;
+    source.start(recorder);
+
+    if(!frames.empty() && !sendFrames(interfaceName, frames))
+    {
+        source.stop();
+        return 1;
+    }
+
+    if(expectations.empty())
+    {
+        std::signal(SIGINT, [](int) { interrupted = 1; });
+        std::signal(SIGTERM, [](int) { interrupted = 1; });
+        while(!interrupted)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+
+        source.stop();
+        return 0;
+    }
+
+    Values observed;
+    const bool matched = recorder.waitFor(expectations, std::chrono::milliseconds(timeout), observed);
+    source.stop();
+
+    for(const auto& expectation : expectations)
+    {
+        const auto value = observed.find(expectation.first);
+        const std::string actual = value != observed.end() ? std::to_string(value->second) : std::string("nothing");
+
+        if(value != observed.end() && value->second == expectation.second)
+        {
+            OPENAUTO_LOG(info) << "[cancheck] " << expectation.first << ": " << actual;
+        }
+        else
+        {
+            OPENAUTO_LOG(error) << "[cancheck] " << expectation.first << ": expected " << expectation.second << ", got " << actual;
+        }
+    }
+
+    OPENAUTO_LOG(info) << "[cancheck] " << (matched ? "passed" : "FAILED");
+    return matched ? 0 : 1;
+}
@@ -0,0 +1,525 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <poll.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <openssl/err.h>
+#include <aasdk_proto/ControlMessageIdsEnum.pb.h>
+#include <aasdk_proto/AVChannelMessageIdsEnum.pb.h>
+#include <aasdk_proto/VersionResponseStatusEnum.pb.h>
+#include <aasdk_proto/PingRequestMessage.pb.h>
+#include <aasdk_proto/PingResponseMessage.pb.h>
+#include <f1x/aasdk/Messenger/ChannelId.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/fakephone/FakePhone.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace fakephone
+{
+
+const size_t FakePhone::cMaxFramePayloadSize = 0x4000;
+
+FakePhone::FakePhone(const std::string& certificateFile, const std::string& privateKeyFile)
+    : certificateFile_(certificateFile)
+    , privateKeyFile_(privateKeyFile)
+    , listenSocket_(-1)
+    , socket_(-1)
+    , context_(nullptr)
+    , ssl_(nullptr)
+    , readBio_(nullptr)
+    , writeBio_(nullptr)
+    , messagesSent_(0)
+    , bytesSent_(0)
+    , messagesReceived_(0)
+    , acksReceived_(0)
+    , pingsAnswered_(0)
+    , ackLatencyTotal_(0)
+    , ackLatencyMax_(0)
+{
+    SSL_library_init();
+    SSL_load_error_strings();
+}
+
+FakePhone::~FakePhone()
+{
+    this->close();
+
+    if(listenSocket_ >= 0)
+    {
+        ::close(listenSocket_);
+    }
+
+    if(context_ != nullptr)
+    {
+        SSL_CTX_free(context_);
+    }
+}
+
+bool FakePhone::listen(uint16_t port)
+{
+    listenSocket_ = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if(listenSocket_ < 0)
+    {
+        return false;
+    }
+
+    int reuse = 1;
+    ::setsockopt(listenSocket_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    struct sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+
+    if(::bind(listenSocket_, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) < 0 || ::listen(listenSocket_, 1) < 0)
+    {
+        OPENAUTO_LOG(error) << "[FakePhone] cannot listen on port: " << port << ", errno: " << errno;
+        return false;
+    }
+
+    OPENAUTO_LOG(info) << "[FakePhone] listening on port: " << port;
+    return this->initSSL();
+}
+
+bool FakePhone::accept()
+{
+    socket_ = ::accept4(listenSocket_, nullptr, nullptr, SOCK_CLOEXEC);
+    if(socket_ < 0)
+    {
+        return false;
+    }
+
+    int noDelay = 1;
+    ::setsockopt(socket_, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+    ssl_ = SSL_new(context_);
+    readBio_ = BIO_new(BIO_s_mem());
+    writeBio_ = BIO_new(BIO_s_mem());
+    SSL_set_bio(ssl_, readBio_, writeBio_);
+    SSL_set_accept_state(ssl_);
+
+    OPENAUTO_LOG(info) << "[FakePhone] head unit connected.";
+    return true;
+}
+
+bool FakePhone::handshake()
+{
+    const auto start = Clock::now();
+    Message message;
+
+    while(this->receiveMessage(message))
+    {
+        const auto messageId = getMessageId(message.payload);
+
+        if(messageId == aasdk::proto::ids::ControlMessage::VERSION_REQUEST)
+        {
+            const uint8_t response[] = {0, 1, 0, 1, 0, aasdk::proto::enums::VersionResponseStatus::MATCH};
+            this->sendMessage(0, false, false, createPayload(aasdk::proto::ids::ControlMessage::VERSION_RESPONSE, response, sizeof(response)));
+        }
+        else if(messageId == aasdk::proto::ids::ControlMessage::SSL_HANDSHAKE)
+        {
+            BIO_write(readBio_, message.payload.data() + 2, message.payload.size() - 2);
+            SSL_do_handshake(ssl_);
+
+            if(!this->sendHandshakeData())
+            {
+                return false;
+            }
+        }
+        else if(messageId == aasdk::proto::ids::ControlMessage::AUTH_COMPLETE)
+        {
+            OPENAUTO_LOG(info) << "[FakePhone] handshake completed in "
+                               << std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count() << "ms.";
+            return SSL_is_init_finished(ssl_);
+        }
+    }
+
+    return false;
+}
+
+void FakePhone::replay(const Entries& entries, double speed)
+{
+    if(entries.empty())
+    {
+        return;
+    }
+
+    OPENAUTO_LOG(info) << "[FakePhone] replaying " << entries.size() << " messages, speed: " << (speed > 0 ? std::to_string(speed) + "x" : "flat-out");
+
+    const auto start = Clock::now();
+    const auto firstTimestamp = entries.front().timestamp;
+
+    for(const auto& entry : entries)
+    {
+        if(!this->isReplayed(entry))
+        {
+            continue;
+        }
+
+        const auto offset = std::chrono::microseconds(speed > 0 ? static_cast<int64_t>((entry.timestamp - firstTimestamp) / speed) : 0);
+        if(!this->processIncoming(start + offset) || !this->sendMessage(entry.channelId, entry.encrypted, entry.control, entry.payload))
+        {
+            OPENAUTO_LOG(error) << "[FakePhone] connection lost during replay.";
+            break;
+        }
+
+        const auto messageId = getMessageId(entry.payload);
+        if(!entry.control && (messageId == aasdk::proto::ids::AVChannelMessage::AV_MEDIA_WITH_TIMESTAMP_INDICATION || messageId == aasdk::proto::ids::AVChannelMessage::AV_MEDIA_INDICATION))
+        {
+            pendingAcks_[entry.channelId].push_back(Clock::now());
+        }
+    }
+
+    const auto elapsed = Clock::now() - start;
+    const auto drainDeadline = Clock::now() + std::chrono::seconds(2);
+    while(Clock::now() < drainDeadline && std::any_of(pendingAcks_.begin(), pendingAcks_.end(), [](const auto& acks) { return !acks.second.empty(); }))
+    {
+        if(!this->processIncoming(std::min(drainDeadline, Clock::now() + std::chrono::milliseconds(100))))
+        {
+            break;
+        }
+    }
+
+    this->report(elapsed);
+}
+
+void FakePhone::close()
+{
+    if(ssl_ != nullptr)
+    {
+        SSL_free(ssl_);
+        ssl_ = nullptr;
+        readBio_ = nullptr;
+        writeBio_ = nullptr;
+    }
+
+    if(socket_ >= 0)
+    {
+        ::close(socket_);
+        socket_ = -1;
+    }
+}
+
+bool FakePhone::initSSL()
+{
+    context_ = SSL_CTX_new(TLS_server_method());
+
+    if(context_ == nullptr ||
+       SSL_CTX_set_max_proto_version(context_, TLS1_2_VERSION) != 1 ||
+       SSL_CTX_use_certificate_file(context_, certificateFile_.c_str(), SSL_FILETYPE_PEM) != 1 ||
+       SSL_CTX_use_PrivateKey_file(context_, privateKeyFile_.c_str(), SSL_FILETYPE_PEM) != 1)
+    {
+        OPENAUTO_LOG(error) << "[FakePhone] cannot load certificate: " << certificateFile_ << ", key: " << privateKeyFile_
+                            << ", error: " << ERR_error_string(ERR_get_error(), nullptr);
+        return false;
+    }
+
+    return true;
+}
+
+bool FakePhone::sendMessage(uint8_t channelId, bool encrypted, bool control, const std::vector<uint8_t>& payload)
+{
+    size_t offset = 0;
+
+    do
+    {
+        const size_t chunkSize = std::min(cMaxFramePayloadSize, payload.size() - offset);
+        const bool first = offset == 0;
+        const bool last = offset + chunkSize == payload.size();
+
+        std::vector<uint8_t> framePayload;
+        if(encrypted)
+        {
+            if(!this->encrypt(payload.data() + offset, chunkSize, framePayload))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            framePayload.assign(payload.begin() + offset, payload.begin() + offset + chunkSize);
+        }
+
+        const uint8_t frameType = (first ? 1 : 0) | (last ? 2 : 0);
+        std::vector<uint8_t> frame = {channelId, static_cast<uint8_t>(frameType | (control ? 4 : 0) | (encrypted ? 8 : 0)),
+                                      static_cast<uint8_t>(framePayload.size() >> 8), static_cast<uint8_t>(framePayload.size())};
+
+        if(first && !last)
+        {
+            const uint32_t totalSize = payload.size();
+            frame.insert(frame.end(), {static_cast<uint8_t>(totalSize >> 24), static_cast<uint8_t>(totalSize >> 16),
+                                       static_cast<uint8_t>(totalSize >> 8), static_cast<uint8_t>(totalSize)});
+        }
+
+        frame.insert(frame.end(), framePayload.begin(), framePayload.end());
+        if(!this->writeAll(frame.data(), frame.size()))
+        {
+            return false;
+        }
+
+        bytesSent_ += frame.size();
+        offset += chunkSize;
+    }
+    while(offset < payload.size());
+
+    ++messagesSent_;
+    return true;
+}
+
+bool FakePhone::sendHandshakeData()
+{
+    std::vector<uint8_t> data(BIO_ctrl_pending(writeBio_));
+    if(data.empty())
+    {
+        return true;
+    }
+
+    BIO_read(writeBio_, data.data(), data.size());
+    return this->sendMessage(0, false, false, createPayload(aasdk::proto::ids::ControlMessage::SSL_HANDSHAKE, data.data(), data.size()));
+}
+
+bool FakePhone::receiveMessage(Message& message)
+{
+    message.payload.clear();
+
+    while(true)
+    {
+        uint8_t header[2];
+        uint8_t size[2];
+        if(!this->readAll(header, sizeof(header)) || !this->readAll(size, sizeof(size)))
+        {
+            return false;
+        }
+
+        const uint8_t frameType = header[1] & 3;
+        if(frameType == 1)
+        {
+            uint8_t totalSize[4];
+            if(!this->readAll(totalSize, sizeof(totalSize)))
+            {
+                return false;
+            }
+        }
+
+        std::vector<uint8_t> framePayload((size[0] << 8) | size[1]);
+        if(!this->readAll(framePayload.data(), framePayload.size()))
+        {
+            return false;
+        }
+
+        message.channelId = header[0];
+        message.control = (header[1] & 4) != 0;
+        message.encrypted = (header[1] & 8) != 0;
+
+        if(message.encrypted)
+        {
+            if(!this->decrypt(framePayload, message.payload))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            message.payload.insert(message.payload.end(), framePayload.begin(), framePayload.end());
+        }
+
+        if(frameType == 2 || frameType == 3)
+        {
+            ++messagesReceived_;
+            return true;
+        }
+    }
+}
+
+bool FakePhone::handleMessage(const Message& message)
+{
+    const auto messageId = getMessageId(message.payload);
+
+    if(message.channelId == static_cast<uint8_t>(aasdk::messenger::ChannelId::CONTROL) && messageId == aasdk::proto::ids::ControlMessage::PING_REQUEST)
+    {
+        aasdk::proto::messages::PingRequest request;
+        request.ParseFromArray(message.payload.data() + 2, message.payload.size() - 2);
+
+        aasdk::proto::messages::PingResponse response;
+        response.set_timestamp(request.timestamp());
+
+        const auto data = response.SerializeAsString();
+        ++pingsAnswered_;
+        return this->sendMessage(message.channelId, true, false, createPayload(aasdk::proto::ids::ControlMessage::PING_RESPONSE, reinterpret_cast<const uint8_t*>(data.data()), data.size()));
+    }
+    else if(!message.control && messageId == aasdk::proto::ids::AVChannelMessage::AV_MEDIA_ACK_INDICATION)
+    {
+        auto& acks = pendingAcks_[message.channelId];
+        if(!acks.empty())
+        {
+            const auto latency = Clock::now() - acks.front();
+            acks.pop_front();
+            ++acksReceived_;
+            ackLatencyTotal_ += latency;
+            ackLatencyMax_ = std::max(ackLatencyMax_, latency);
+        }
+    }
+
+    return true;
+}
+
+bool FakePhone::processIncoming(Clock::time_point deadline)
+{
+    do
+    {
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+        struct pollfd fd = {socket_, POLLIN, 0};
+
+        const int result = ::poll(&fd, 1, std::max<int>(0, remaining));
+        if(result < 0 && errno != EINTR)
+        {
+            return false;
+        }
+
+        if(result > 0)
+        {
+            Message message;
+            if(!this->receiveMessage(message) || !this->handleMessage(message))
+            {
+                return false;
+            }
+        }
+    }
+    while(Clock::now() < deadline);
+
+    return true;
+}
+
+bool FakePhone::encrypt(const uint8_t* data, size_t size, std::vector<uint8_t>& output)
+{
+    if(SSL_write(ssl_, data, size) <= 0)
+    {
+        OPENAUTO_LOG(error) << "[FakePhone] encryption failed.";
+        return false;
+    }
+
+    output.resize(BIO_ctrl_pending(writeBio_));
+    BIO_read(writeBio_, output.data(), output.size());
+    return true;
+}
+
+bool FakePhone::decrypt(const std::vector<uint8_t>& data, std::vector<uint8_t>& output)
+{
+    BIO_write(readBio_, data.data(), data.size());
+
+    uint8_t buffer[cMaxFramePayloadSize];
+    int size = 0;
+    while((size = SSL_read(ssl_, buffer, sizeof(buffer))) > 0)
+    {
+        output.insert(output.end(), buffer, buffer + size);
+    }
+
+    return SSL_get_error(ssl_, size) == SSL_ERROR_WANT_READ;
+}
+
+bool FakePhone::writeAll(const uint8_t* data, size_t size)
+{
+    while(size > 0)
+    {
+        const auto written = ::send(socket_, data, size, MSG_NOSIGNAL);
+        if(written <= 0)
+        {
+            return false;
+        }
+
+        data += written;
+        size -= written;
+    }
+
+    return true;
+}
+
+bool FakePhone::readAll(uint8_t* data, size_t size)
+{
+    while(size > 0)
+    {
+        const auto received = ::recv(socket_, data, size, 0);
+        if(received <= 0)
+        {
+            return false;
+        }
+
+        data += received;
+        size -= received;
+    }
+
+    return true;
+}
+
+bool FakePhone::isReplayed(const common::SessionRecordEntry& entry) const
+{
+    if(entry.direction != common::SessionRecordDirection::FROM_PHONE)
+    {
+        return false;
+    }
+
+    if(entry.channelId != static_cast<uint8_t>(aasdk::messenger::ChannelId::CONTROL) || entry.control)
+    {
+        return true;
+    }
+
+    const auto messageId = getMessageId(entry.payload);
+    return messageId != aasdk::proto::ids::ControlMessage::VERSION_RESPONSE &&
+           messageId != aasdk::proto::ids::ControlMessage::SSL_HANDSHAKE &&
+           messageId != aasdk::proto::ids::ControlMessage::PING_RESPONSE;
+}
+
+void FakePhone::report(Clock::duration elapsed) const
+{
+    const auto elapsedMs = std::max<int64_t>(1, std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+    const auto averageAckLatency = acksReceived_ > 0 ? std::chrono::duration_cast<std::chrono::microseconds>(ackLatencyTotal_).count() / acksReceived_ : 0;
+
+    OPENAUTO_LOG(info) << "[FakePhone] replay finished in " << elapsedMs << "ms"
+                       << ", messages sent: " << messagesSent_
+                       << ", bytes sent: " << bytesSent_
+                       << ", throughput: " << (bytesSent_ * 1000 / elapsedMs) / 1024 << " KiB/s"
+                       << ", messages received: " << messagesReceived_
+                       << ", pings answered: " << pingsAnswered_;
+
+    OPENAUTO_LOG(info) << "[FakePhone] media acks: " << acksReceived_
+                       << ", average latency: " << averageAckLatency << "us"
+                       << ", max latency: " << std::chrono::duration_cast<std::chrono::microseconds>(ackLatencyMax_).count() << "us";
+}
+
+uint16_t FakePhone::getMessageId(const std::vector<uint8_t>& payload)
+{
+    return payload.size() >= 2 ? (payload[0] << 8) | payload[1] : 0;
+}
+
+std::vector<uint8_t> FakePhone::createPayload(uint16_t messageId, const uint8_t* data, size_t size)
+{
+    std::vector<uint8_t> payload = {static_cast<uint8_t>(messageId >> 8), static_cast<uint8_t>(messageId)};
+    payload.insert(payload.end(), data, data + size);
+    return payload;
+}
+
+}
+}
+}
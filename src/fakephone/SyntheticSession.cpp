@@ -0,0 +1,96 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <aasdk_proto/ControlMessageIdsEnum.pb.h>
+#include <aasdk_proto/AVChannelMessageIdsEnum.pb.h>
+#include <aasdk_proto/ServiceDiscoveryRequestMessage.pb.h>
+#include <aasdk_proto/ChannelOpenRequestMessage.pb.h>
+#include <aasdk_proto/AVChannelSetupRequestMessage.pb.h>
+#include <aasdk_proto/AVChannelStartIndicationMessage.pb.h>
+#include <f1x/aasdk/Messenger/ChannelId.hpp>
+#include <f1x/openauto/fakephone/SyntheticSession.hpp>
+
+namespace f1x
+{
+namespace openauto
+{
+namespace fakephone
+{
+
+SyntheticSession::Entries SyntheticSession::create(size_t fps, size_t frameSize, size_t duration)
+{
+    Entries entries;
+    const auto videoChannelId = static_cast<uint8_t>(aasdk::messenger::ChannelId::VIDEO);
+
+    aasdk::proto::messages::ServiceDiscoveryRequest serviceDiscoveryRequest;
+    serviceDiscoveryRequest.set_device_name("fakephone");
+    serviceDiscoveryRequest.set_device_brand("openauto");
+    append(entries, 0, static_cast<uint8_t>(aasdk::messenger::ChannelId::CONTROL), false,
+           aasdk::proto::ids::ControlMessage::SERVICE_DISCOVERY_REQUEST, serviceDiscoveryRequest.SerializeAsString());
+
+    aasdk::proto::messages::ChannelOpenRequest channelOpenRequest;
+    channelOpenRequest.set_priority(0);
+    channelOpenRequest.set_channel_id(videoChannelId);
+    append(entries, 100000, videoChannelId, true, aasdk::proto::ids::ControlMessage::CHANNEL_OPEN_REQUEST, channelOpenRequest.SerializeAsString());
+
+    aasdk::proto::messages::AVChannelSetupRequest setupRequest;
+    setupRequest.set_config_index(0);
+    append(entries, 200000, videoChannelId, false, aasdk::proto::ids::AVChannelMessage::SETUP_REQUEST, setupRequest.SerializeAsString());
+
+    aasdk::proto::messages::AVChannelStartIndication startIndication;
+    startIndication.set_session(0);
+    startIndication.set_config(0);
+    append(entries, 300000, videoChannelId, false, aasdk::proto::ids::AVChannelMessage::START_INDICATION, startIndication.SerializeAsString());
+
+    std::string frame(std::max<size_t>(frameSize, 8 + 6), '\xFF');
+    const char fillerUnit[] = {0, 0, 0, 1, 0x0C};
+    const uint64_t frameInterval = 1000000 / std::max<size_t>(fps, 1);
+    const uint64_t framesCount = duration * std::max<size_t>(fps, 1);
+
+    for(uint64_t i = 0; i < framesCount; ++i)
+    {
+        const uint64_t timestamp = 400000 + i * frameInterval;
+        for(size_t byte = 0; byte < 8; ++byte)
+        {
+            frame[byte] = static_cast<char>(timestamp >> (56 - byte * 8));
+        }
+
+        frame.replace(8, sizeof(fillerUnit), fillerUnit, sizeof(fillerUnit));
+        frame.back() = '\x80';
+        append(entries, timestamp, videoChannelId, false, aasdk::proto::ids::AVChannelMessage::AV_MEDIA_WITH_TIMESTAMP_INDICATION, frame);
+    }
+
+    return entries;
+}
+
+void SyntheticSession::append(Entries& entries, uint64_t timestamp, uint8_t channelId, bool control, uint16_t messageId, const std::string& message)
+{
+    common::SessionRecordEntry entry;
+    entry.timestamp = timestamp;
+    entry.direction = common::SessionRecordDirection::FROM_PHONE;
+    entry.channelId = channelId;
+    entry.encrypted = true;
+    entry.control = control;
+    entry.payload = {static_cast<uint8_t>(messageId >> 8), static_cast<uint8_t>(messageId)};
+    entry.payload.insert(entry.payload.end(), message.begin(), message.end());
+    entries.push_back(std::move(entry));
+}
+
+}
+}
+}
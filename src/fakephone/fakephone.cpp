@@ -0,0 +1,149 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/fakephone/FakePhone.hpp>
+#include <f1x/openauto/fakephone/SyntheticSession.hpp>
+
+namespace fakephone = f1x::openauto::fakephone;
+namespace common = f1x::openauto::common;
+
+void printUsage(const char* name)
+{
+    std::cerr << "Usage: " << name << " --cert <file> --key <file> (--replay <file> | --synthetic) [options]" << std::endl
+              << "  --port <port>         listening port (default 5277)" << std::endl
+              << "  --speed <factor>      replay speed, 1 = real time, 0 = flat-out (default 1)" << std::endl
+              << "  --fps <fps>           synthetic video frame rate (default 30)" << std::endl
+              << "  --frame-size <bytes>  synthetic video frame size (default 20000)" << std::endl
+              << "  --duration <seconds>  synthetic stream duration (default 10)" << std::endl;
+}
+
+bool readRecording(const std::string& fileName, fakephone::FakePhone::Entries& entries)
+{
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+    common::SessionRecordReader reader(file);
+    if(!reader.isValid())
+    {
+        return false;
+    }
+
+    common::SessionRecordEntry entry;
+    while(reader.read(entry))
+    {
+        entries.push_back(entry);
+    }
+
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    std::string certificateFile;
+    std::string privateKeyFile;
+    std::string recordingFile;
+    bool synthetic = false;
+    uint16_t port = 5277;
+    double speed = 1;
+    size_t fps = 30;
+    size_t frameSize = 20000;
+    size_t duration = 10;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        const bool hasValue = i + 1 < argc;
+
+        if(std::strcmp(argv[i], "--synthetic") == 0)
+        {
+            synthetic = true;
+        }
+        else if(hasValue && std::strcmp(argv[i], "--cert") == 0)
+        {
+            certificateFile = argv[++i];
+        }
+        else if(hasValue && std::strcmp(argv[i], "--key") == 0)
+        {
+            privateKeyFile = argv[++i];
+        }
+        else if(hasValue && std::strcmp(argv[i], "--replay") == 0)
+        {
+            recordingFile = argv[++i];
+        }
+        else if(hasValue && std::strcmp(argv[i], "--port") == 0)
+        {
+            port = std::stoi(argv[++i]);
+        }
+        else if(hasValue && std::strcmp(argv[i], "--speed") == 0)
+        {
+            speed = std::stod(argv[++i]);
+        }
+        else if(hasValue && std::strcmp(argv[i], "--fps") == 0)
+        {
+            fps = std::stoul(argv[++i]);
+        }
+        else if(hasValue && std::strcmp(argv[i], "--frame-size") == 0)
+        {
+            frameSize = std::stoul(argv[++i]);
+        }
+        else if(hasValue && std::strcmp(argv[i], "--duration") == 0)
+        {
+            duration = std::stoul(argv[++i]);
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if(certificateFile.empty() || privateKeyFile.empty() || (recordingFile.empty() == !synthetic))
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    fakephone::FakePhone::Entries entries;
+    if(synthetic)
+    {
+        entries = fakephone::SyntheticSession::create(fps, frameSize, duration);
+    }
+    else if(!readRecording(recordingFile, entries))
+    {
+        OPENAUTO_LOG(error) << "[fakephone] invalid recording: " << recordingFile;
+        return 2;
+    }
+
+    fakephone::FakePhone fakePhone(certificateFile, privateKeyFile);
+    if(!fakePhone.listen(port))
+    {
+        return 3;
+    }
+
+    if(!fakePhone.accept() || !fakePhone.handshake())
+    {
+        OPENAUTO_LOG(error) << "[fakephone] handshake failed.";
+        return 4;
+    }
+
+    fakePhone.replay(entries, speed);
+    fakePhone.close();
+
+    return 0;
+}
@@ -0,0 +1,248 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <f1x/openauto/Common/HelperProtocol.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/helperd/HelperServer.hpp>
+
+extern char** environ;
+
+namespace f1x
+{
+namespace openauto
+{
+namespace helperd
+{
+
+HelperServer::HelperServer(boost::asio::io_service& ioService, std::string socketPath)
+    : ioService_(ioService)
+    , socketPath_(std::move(socketPath))
+    , acceptor_(ioService_)
+    , childSignal_(ioService_, SIGCHLD)
+    , sessions_(0)
+{
+
+}
+
+bool HelperServer::start()
+{
+    boost::system::error_code ec;
+    boost::asio::local::stream_protocol::socket probe(ioService_);
+    probe.connect(boost::asio::local::stream_protocol::endpoint(socketPath_), ec);
+    if(!ec)
+    {
+        OPENAUTO_LOG(error) << "[HelperServer] Another helper is already listening on " << socketPath_ << ".";
+        return false;
+    }
+
+    ::unlink(socketPath_.c_str());
+
+    acceptor_.open(boost::asio::local::stream_protocol(), ec);
+    if(!ec)
+    {
+        acceptor_.bind(boost::asio::local::stream_protocol::endpoint(socketPath_), ec);
+    }
+
+    if(!ec)
+    {
+        acceptor_.listen(boost::asio::socket_base::max_connections, ec);
+    }
+
+    if(ec)
+    {
+        OPENAUTO_LOG(error) << "[HelperServer] Cannot listen on " << socketPath_ << ": " << ec.message();
+        return false;
+    }
+
+    ::fcntl(acceptor_.native_handle(), F_SETFD, FD_CLOEXEC);
+    OPENAUTO_LOG(info) << "[HelperServer] Listening on " << socketPath_ << ".";
+
+    this->accept();
+    this->waitChildren();
+    return true;
+}
+
+void HelperServer::stop()
+{
+    boost::system::error_code ec;
+    acceptor_.close(ec);
+    childSignal_.cancel(ec);
+    ::unlink(socketPath_.c_str());
+}
+
+void HelperServer::accept()
+{
+    auto session = std::make_shared<Session>(*this, ioService_);
+    acceptor_.async_accept(session->getSocket(), [this, session](const boost::system::error_code& ec) {
+        if(ec == boost::asio::error::operation_aborted)
+        {
+            return;
+        }
+
+        if(!ec)
+        {
+            ::fcntl(session->getSocket().native_handle(), F_SETFD, FD_CLOEXEC);
+            OPENAUTO_LOG(info) << "[HelperServer] Client connected, sessions: " << ++sessions_ << ".";
+            session->start();
+        }
+
+        this->accept();
+    });
+}
+
+void HelperServer::waitChildren()
+{
+    childSignal_.async_wait([this](const boost::system::error_code& ec, int) {
+        if(ec)
+        {
+            return;
+        }
+
+        int status = 0;
+        pid_t pid;
+        while((pid = ::waitpid(-1, &status, WNOHANG)) > 0)
+        {
+            auto it = children_.find(pid);
+            if(it == children_.end())
+            {
+                continue;
+            }
+
+            const int exitStatus = WIFEXITED(status) ? WEXITSTATUS(status) : common::cHelperFailedStatus;
+            OPENAUTO_LOG(debug) << "[HelperServer] " << it->second.command << " finished, status: " << exitStatus << ".";
+
+            if(auto session = it->second.session.lock())
+            {
+                session->send(it->second.id, exitStatus);
+            }
+
+            children_.erase(it);
+        }
+
+        this->waitChildren();
+    });
+}
+
+void HelperServer::execute(std::shared_ptr<Session> session, uint32_t id, const std::string& command)
+{
+    const char* argv[] = {"/bin/sh", "-c", command.c_str(), nullptr};
+
+    pid_t pid = 0;
+    const int result = ::posix_spawn(&pid, "/bin/sh", nullptr, nullptr, const_cast<char* const*>(argv), environ);
+    if(result != 0)
+    {
+        OPENAUTO_LOG(error) << "[HelperServer] Cannot spawn " << command << ", error: " << result << ".";
+        session->send(id, common::cHelperFailedStatus);
+        return;
+    }
+
+    OPENAUTO_LOG(debug) << "[HelperServer] Started " << command << ", pid: " << pid << ".";
+    children_[pid] = Child{session, id, command};
+}
+
+HelperServer::Session::Session(HelperServer& server, boost::asio::io_service& ioService)
+    : server_(server)
+    , socket_(ioService)
+{
+
+}
+
+boost::asio::local::stream_protocol::socket& HelperServer::Session::getSocket()
+{
+    return socket_;
+}
+
+void HelperServer::Session::start()
+{
+    this->read();
+}
+
+void HelperServer::Session::send(uint32_t id, int status)
+{
+    const bool idle = writeQueue_.empty();
+    writeQueue_.push_back(common::HelperProtocol::encode(id, std::to_string(status)));
+
+    if(idle)
+    {
+        this->write();
+    }
+}
+
+void HelperServer::Session::close()
+{
+    boost::system::error_code ec;
+    socket_.close(ec);
+}
+
+void HelperServer::Session::read()
+{
+    auto self = this->shared_from_this();
+    boost::asio::async_read_until(socket_, buffer_, '\n', [this, self](const boost::system::error_code& ec, size_t) {
+        if(ec)
+        {
+            OPENAUTO_LOG(info) << "[HelperServer] Client disconnected, sessions: " << --server_.sessions_ << ".";
+            this->close();
+            return;
+        }
+
+        std::istream stream(&buffer_);
+        std::string line;
+        std::getline(stream, line);
+
+        uint32_t id = 0;
+        std::string command;
+        if(common::HelperProtocol::decode(line, id, command) && !command.empty())
+        {
+            server_.execute(self, id, command);
+        }
+        else
+        {
+            OPENAUTO_LOG(warning) << "[HelperServer] Malformed request: " << line;
+        }
+
+        this->read();
+    });
+}
+
+void HelperServer::Session::write()
+{
+    auto self = this->shared_from_this();
+    boost::asio::async_write(socket_, boost::asio::buffer(writeQueue_.front()), [this, self](const boost::system::error_code& ec, size_t) {
+        if(ec)
+        {
+            writeQueue_.clear();
+            this->close();
+            return;
+        }
+
+        writeQueue_.pop_front();
+        if(!writeQueue_.empty())
+        {
+            this->write();
+        }
+    });
+}
+
+}
+}
+}
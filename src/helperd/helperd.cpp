@@ -0,0 +1,96 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <dirent.h>
+#include <signal.h>
+#include <unistd.h>
+#include <boost/asio.hpp>
+#include <f1x/openauto/Common/HelperProtocol.hpp>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/helperd/HelperServer.hpp>
+
+namespace common = f1x::openauto::common;
+namespace helperd = f1x::openauto::helperd;
+
+void closeInheritedDescriptors()
+{
+    std::vector<int> descriptors;
+
+    if(auto directory = ::opendir("/proc/self/fd"))
+    {
+        while(auto entry = ::readdir(directory))
+        {
+            const int descriptor = std::atoi(entry->d_name);
+            if(descriptor > STDERR_FILENO && descriptor != ::dirfd(directory))
+            {
+                descriptors.push_back(descriptor);
+            }
+        }
+
+        ::closedir(directory);
+    }
+    else
+    {
+        for(long descriptor = STDERR_FILENO + 1; descriptor < ::sysconf(_SC_OPEN_MAX); ++descriptor)
+        {
+            descriptors.push_back(static_cast<int>(descriptor));
+        }
+    }
+
+    for(const auto descriptor : descriptors)
+    {
+        ::close(descriptor);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    closeInheritedDescriptors();
+
+    std::string socketPath = common::cHelperSocketPath;
+
+    for(int i = 1; i + 1 < argc; ++i)
+    {
+        if(std::strcmp(argv[i], "--socket") == 0)
+        {
+            socketPath = argv[++i];
+        }
+    }
+
+    ::signal(SIGPIPE, SIG_IGN);
+
+    boost::asio::io_service ioService;
+    helperd::HelperServer server(ioService, socketPath);
+    if(!server.start())
+    {
+        return 1;
+    }
+
+    boost::asio::signal_set terminateSignals(ioService, SIGINT, SIGTERM);
+    terminateSignals.async_wait([&](const boost::system::error_code&, int signal) {
+        OPENAUTO_LOG(info) << "[helperd] Signal " << signal << " received, exiting.";
+        server.stop();
+        ioService.stop();
+    });
+
+    ioService.run();
+    return 0;
+}
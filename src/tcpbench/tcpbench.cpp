@@ -0,0 +1,291 @@
+/*
+*  This file is part of openauto project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  openauto is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  openauto is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with openauto. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <f1x/openauto/Common/Log.hpp>
+#include <f1x/openauto/Common/TCPTuning.hpp>
+
+namespace common = f1x::openauto::common;
+
+typedef std::chrono::steady_clock Clock;
+
+struct Profile
+{
+    std::string name;
+    bool tuned;
+    common::TCPTuning tuning;
+};
+
+void printUsage(const char* name)
+{
+    std::cerr << "Usage: " << name << " [options]" << std::endl
+              << "  --megabytes <n>   bytes streamed per throughput run (default 256)" << std::endl
+              << "  --chunk <bytes>   write size of the throughput stream (default 65536)" << std::endl
+              << "  --messages <n>    round trips per latency run (default 200)" << std::endl
+              << "  --size <bytes>    small message size (default 64)" << std::endl;
+}
+
+bool writeAll(int fd, const uint8_t* data, size_t size)
+{
+    while(size > 0)
+    {
+        const auto written = ::write(fd, data, size);
+        if(written <= 0)
+        {
+            return false;
+        }
+
+        data += written;
+        size -= written;
+    }
+
+    return true;
+}
+
+bool readAll(int fd, uint8_t* data, size_t size)
+{
+    while(size > 0)
+    {
+        const auto received = ::read(fd, data, size);
+        if(received <= 0)
+        {
+            return false;
+        }
+
+        data += received;
+        size -= received;
+    }
+
+    return true;
+}
+
+void logFailures(const Profile& profile, const std::vector<std::string>& failures)
+{
+    for(const auto& failure : failures)
+    {
+        OPENAUTO_LOG(warning) << "[tcpbench] " << profile.name << ": failed to set " << failure;
+    }
+}
+
+bool connectPair(const Profile& profile, int& client, int& server)
+{
+    const int listenSocket = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    struct sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    socklen_t addressSize = sizeof(address);
+
+    if(listenSocket >= 0 && profile.tuned)
+    {
+        logFailures(profile, common::TCPTuner::applyBuffers(listenSocket, profile.tuning));
+    }
+
+    if(listenSocket < 0 || ::bind(listenSocket, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) < 0
+            || ::listen(listenSocket, 1) < 0 || ::getsockname(listenSocket, reinterpret_cast<struct sockaddr*>(&address), &addressSize) < 0)
+    {
+        OPENAUTO_LOG(error) << "[tcpbench] cannot listen on loopback, errno: " << errno;
+        return false;
+    }
+
+    client = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if(profile.tuned)
+    {
+        logFailures(profile, common::TCPTuner::applyBuffers(client, profile.tuning));
+        logFailures(profile, common::TCPTuner::apply(client, profile.tuning));
+    }
+
+    if(::connect(client, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) < 0)
+    {
+        OPENAUTO_LOG(error) << "[tcpbench] cannot connect, errno: " << errno;
+        ::close(listenSocket);
+        return false;
+    }
+
+    server = ::accept4(listenSocket, nullptr, nullptr, SOCK_CLOEXEC);
+    ::close(listenSocket);
+
+    if(profile.tuned)
+    {
+        common::TCPTuner::apply(server, profile.tuning);
+    }
+
+    return server >= 0;
+}
+
+void measureThroughput(const Profile& profile, size_t totalBytes, size_t chunkSize)
+{
+    int client = -1;
+    int server = -1;
+    if(!connectPair(profile, client, server))
+    {
+        return;
+    }
+
+    std::thread receiver([server, totalBytes]() {
+        std::vector<uint8_t> buffer(65536);
+        size_t received = 0;
+        while(received < totalBytes)
+        {
+            const auto count = ::read(server, buffer.data(), buffer.size());
+            if(count <= 0)
+            {
+                break;
+            }
+            received += count;
+        }
+    });
+
+    std::vector<uint8_t> chunk(chunkSize, 0xA5);
+    const auto start = Clock::now();
+    for(size_t sent = 0; sent < totalBytes; sent += chunkSize)
+    {
+        if(!writeAll(client, chunk.data(), std::min(chunkSize, totalBytes - sent)))
+        {
+            break;
+        }
+    }
+
+    receiver.join();
+    const auto elapsedUs = std::max<int64_t>(1, std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+
+    OPENAUTO_LOG(info) << "[tcpbench] " << profile.name << " throughput: " << (totalBytes / elapsedUs) << " MB/s"
+                       << " (" << totalBytes / (1024 * 1024) << " MiB in " << elapsedUs / 1000 << " ms, chunk " << chunkSize << " bytes)";
+
+    ::close(client);
+    ::close(server);
+}
+
+void measureLatency(const Profile& profile, size_t messages, size_t messageSize)
+{
+    int client = -1;
+    int server = -1;
+    if(!connectPair(profile, client, server))
+    {
+        return;
+    }
+
+    const size_t headerSize = std::min<size_t>(4, messageSize);
+
+    std::thread echo([server, messages, messageSize]() {
+        std::vector<uint8_t> buffer(messageSize);
+        for(size_t i = 0; i < messages; ++i)
+        {
+            if(!readAll(server, buffer.data(), buffer.size()) || !writeAll(server, buffer.data(), buffer.size()))
+            {
+                break;
+            }
+        }
+    });
+
+    std::vector<uint8_t> message(messageSize, 0x5A);
+    std::vector<int64_t> samples;
+    samples.reserve(messages);
+
+    for(size_t i = 0; i < messages; ++i)
+    {
+        const auto start = Clock::now();
+
+        // header and payload go out as separate writes, like framed control messages
+        if(!writeAll(client, message.data(), headerSize) || !writeAll(client, message.data() + headerSize, messageSize - headerSize)
+                || !readAll(client, message.data(), messageSize))
+        {
+            break;
+        }
+
+        samples.push_back(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+    }
+
+    echo.join();
+    ::close(client);
+    ::close(server);
+
+    if(samples.empty())
+    {
+        return;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    OPENAUTO_LOG(info) << "[tcpbench] " << profile.name << " latency (" << messageSize << " bytes, " << samples.size() << " round trips)"
+                       << ": p50 " << samples[samples.size() / 2] << " us"
+                       << ", p99 " << samples[samples.size() * 99 / 100] << " us"
+                       << ", max " << samples.back() << " us";
+}
+
+int main(int argc, char* argv[])
+{
+    size_t megabytes = 256;
+    size_t chunkSize = 65536;
+    size_t messages = 200;
+    size_t messageSize = 64;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        const bool hasValue = i + 1 < argc;
+
+        if(hasValue && std::strcmp(argv[i], "--megabytes") == 0)
+        {
+            megabytes = std::stoul(argv[++i]);
+        }
+        else if(hasValue && std::strcmp(argv[i], "--chunk") == 0)
+        {
+            chunkSize = std::max<size_t>(1, std::stoul(argv[++i]));
+        }
+        else if(hasValue && std::strcmp(argv[i], "--messages") == 0)
+        {
+            messages = std::stoul(argv[++i]);
+        }
+        else if(hasValue && std::strcmp(argv[i], "--size") == 0)
+        {
+            messageSize = std::max<size_t>(1, std::stoul(argv[++i]));
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    const std::vector<Profile> profiles = {
+        {"default", false, {}},
+        {"nodelay", true, {true, 0, 0, false, 0, 0, 0, 0, 0}},
+        {"tuned", true, {true, 1048576, 262144, true, 5, 2, 3, 10000, 0}},
+        {"tuned+busypoll", true, {true, 1048576, 262144, true, 5, 2, 3, 10000, 50}}
+    };
+
+    for(const auto& profile : profiles)
+    {
+        if(profile.tuned)
+        {
+            OPENAUTO_LOG(info) << "[tcpbench] profile " << profile.name << ": " << common::TCPTuner::describe(profile.tuning);
+        }
+
+        measureThroughput(profile, megabytes * 1024 * 1024, chunkSize);
+        measureLatency(profile, messages, messageSize);
+    }
+
+    return 0;
+}